@@ -10,6 +10,16 @@
 #include "DrawDebugHelpers.h"
 #include "Engine/Engine.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/Texture2D.h"
+#include "CPP_Subsystem__ViewshedExploration.h"
+#include "CPP_Subsystem__ViewshedDecalParameters.h"
+#include "CPP_Subsystem__ViewshedSignificance.h"
+#include "CPP_Struct__ViewshedResultFile.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
 
 /**
  * Constructor - Initialize default values and create components
@@ -23,56 +33,9 @@ ACPP_Actor__Viewshed::ACPP_Actor__Viewshed()
     USceneComponent *RootComp = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
     RootComponent = RootComp;
 
-    // Create Debug Instanced Static Mesh Component for visible points
-    Debug_VisiblePointsISMC = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("VisiblePointsISMC"));
-    // Attach to root so it moves with the actor
-    Debug_VisiblePointsISMC->SetupAttachment(RootComponent);
-    // Disable collision since these are just visualization
-    Debug_VisiblePointsISMC->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    // Disable shadows for better performance
-    Debug_VisiblePointsISMC->SetCastShadow(false);
-    // Set Component Mobility to Movable
-    Debug_VisiblePointsISMC->SetMobility(EComponentMobility::Movable);
-    // Set Translation to World Absolute
-    Debug_VisiblePointsISMC->SetUsingAbsoluteLocation(true);
-    // Exclude from receiving decals (so our own decal doesn't paint our markers)
-    Debug_VisiblePointsISMC->SetReceivesDecals(false);
-    // Set Rotation to World Absolute
-    Debug_VisiblePointsISMC->SetUsingAbsoluteRotation(true);
-
-    // Create Debug Instanced Static Mesh Component for hidden points
-    Debug_HiddenPointsISMC = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("HiddenPointsISMC"));
-    // Attach to root so it moves with the actor
-    Debug_HiddenPointsISMC->SetupAttachment(RootComponent);
-    // Disable collision since these are just visualization
-    Debug_HiddenPointsISMC->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-    // Disable shadows for better performance
-    Debug_HiddenPointsISMC->SetCastShadow(false);
-    // Set Component Mobility to Movable
-    Debug_HiddenPointsISMC->SetMobility(EComponentMobility::Movable);
-    // Set Translation to World Absolute
-    Debug_HiddenPointsISMC->SetUsingAbsoluteLocation(true);
-    // Exclude from receiving decals
-    Debug_HiddenPointsISMC->SetReceivesDecals(false);
-    // Set Rotation to World Absolute
-    Debug_HiddenPointsISMC->SetUsingAbsoluteRotation(true);
-
-    // Create Debug procedural mesh component, attach to root
-    Debug_ProceduralMeshComponent = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("ProceduralMeshComponent"));
-    // Attach to root so it moves with the actor
-    Debug_ProceduralMeshComponent->SetupAttachment(RootComponent);
-    // Disable shadows for better performance
-    Debug_ProceduralMeshComponent->SetCastShadow(false);
-    // Use async cooking for performance
-    Debug_ProceduralMeshComponent->bUseAsyncCooking = true;
-    // Set Component Mobility to Movable
-    Debug_ProceduralMeshComponent->SetMobility(EComponentMobility::Movable);
-    // Set Translation to World Absolute
-    Debug_ProceduralMeshComponent->SetUsingAbsoluteLocation(true);
-    // Exclude from receiving decals
-    Debug_ProceduralMeshComponent->SetReceivesDecals(false);
-
-    // Create the hidden visualization decal component
+    // Point, debug mesh and blanket components are created on demand by SyncVisualizationComponents
+    // Create the hidden visualization decal component; always created so the default subobject layout never depends on
+    // the process, while headless and analysis-only observers skip its registration and updates
     HiddenVisualizationDecalComponent = CreateDefaultSubobject<UDecalComponent>(TEXT("HiddenVisualizationDecal"));
     HiddenVisualizationDecalComponent->SetupAttachment(RootComponent);
     HiddenVisualizationDecalComponent->SetUsingAbsoluteLocation(true);
@@ -84,23 +47,6 @@ ACPP_Actor__Viewshed::ACPP_Actor__Viewshed()
     HiddenVisualizationDecalComponent->SortOrder = 100;
     // Reasonable default size; will be overridden each tick from FOV/MaxDistance
     HiddenVisualizationDecalComponent->DecalSize = FVector(1000.f, 500.f, 500.f);
-    // Set Rotation to World Absolute
-    Debug_ProceduralMeshComponent->SetUsingAbsoluteRotation(true);
-
-    // Create Debug procedural mesh component, attach to root
-    VisibleVisualization_ProceduralMeshComponent = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("VisibleVisualization_ProceduralMeshComponent"));
-    // Attach to root so it moves with the actor
-    VisibleVisualization_ProceduralMeshComponent->SetupAttachment(RootComponent);
-    // Disable shadows for better performance
-    VisibleVisualization_ProceduralMeshComponent->SetCastShadow(false);
-    // Use async cooking for performance
-    VisibleVisualization_ProceduralMeshComponent->bUseAsyncCooking = true;
-    // Set Component Mobility to Movable
-    VisibleVisualization_ProceduralMeshComponent->SetMobility(EComponentMobility::Movable);
-    // Set Translation to World Absolute
-    VisibleVisualization_ProceduralMeshComponent->SetUsingAbsoluteLocation(true);
-    // Exclude from receiving decals
-    VisibleVisualization_ProceduralMeshComponent->SetReceivesDecals(false);
 
     // Initialize default property values
     // ViewDirection = FVector::ForwardVector; // Point forward along X-axis
@@ -138,52 +84,196 @@ void ACPP_Actor__Viewshed::BeginPlay()
     // Call parent implementation
     Super::BeginPlay();
 
-    // If no mesh is assigned, try to load default sphere mesh
-    if (!Debug_VisiblePointMesh)
+    // Initialize decal MID if a decal base material is provided (the point mesh is loaded once points are shown)
+    if (!IsAnalysisOnly() && HiddenVisualizationDecalComponent && HiddenVisualizationDecalMaterial)
     {
-        // Load the default engine sphere mesh for visualization
-        Debug_VisiblePointMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+        HiddenVisualizationDecalMID = UMaterialInstanceDynamic::Create(HiddenVisualizationDecalMaterial, this);
+        HiddenVisualizationDecalComponent->SetDecalMaterial(HiddenVisualizationDecalMID);
     }
 
-    // Apply the mesh to both ISMC components
-    if (Debug_VisiblePointMesh)
+    // Static observers can start from a precomputed result file instead of tracing
+    bool bLoadedPrecomputedResults = false;
+    if (!PrecomputedResultsFile.FilePath.IsEmpty())
     {
-        // Set the mesh for visible points
-        Debug_VisiblePointsISMC->SetStaticMesh(Debug_VisiblePointMesh);
-        // Set the mesh for hidden points (same mesh, different material)
-        Debug_HiddenPointsISMC->SetStaticMesh(Debug_VisiblePointMesh);
+        FString ResultsPath = PrecomputedResultsFile.FilePath;
+        if (FPaths::IsRelative(ResultsPath))
+        {
+            ResultsPath = FPaths::Combine(FPaths::ProjectDir(), ResultsPath);
+        }
+        bLoadedPrecomputedResults = LoadAnalysisFromFile(ResultsPath);
     }
 
-    // Apply materials if they are assigned
-    if (VisibleMaterial)
+    // Start initial analysis if auto-update is enabled
+    if (bLoadedPrecomputedResults)
+    {
+        // Results are already final; the next auto-update happens after a full interval
+        LastUpdateTime = GetWorld()->GetTimeSeconds();
+    }
+    else if (bAutoUpdate)
     {
-        // Set material for visible points component
-        Debug_VisiblePointsISMC->SetMaterial(0, VisibleMaterial);
+        // Begin the first analysis cycle
+        StartAnalysis();
+        // Record the current time as last update time
+        LastUpdateTime = GetWorld()->GetTimeSeconds();
     }
 
-    if (HiddenMaterial)
+    // Hand update rate and tick control to the significance subsystem
+    if (bUseSignificance)
     {
-        // Set material for hidden points component
-        Debug_HiddenPointsISMC->SetMaterial(0, HiddenMaterial);
+        if (UCPP_Subsystem__ViewshedSignificance *Significance = GetWorld()->GetSubsystem<UCPP_Subsystem__ViewshedSignificance>())
+        {
+            Significance->RegisterObserver(this);
+        }
+        // Moving is one of the events that re-rates the observer
+        if (RootComponent)
+        {
+            RootComponent->TransformUpdated.AddUObject(this, &ACPP_Actor__Viewshed::OnSignificanceTransformUpdated);
+        }
     }
+}
 
-    // Initialize decal MID if a decal base material is provided
-    if (HiddenVisualizationDecalComponent && HiddenVisualizationDecalMaterial)
+/**
+ * Called when the actor leaves play
+ * Gives the shared decal parameter row back and leaves significance evaluation
+ */
+void ACPP_Actor__Viewshed::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ReleaseSharedDecalSlot();
+    if (RootComponent)
     {
-        HiddenVisualizationDecalMID = UMaterialInstanceDynamic::Create(HiddenVisualizationDecalMaterial, this);
-        HiddenVisualizationDecalComponent->SetDecalMaterial(HiddenVisualizationDecalMID);
+        RootComponent->TransformUpdated.RemoveAll(this);
     }
+    if (UCPP_Subsystem__ViewshedSignificance *Significance = GetWorld() ? GetWorld()->GetSubsystem<UCPP_Subsystem__ViewshedSignificance>() : nullptr)
+    {
+        Significance->UnregisterObserver(this);
+    }
+    Super::EndPlay(EndPlayReason);
+}
 
-    // Start initial analysis if auto-update is enabled
-    if (bAutoUpdate)
+/**
+ * Keep the decal out of the scene for analysis-only observers
+ * A decal loaded from a level saved with visualization is still created, so registration is what gets skipped
+ */
+void ACPP_Actor__Viewshed::PreRegisterAllComponents()
+{
+    Super::PreRegisterAllComponents();
+
+    if (IsAnalysisOnly() && HiddenVisualizationDecalComponent)
     {
-        // Begin the first analysis cycle
-        StartAnalysis();
-        // Record the current time as last update time
-        LastUpdateTime = GetWorld()->GetTimeSeconds();
+        HiddenVisualizationDecalComponent->bAutoRegister = false;
+    }
+}
+
+/**
+ * Whether visualization is skipped for this observer
+ */
+bool ACPP_Actor__Viewshed::IsAnalysisOnly() const
+{
+    return bAnalysisOnly || IsHeadlessProcess();
+}
+
+/**
+ * Apply an evaluated significance
+ */
+void ACPP_Actor__Viewshed::SetSignificance(float InSignificance)
+{
+    CurrentSignificance = FMath::Clamp(InSignificance, 0.0f, 1.0f);
+
+    // Upload a blanket that finished since the last tick before the tick may stop
+    ApplyBlanketBuild();
+
+    // Sleep only between analyses and blanket builds so neither is left half done; Tick sleeps once they finish
+    const bool bTick = !ShouldSleep();
+    if (IsActorTickEnabled() != bTick)
+    {
+        SetActorTickEnabled(bTick);
+    }
+
+    // Visualization detail: the decal is the only per-frame visual that stays on screen while not updated
+    if (HiddenVisualizationDecalComponent && !IsAnalysisOnly())
+    {
+        HiddenVisualizationDecalComponent->SetVisibility(IsVisualizationSignificant());
+    }
+}
+
+/**
+ * Whether the observer is insignificant and has no analysis or blanket build left to finish
+ */
+bool ACPP_Actor__Viewshed::ShouldSleep() const
+{
+    return bUseSignificance && CurrentSignificance <= Significance_SleepThreshold && !bAnalysisInProgress && !BlanketBuildFuture.IsValid();
+}
+
+/**
+ * Resume ticking at full significance until the next evaluation
+ */
+void ACPP_Actor__Viewshed::WakeObserver()
+{
+    SetSignificance(1.0f);
+    NotifySignificanceChanged();
+}
+
+/**
+ * Change the Gameplay Relevance and queue a re-rating
+ */
+void ACPP_Actor__Viewshed::SetGameplayRelevance(float InRelevance)
+{
+    Significance_GameplayRelevance = FMath::Max(0.0f, InRelevance);
+    NotifySignificanceChanged();
+}
+
+/**
+ * Ask the significance subsystem to re-rate this observer
+ */
+void ACPP_Actor__Viewshed::NotifySignificanceChanged()
+{
+    UWorld *World = GetWorld();
+    if (UCPP_Subsystem__ViewshedSignificance *Significance = World ? World->GetSubsystem<UCPP_Subsystem__ViewshedSignificance>() : nullptr)
+    {
+        Significance->NotifyObserverChanged(this);
     }
 }
 
+/**
+ * Root component moved
+ */
+void ACPP_Actor__Viewshed::OnSignificanceTransformUpdated(USceneComponent *UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+    NotifySignificanceChanged();
+}
+
+/**
+ * Update interval after significance scaling
+ */
+float ACPP_Actor__Viewshed::GetEffectiveUpdateInterval() const
+{
+    return UpdateInterval * FMath::Lerp(FMath::Max(1.0f, Significance_MaxIntervalScale), 1.0f, CurrentSignificance);
+}
+
+/**
+ * Traces per frame after significance scaling
+ */
+int32 ACPP_Actor__Viewshed::GetEffectiveTraceBudget() const
+{
+    return FMath::Max(1, FMath::RoundToInt32(MaxTracesPerFrame * FMath::Lerp(Significance_MinTraceBudgetScale, 1.0f, CurrentSignificance)));
+}
+
+/**
+ * Whether visualization is drawn at the current significance
+ */
+bool ACPP_Actor__Viewshed::IsVisualizationSignificant() const
+{
+    return CurrentSignificance >= Significance_VisualizationThreshold;
+}
+
+/**
+ * Whether this process can never present visualization
+ */
+bool ACPP_Actor__Viewshed::IsHeadlessProcess()
+{
+    return IsRunningDedicatedServer() || !FApp::CanEverRender();
+}
+
 /**
  * Called every frame to update analysis progress and handle auto-updates
  */
@@ -192,8 +282,11 @@ void ACPP_Actor__Viewshed::Tick(float DeltaTime)
     // Call parent implementation first
     Super::Tick(DeltaTime);
 
+    // Visualization is skipped entirely for analysis-only observers and below the significance threshold
+    const bool bVisualize = !IsAnalysisOnly() && IsVisualizationSignificant();
+
     // Draw debug pyramid bounds if enabled
-    if (bDebug_ShowPyramidBounds)
+    if (bVisualize && bDebug_ShowPyramidBounds)
     {
         DrawDebugPyramid();
     }
@@ -210,38 +303,79 @@ void ACPP_Actor__Viewshed::Tick(float DeltaTime)
         LastUpdateTime = GetWorld()->GetTimeSeconds();
     }
 
+    // Streamed analyses trace the next batch straight into the current chunk
+    if (bAnalysisInProgress && StreamWriter.IsValid())
+    {
+        if (!ProcessStreamingRays(GetEffectiveTraceBudget(), false))
+        {
+            StopAnalysis();
+        }
+        else if (StreamNextRay >= StreamWriter->GetHeader().RayCount)
+        {
+            FinishStreamingAnalysis();
+        }
+    }
     // Process ongoing analysis if in progress
-    if (bAnalysisInProgress)
+    else if (bAnalysisInProgress)
     {
         // Track how many traces we've processed this frame
         int32 TracesProcessedThisFrame = 0;
+        const int32 TraceBudget = GetEffectiveTraceBudget();
+        // Remember where this frame's batch starts so only new results are rasterized
+        const int32 BatchStartIndex = CurrentTraceIndex;
 
         // Process traces up to the frame limit or until complete
-        while (CurrentTraceIndex < TracePointQueue.Num() &&
-               TracesProcessedThisFrame < MaxTracesPerFrame)
+        while (CurrentTraceIndex < RayStore.Num() &&
+               TracesProcessedThisFrame < TraceBudget)
         {
             // Process the next trace in the queue
-            ProcessSingleTrace(CurrentTraceIndex);
+            if (ResultMode == E__ViewShedResultMode::HorizonMap)
+            {
+                ProcessHorizonTrace(CurrentTraceIndex);
+            }
+            else
+            {
+                ProcessSingleTrace(CurrentTraceIndex);
+            }
             // Move to next trace
             CurrentTraceIndex++;
             // Increment frame counter
             TracesProcessedThisFrame++;
         }
 
+        // One debug line submission per frame batch
+        DrawTraceDebugLines(BatchStartIndex, CurrentTraceIndex);
+
+        // Splat this frame's results into the world raster (horizon results are rasterized once on completion)
+        if (bEnableWorldRaster && ResultMode == E__ViewShedResultMode::BandPoints)
+        {
+            WorldRaster.SplatRange(AnalysisResults, BatchStartIndex, CurrentTraceIndex, bWorldRaster_SurfaceHitsOnly);
+        }
+
         // Check if analysis is complete
-        if (CurrentTraceIndex >= TracePointQueue.Num())
+        if (CurrentTraceIndex >= RayStore.Num())
         {
             // Mark analysis as complete
             bAnalysisInProgress = false;
-            // Update visualization with new results
-            UpdateVisualization();
-            // Broadcast completion event to any listeners
-            OnAnalysisComplete.Broadcast(AnalysisResults);
+            // Build derived structures, visualize and notify listeners
+            FinalizeAnalysis();
         }
     }
 
     // Keep decal aligned with the viewshed origin and frustum parameters every frame
-    UpdateHiddenVisualizationDecal();
+    if (bVisualize)
+    {
+        UpdateHiddenVisualizationDecal();
+    }
+
+    // Collect a finished blanket build even below the visualization threshold, so it is never left pending
+    ApplyBlanketBuild();
+
+    // An analysis or blanket build that kept an insignificant observer awake has now finished
+    if (ShouldSleep())
+    {
+        SetActorTickEnabled(false);
+    }
 }
 
 /**
@@ -256,6 +390,19 @@ void ACPP_Actor__Viewshed::StartAnalysis()
         return;
     }
 
+    // Analysis advances in Tick, so a sleeping observer wakes for it
+    if (!IsActorTickEnabled())
+    {
+        SetActorTickEnabled(true);
+    }
+
+    // Streamed analyses never build the trace queue; rays are generated batch by batch
+    if (ResultMode == E__ViewShedResultMode::Streamed)
+    {
+        bAnalysisInProgress = BeginStreamingAnalysis();
+        return;
+    }
+
     // Clear any existing results
     ClearResults();
 
@@ -263,36 +410,123 @@ void ACPP_Actor__Viewshed::StartAnalysis()
     GenerateTraceEndpoints();
 
     // If no traces were produced (e.g. degenerate sampling parameters) there is nothing to process
-    if (TracePointQueue.IsEmpty())
+    if (RayStore.IsEmpty())
     {
         return;
     }
 
-    // Initialize the analysis results array to match the number of traces we will execute
-    AnalysisResults.SetNum(TracePointQueue.Num());
+    // Seed one result per trace, or an empty horizon map
+    InitializeResultStorage();
 
-    // Initialize each result with default values
-    for (int32 i = 0; i < AnalysisResults.Num(); ++i)
+    // Centre the raster on the observer; results are splatted into it as traces complete
+    InitializeWorldRaster();
+
+    // Mark analysis as in progress and reset trace index (Horizon Map mode only runs the far band)
+    bAnalysisInProgress = true;
+    CurrentTraceIndex = ResultMode == E__ViewShedResultMode::HorizonMap ? GetHorizonTraceStartIndex() : 0;
+}
+
+/**
+ * Run a complete analysis in one call, tracing every ray in parallel
+ */
+void ACPP_Actor__Viewshed::RunAnalysisImmediate()
+{
+    // Streamed: trace one chunk in parallel, append it, move on; only one chunk of results is ever resident
+    if (ResultMode == E__ViewShedResultMode::Streamed)
+    {
+        if (bAnalysisInProgress || !BeginStreamingAnalysis())
+        {
+            return;
+        }
+        while (StreamNextRay < StreamWriter->GetHeader().RayCount)
+        {
+            if (!ProcessStreamingRays(StreamWriter->GetHeader().RaysPerChunk, true))
+            {
+                StopAnalysis();
+                return;
+            }
+        }
+        FinishStreamingAnalysis();
+        return;
+    }
+
+    if (!TraceAllImmediate())
     {
-        const FS__ViewShedTracePoint &TracePoint = TracePointQueue[i];
+        return;
+    }
 
-        // Cache the endpoint so visualisation updates have the final sample position available
-        AnalysisResults[i].WorldPosition = TracePoint.TraceEnd;
-        // Calculate distance from observer to this point
-        AnalysisResults[i].Distance = FVector::Dist(TracePoint.TraceStart, TracePoint.TraceEnd);
-        // Initialize as not visible (will be updated during trace)
-        AnalysisResults[i].bIsVisible = false;
-        // Initialize hit location to endpoint (will be updated if hit occurs)
-        AnalysisResults[i].HitLocation = TracePoint.TraceEnd;
-        // Initialize hit normal from ground support if available (updated during trace if occluded)
-        AnalysisResults[i].HitNormal = TracePoint.GroundNormal;
-        // Initialize hit actor as null
-        AnalysisResults[i].HitActor = nullptr;
+    // Rasterize everything at once instead of batch by batch (FinalizeAnalysis does this for horizon results)
+    InitializeWorldRaster();
+    if (bEnableWorldRaster && ResultMode == E__ViewShedResultMode::BandPoints)
+    {
+        WorldRaster.SplatAllParallel(AnalysisResults, bWorldRaster_SurfaceHitsOnly);
     }
+    FinalizeAnalysis();
+}
 
-    // Mark analysis as in progress and reset trace index
-    bAnalysisInProgress = true;
-    CurrentTraceIndex = 0;
+/**
+ * Regenerate the rays and trace all of them in parallel
+ */
+bool ACPP_Actor__Viewshed::TraceAllImmediate()
+{
+    if (bAnalysisInProgress)
+    {
+        return false;
+    }
+
+    ClearResults();
+    GenerateTraceEndpoints();
+    if (RayStore.IsEmpty())
+    {
+        return false;
+    }
+    InitializeResultStorage();
+
+    // Every trace writes only its own result; debug lines are drawn from the results afterwards
+    if (ResultMode == E__ViewShedResultMode::HorizonMap)
+    {
+        const int32 HorizonStartIndex = GetHorizonTraceStartIndex();
+        ParallelFor(RayStore.Num() - HorizonStartIndex, [this, HorizonStartIndex](int32 i)
+                    { ProcessHorizonTrace(HorizonStartIndex + i); });
+    }
+    else
+    {
+        ParallelFor(RayStore.Num(), [this](int32 TraceIndex)
+                    { ProcessSingleTrace(TraceIndex); });
+    }
+    DrawTraceDebugLines(0, RayStore.Num());
+
+    CurrentTraceIndex = RayStore.Num();
+    return true;
+}
+
+/**
+ * Angular lattice of the current ray layout
+ */
+FS__ViewShedHorizonLattice ACPP_Actor__Viewshed::GetHorizonLattice() const
+{
+    FS__ViewShedHorizonLattice Lattice;
+    Lattice.HorizontalSampleCount = CachedHorizontalSampleCount;
+    Lattice.VerticalSampleCount = CachedVerticalSampleCount;
+    // Same clamped half angles GenerateTraceEndpoints spreads the samples across
+    Lattice.HalfHorizontalFOV = FMath::DegreesToRadians(FMath::Max(1e-3f, HorizontalFOV * 0.5f));
+    Lattice.HalfVerticalFOV = FMath::DegreesToRadians(FMath::Max(1e-3f, VerticalFOV * 0.5f));
+    Lattice.MaxDistance = MaxDistance;
+    Lattice.Pattern = SamplingPatternData;
+    return Lattice;
+}
+
+/**
+ * Collapse the current results into one first-occluder distance per lattice direction
+ */
+void ACPP_Actor__Viewshed::BuildHorizonMap(FS__ViewShedHorizonMap &OutHorizon) const
+{
+    if (ResultMode == E__ViewShedResultMode::HorizonMap)
+    {
+        OutHorizon = HorizonMap;
+        return;
+    }
+    OutHorizon.Build(GetHorizonLattice(), AnalysisResults, RayStore);
 }
 
 /**
@@ -304,6 +538,9 @@ void ACPP_Actor__Viewshed::StopAnalysis()
     bAnalysisInProgress = false;
     // Reset trace index for next analysis
     CurrentTraceIndex = 0;
+    // Abandon an unfinished stream file (it has no index, so readers reject it)
+    StreamWriter.Reset();
+    StreamNextRay = 0;
 }
 
 /**
@@ -313,9 +550,15 @@ void ACPP_Actor__Viewshed::ClearResults()
 {
     // Clear the results array
     AnalysisResults.Empty();
-    // Clear hierarchical trace layout and flattened queue
-    TraceSections.Empty();
-    TracePointQueue.Empty();
+    HorizonMap.Reset();
+    StreamWriter.Reset();
+    StreamNextRay = 0;
+    // Clear the spatial index built over the previous results
+    SpatialIndex.Reset();
+    ResultColumns.Reset();
+    // Forget the rays of the previous analysis
+    RayStore.Reset();
+    SamplingPatternData.Reset();
     CachedHorizontalSampleCount = 0;
     CachedDistanceBandCount = 0;
     CachedVerticalSampleCount = 0;
@@ -337,48 +580,169 @@ void ACPP_Actor__Viewshed::ClearResults()
 }
 
 /**
- * Generate all trace endpoints in a pyramid sampling pattern
- * Creates a grid of points within the FOV bounds at multiple distances
+ * Size AnalysisResults to the trace queue and seed each result from its endpoint
  */
-void ACPP_Actor__Viewshed::GenerateTraceEndpoints()
+void ACPP_Actor__Viewshed::InitializeResultsFromTraceQueue()
 {
-    // Reset previously generated sections and flattened queue
-    TraceSections.Empty();
-    TracePointQueue.Empty();
-    CachedHorizontalSampleCount = 0;
-    CachedDistanceBandCount = 0;
-    CachedVerticalSampleCount = 0;
+    // Initialize the analysis results array to match the number of traces we will execute
+    AnalysisResults.SetNum(RayStore.Num());
 
-    UWorld *World = GetWorld();
-    if (!World)
+    // Initialize each result with default values
+    for (int32 i = 0; i < AnalysisResults.Num(); ++i)
+    {
+        const FVector TraceEnd = RayStore.GetTraceEnd(i);
+
+        // Cache the endpoint so visualisation updates have the final sample position available
+        AnalysisResults[i].WorldPosition = TraceEnd;
+        // Calculate distance from observer to this point
+        AnalysisResults[i].Distance = FVector::Dist(RayStore.Origin, TraceEnd);
+        // Initialize as not visible (will be updated during trace)
+        AnalysisResults[i].bIsVisible = false;
+        // Initialize hit location to endpoint (will be updated if hit occurs)
+        AnalysisResults[i].HitLocation = TraceEnd;
+        // No ground probe, so no normal until a trace hits something
+        AnalysisResults[i].HitNormal = FVector::ZeroVector;
+        // Initialize hit actor as null
+        AnalysisResults[i].HitActor = nullptr;
+    }
+}
+
+/**
+ * Prepare result storage for the current trace queue according to ResultMode
+ */
+void ACPP_Actor__Viewshed::InitializeResultStorage()
+{
+    if (ResultMode == E__ViewShedResultMode::HorizonMap)
     {
+        AnalysisResults.Empty();
+        HorizonMap.Initialize(GetHorizonLattice(), bHorizonMap_HalfPrecision, bHorizonMap_StoreNormals);
         return;
     }
 
-    const FVector ObserverLoc = GetObserverLocation();
-    const FVector UpVector = GetActorUpVector().GetSafeNormal();
-    const FVector ForwardVector = GetActorForwardVector().GetSafeNormal();
-    FVector RightVector = GetActorRightVector().GetSafeNormal();
-    // Ensure basis is orthonormal
-    RightVector = FVector::CrossProduct(UpVector, ForwardVector).GetSafeNormal();
-    const FVector TrueForward = FVector::CrossProduct(RightVector, UpVector).GetSafeNormal();
-
-    // Convert half-angle FOV values now to avoid repeated work inside the loops
-    const float HalfHorizontalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, HorizontalFOV * 0.5f));
-    const float HalfVerticalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, VerticalFOV * 0.5f));
+    HorizonMap.Reset();
+    InitializeResultsFromTraceQueue();
+}
 
-    // Derive section counts from user-provided ratios
-    const float SafeHRatio = FMath::Clamp(Horizontal_Sample_Section_Ratio, 0.01f, 1.0f);
-    const float SafeVRatio = FMath::Clamp(Vertical_Sample_Section_Ratio, 0.01f, 1.0f);
-    const int32 HorizontalSectionCount = FMath::Max(1, FMath::CeilToInt(1.0f / SafeHRatio));
-    const int32 VerticalSectionCount = FMath::Max(1, FMath::CeilToInt(1.0f / SafeVRatio));
+/**
+ * Index of the first far-band trace
+ */
+int32 ACPP_Actor__Viewshed::GetHorizonTraceStartIndex() const
+{
+    // Bands are queued nearest first, each holding one trace per lattice direction
+    return RayStore.GetBandRange(RayStore.BandCount - 1).First;
+}
 
-    const int32 EffectiveDistanceSteps = FMath::Max(1, DistanceSteps);
+/**
+ * Derive every band result from the horizon map
+ */
+void ACPP_Actor__Viewshed::DeriveResultsFromHorizonMap(TArray<FS__ViewShedPoint> &OutResults) const
+{
+    FS__ViewShedRayRange Range;
+    Range.Num = RayStore.Num();
+    DeriveResultsFromHorizonMap(Range, OutResults);
+}
 
-    // Determine a consistent horizontal sample count based on the far-plane arc length and desired spacing
-    const float MaxArcWidth = 2.0f * MaxDistance * FMath::Tan(HalfHorizontalRad);
-    const float DesiredSpacing = FMath::Max(1.0f, Maximum_Distance_Between_Samples);
-    int32 HorizontalSampleCount = FMath::CeilToInt(MaxArcWidth / DesiredSpacing) + 1;
+/**
+ * Derive the band results of a range of rays from the horizon map
+ */
+void ACPP_Actor__Viewshed::DeriveResultsFromHorizonMap(const FS__ViewShedRayRange &Range, TArray<FS__ViewShedPoint> &OutResults) const
+{
+    OutResults.SetNum(Range.Num);
+    ParallelFor(Range.Num, [&](int32 i)
+                {
+                    FS__ViewShedTracePoint TracePoint;
+                    RayStore.GetTracePoint(Range.First + i, TracePoint);
+                    HorizonMap.DeriveBandPoint(TracePoint, OutResults[i]); });
+}
+
+/**
+ * Visit every result, stored or derived
+ */
+void ACPP_Actor__Viewshed::ForEachResultBatch(TFunctionRef<void(TConstArrayView<FS__ViewShedPoint>)> Visit) const
+{
+    if (!AnalysisResults.IsEmpty() || !HorizonMap.IsBuilt())
+    {
+        Visit(AnalysisResults);
+        return;
+    }
+
+    // Horizon results are derived one distance band at a time, so only one band of points is ever expanded
+    TArray<FS__ViewShedPoint> BandResults;
+    for (int32 BandIndex = 0; BandIndex < RayStore.BandCount; ++BandIndex)
+    {
+        DeriveResultsFromHorizonMap(RayStore.GetBandRange(BandIndex), BandResults);
+        Visit(BandResults);
+    }
+}
+
+/**
+ * Build derived structures, update visualization and broadcast once every result is final
+ */
+void ACPP_Actor__Viewshed::FinalizeAnalysis()
+{
+    // Horizon results are splatted band by band; the index and columns below are built straight from the horizon map
+    const bool bHorizonResults = ResultMode == E__ViewShedResultMode::HorizonMap && AnalysisResults.IsEmpty() && HorizonMap.IsBuilt();
+    if (bHorizonResults && bEnableWorldRaster)
+    {
+        ForEachResultBatch([this](TConstArrayView<FS__ViewShedPoint> Batch)
+                           { WorldRaster.SplatAllParallel(Batch, bWorldRaster_SurfaceHitsOnly); });
+    }
+
+    // Index the final hit locations for nearest/radius queries
+    RebuildSpatialIndex();
+    // Pack visibility/distance/band columns for the filter kernels
+    RebuildResultColumns();
+    // Upload the finished raster for minimap consumers
+    UpdateWorldRasterTexture();
+    // Upload per-direction occluder distances for the occlusion-aware decal
+    UpdateHorizonOccluderTexture();
+    // Summarize the raster for O(1) region coverage queries
+    RebuildVisibilityPyramid();
+    // Merge visible samples into the persistent exploration map
+    if (bContributeToExploration)
+    {
+        if (UCPP_Subsystem__ViewshedExploration *Exploration = GetWorld()->GetSubsystem<UCPP_Subsystem__ViewshedExploration>())
+        {
+            Exploration->AccumulateObserver(this);
+        }
+    }
+    // Every band point is expanded only for the visualization and completion listeners, and only while they run
+    if (bHorizonResults && (!IsAnalysisOnly() || OnAnalysisComplete.IsBound()))
+    {
+        DeriveResultsFromHorizonMap(AnalysisResults);
+    }
+    // Update visualization with new results
+    UpdateVisualization();
+    // Broadcast completion event to any listeners
+    OnAnalysisComplete.Broadcast(AnalysisResults);
+
+    // Only the horizon map stays resident
+    if (bHorizonResults)
+    {
+        AnalysisResults.Empty();
+    }
+}
+
+/**
+ * Section, sample and band counts of the current sampling configuration
+ */
+void ACPP_Actor__Viewshed::ComputeSamplingLayout(int32 &OutHorizontalSectionCount, int32 &OutVerticalSectionCount,
+                                                 int32 &OutHorizontalSampleCount, int32 &OutVerticalSampleCount, int32 &OutDistanceBandCount) const
+{
+    // Convert half-angle FOV values to radians
+    const float HalfHorizontalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, HorizontalFOV * 0.5f));
+    const float HalfVerticalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, VerticalFOV * 0.5f));
+
+    // Derive section counts from user-provided ratios
+    const float SafeHRatio = FMath::Clamp(Horizontal_Sample_Section_Ratio, 0.01f, 1.0f);
+    const float SafeVRatio = FMath::Clamp(Vertical_Sample_Section_Ratio, 0.01f, 1.0f);
+    const int32 HorizontalSectionCount = FMath::Max(1, FMath::CeilToInt(1.0f / SafeHRatio));
+    const int32 VerticalSectionCount = FMath::Max(1, FMath::CeilToInt(1.0f / SafeVRatio));
+
+    // Determine a consistent horizontal sample count based on the far-plane arc length and desired spacing
+    const float MaxArcWidth = 2.0f * MaxDistance * FMath::Tan(HalfHorizontalRad);
+    const float DesiredSpacing = FMath::Max(1.0f, Maximum_Distance_Between_Samples);
+    int32 HorizontalSampleCount = FMath::CeilToInt(MaxArcWidth / DesiredSpacing) + 1;
     // Ensure at least Minimum_Samples_Per_Section per horizontal section
     HorizontalSampleCount = FMath::Max(HorizontalSampleCount, HorizontalSectionCount * FMath::Max(1, Minimum_Samples_Per_Section));
     // Round up to a multiple of sections so each section has (roughly) equal columns
@@ -386,8 +750,6 @@ void ACPP_Actor__Viewshed::GenerateTraceEndpoints()
     {
         HorizontalSampleCount += HorizontalSectionCount - (HorizontalSampleCount % HorizontalSectionCount);
     }
-    CachedHorizontalSampleCount = HorizontalSampleCount;
-    CachedDistanceBandCount = EffectiveDistanceSteps;
 
     // Determine vertical sample count similar to horizontal, based on far-plane height
     const float MaxArcHeight = 2.0f * MaxDistance * FMath::Tan(HalfVerticalRad);
@@ -399,101 +761,139 @@ void ACPP_Actor__Viewshed::GenerateTraceEndpoints()
         VerticalSampleCount += VerticalSectionCount - (VerticalSampleCount % VerticalSectionCount);
     }
 
-    // Cache counts
-    TraceSections.SetNum(EffectiveDistanceSteps);
-    CachedVerticalSampleCount = VerticalSampleCount;
-    // Reserve for all vertical rows; first rows will be the central vertical slice to keep existing mesh assumptions intact
-    TracePointQueue.Reserve(EffectiveDistanceSteps * HorizontalSampleCount * VerticalSampleCount);
-
-    // No ground probing (ground-hugging removed)
+    OutHorizontalSectionCount = HorizontalSectionCount;
+    OutVerticalSectionCount = VerticalSectionCount;
+    OutHorizontalSampleCount = HorizontalSampleCount;
+    OutVerticalSampleCount = VerticalSampleCount;
+    OutDistanceBandCount = FMath::Max(1, DistanceSteps);
+}
 
-    for (int32 DistStep = 0; DistStep < EffectiveDistanceSteps; ++DistStep)
+/**
+ * Lattice stride of every band for Per-Band Sample Density
+ * The lattice is sized for the farthest band, which always keeps every sample; a band at a fraction of that distance covers
+ * proportionally less ground per sample, so it can skip samples. Strides are powers of two so every band's samples are a subset of the next farther band's.
+ */
+void ACPP_Actor__Viewshed::ComputeBandStrides(int32 HorizontalSampleCount, int32 VerticalSampleCount, int32 DistanceBandCount, TArray<FIntPoint> &OutBandStrides) const
+{
+    OutBandStrides.Reset();
+    if (!bPerBandSampleDensity)
     {
-        const float StepFraction = float(DistStep + 1) / float(EffectiveDistanceSteps);
-        const float CurrentDistance = MaxDistance * StepFraction;
+        return;
+    }
+
+    // Ground covered between neighbouring samples per unit of distance, the same far-plane estimate ComputeSamplingLayout uses
+    const float HalfHorizontalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, HorizontalFOV * 0.5f));
+    const float HalfVerticalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, VerticalFOV * 0.5f));
+    const float HorizontalStep = HorizontalSampleCount > 1 ? 2.0f * FMath::Tan(HalfHorizontalRad) / float(HorizontalSampleCount - 1) : 0.0f;
+    const float VerticalStep = VerticalSampleCount > 1 ? 2.0f * FMath::Tan(HalfVerticalRad) / float(VerticalSampleCount - 1) : 0.0f;
+    const float DesiredSpacing = FMath::Max(1.0f, Maximum_Distance_Between_Samples);
 
-        FS__ViewShedTraceSection &DistanceSection = TraceSections[DistStep];
-        DistanceSection.HorizontalSectionCount = HorizontalSectionCount;
-        DistanceSection.VerticalSectionCount = VerticalSectionCount;
-        DistanceSection.TraceSections.SetNum(1);
+    // Largest power of two that keeps the spacing within the target, never skipping past the last sample
+    const auto ChooseStride = [DesiredSpacing](float SpacingPerSample, int32 SampleCount)
+    {
+        if (SpacingPerSample <= 0.0f || SampleCount <= 2)
+        {
+            return 1;
+        }
+        const float MaxStride = FMath::Min(DesiredSpacing / SpacingPerSample, float(SampleCount - 1));
+        return MaxStride < 2.0f ? 1 : 1 << FMath::FloorLog2(uint32(MaxStride));
+    };
+
+    // The farthest band always samples the full lattice: it is what the lattice was sized for, and Horizon Map mode
+    // traces only that band, so a stride there would leave most directions untraced
+    OutBandStrides.SetNumUninitialized(DistanceBandCount);
+    for (int32 Band = 0; Band < DistanceBandCount; ++Band)
+    {
+        if (Band == DistanceBandCount - 1)
+        {
+            OutBandStrides[Band] = FIntPoint(1, 1);
+            continue;
+        }
+        const float BandDistance = MaxDistance * (float(Band + 1) / float(DistanceBandCount));
+        OutBandStrides[Band] = FIntPoint(ChooseStride(BandDistance * HorizontalStep, HorizontalSampleCount),
+                                         ChooseStride(BandDistance * VerticalStep, VerticalSampleCount));
+    }
+}
 
-        FS__ViewShedTraceEndPoints &SectionPoints = DistanceSection.TraceSections[0];
-        SectionPoints.HorizontalSampleCount = HorizontalSampleCount;
-        SectionPoints.VerticalSampleCount = VerticalSampleCount;
-        SectionPoints.TraceEndPoints.Reset(HorizontalSampleCount * VerticalSampleCount);
+/**
+ * Generate all trace endpoints in a pyramid sampling pattern
+ * Every band shares the observer origin and the lattice directions, so only the rotated direction table is stored
+ */
+void ACPP_Actor__Viewshed::GenerateTraceEndpoints()
+{
+    // Forget the previous rays
+    RayStore.Reset();
+    SamplingPatternData.Reset();
+    CachedHorizontalSampleCount = 0;
+    CachedDistanceBandCount = 0;
+    CachedVerticalSampleCount = 0;
 
-        // Pass 1: Generate the central vertical slice first (pitch = 0) so existing visible blanket (which assumes 2D grid) stays correct.
-        const int32 CentralVerticalIndex = FMath::Clamp(VerticalSampleCount / 2, 0, FMath::Max(0, VerticalSampleCount - 1));
-        const float CentralVerticalAngle = 0.0f; // middle row (no pitch)
+    UWorld *World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
 
-        for (int32 HorizontalIndex = 0; HorizontalIndex < HorizontalSampleCount; ++HorizontalIndex)
-        {
-            const float HorizontalAlpha = (HorizontalSampleCount <= 1)
-                                              ? 0.5f
-                                              : float(HorizontalIndex) / float(HorizontalSampleCount - 1);
-            const float HorizontalAngle = FMath::Lerp(-HalfHorizontalRad, HalfHorizontalRad, HorizontalAlpha);
+    const FVector ObserverLoc = GetObserverLocation();
+    const FQuat ObserverRotation = GetObserverRotation();
+    const FVector UpVector = ObserverRotation.GetUpVector();
+    const FVector RightVector = ObserverRotation.GetRightVector();
+    const FVector TrueForward = ObserverRotation.GetForwardVector();
 
-            // Build direction using yaw (horizontal) and pitch (central vertical row)
-            const FQuat Yaw(UpVector, HorizontalAngle);
-            const FQuat Pitch(RightVector, CentralVerticalAngle);
-            const FVector Direction = (Yaw * Pitch).RotateVector(TrueForward).GetSafeNormal();
+    // Convert half-angle FOV values to radians
+    const float HalfHorizontalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, HorizontalFOV * 0.5f));
+    const float HalfVerticalRad = FMath::DegreesToRadians(FMath::Max(1e-3f, VerticalFOV * 0.5f));
 
-            const FVector PointOnFrustum = ObserverLoc + Direction * CurrentDistance;
-            FVector TargetLocation = PointOnFrustum; // visibility determined by occluder before reaching this point
-            const bool bGroundHit = true;            // treat as supported; we no longer depend on ground probing
-            const FVector GroundNormal = FVector::ZeroVector;
+    // Section and sample counts shared with the streamed ray generator
+    int32 HorizontalSectionCount = 1;
+    int32 VerticalSectionCount = 1;
+    int32 HorizontalSampleCount = 0;
+    int32 VerticalSampleCount = 0;
+    int32 EffectiveDistanceSteps = 0;
+    ComputeSamplingLayout(HorizontalSectionCount, VerticalSectionCount, HorizontalSampleCount, VerticalSampleCount, EffectiveDistanceSteps);
+    CachedDistanceBandCount = EffectiveDistanceSteps;
 
-            FS__ViewShedTracePoint TracePoint;
-            TracePoint.TraceStart = ObserverLoc;
-            TracePoint.TraceEnd = TargetLocation;
-            TracePoint.DistanceBandIndex = DistStep;
-            TracePoint.HorizontalSampleIndex = HorizontalIndex;
-            TracePoint.VerticalSampleIndex = CentralVerticalIndex;
-            TracePoint.bHasGroundSupport = bGroundHit;
-            TracePoint.GroundNormal = GroundNormal;
-
-            SectionPoints.TraceEndPoints.Add(TracePoint);
-            TracePointQueue.Add(TracePoint);
-        }
+    // Non-grid patterns spend the grid's angular spacing by solid angle; their samples form a single row
+    const E__ViewShedSamplingPattern Pattern = GetEffectiveSamplingPattern();
+    if (Pattern != E__ViewShedSamplingPattern::Grid)
+    {
+        const int32 TargetCount = FS__ViewShedSamplingPattern::ComputeTargetCount(Pattern, HorizontalSampleCount, VerticalSampleCount, HalfHorizontalRad, HalfVerticalRad);
+        SamplingPatternData = FS__ViewShedSamplingPattern::Find(Pattern, TargetCount, HalfHorizontalRad, HalfVerticalRad);
+        HorizontalSampleCount = SamplingPatternData->Num();
+        VerticalSampleCount = 1;
+    }
+    CachedHorizontalSampleCount = HorizontalSampleCount;
+    CachedVerticalSampleCount = VerticalSampleCount;
 
-        // Pass 2: Generate remaining vertical rows (bottom to top), skipping the central index already added
-        for (int32 VerticalIndex = 0; VerticalIndex < VerticalSampleCount; ++VerticalIndex)
-        {
-            if (VerticalIndex == CentralVerticalIndex)
-            {
-                continue;
-            }
-            const float VerticalAlpha = (VerticalSampleCount <= 1) ? 0.5f : float(VerticalIndex) / float(VerticalSampleCount - 1);
-            const float VerticalAngle = FMath::Lerp(-HalfVerticalRad, HalfVerticalRad, VerticalAlpha);
+    // Rays are implicit: queue index -> (band, row, column) in the store, with the central row of each band queued first
+    TArray<FIntPoint> BandStrides;
+    if (!SamplingPatternData)
+    {
+        ComputeBandStrides(HorizontalSampleCount, VerticalSampleCount, EffectiveDistanceSteps, BandStrides);
+    }
+    RayStore.Initialize(ObserverLoc, MaxDistance, EffectiveDistanceSteps, HorizontalSampleCount, VerticalSampleCount, BandStrides);
+    RayStore.Pattern = SamplingPatternData;
 
-            for (int32 HorizontalIndex = 0; HorizontalIndex < HorizontalSampleCount; ++HorizontalIndex)
-            {
-                const float HorizontalAlpha = (HorizontalSampleCount <= 1)
-                                                  ? 0.5f
-                                                  : float(HorizontalIndex) / float(HorizontalSampleCount - 1);
-                const float HorizontalAngle = FMath::Lerp(-HalfHorizontalRad, HalfHorizontalRad, HorizontalAlpha);
-
-                const FQuat Yaw(UpVector, HorizontalAngle);
-                const FQuat Pitch(RightVector, VerticalAngle);
-                const FVector Direction = (Yaw * Pitch).RotateVector(TrueForward).GetSafeNormal();
-
-                const FVector PointOnFrustum = ObserverLoc + Direction * CurrentDistance;
-                FVector TargetLocation = PointOnFrustum;
-
-                FS__ViewShedTracePoint TracePoint;
-                TracePoint.TraceStart = ObserverLoc;
-                TracePoint.TraceEnd = TargetLocation;
-                TracePoint.DistanceBandIndex = DistStep;
-                TracePoint.HorizontalSampleIndex = HorizontalIndex;
-                TracePoint.VerticalSampleIndex = VerticalIndex;
-                TracePoint.bHasGroundSupport = true;
-                TracePoint.GroundNormal = FVector::ZeroVector;
-
-                SectionPoints.TraceEndPoints.Add(TracePoint);
-                TracePointQueue.Add(TracePoint);
-            }
-        }
+    // Directions depend only on the lattice: rotate the shared local table into this frame once, every band reuses it
+    if (SamplingPatternData)
+    {
+        // Alias the pattern's own table, which lives as long as the pattern
+        DirectionTable = TSharedPtr<const FS__ViewShedDirectionTable>(SamplingPatternData, &SamplingPatternData->Directions);
+    }
+    else
+    {
+        DirectionTable = FS__ViewShedDirectionTable::Find(HorizontalSampleCount, VerticalSampleCount, HalfHorizontalRad, HalfVerticalRad);
     }
+    DirectionTable->Transform(TrueForward, RightVector, UpVector, RayStore.Directions);
+}
+
+/**
+ * Sampling pattern the next analysis will use
+ */
+E__ViewShedSamplingPattern ACPP_Actor__Viewshed::GetEffectiveSamplingPattern() const
+{
+    // The stream format describes a grid lattice
+    return ResultMode == E__ViewShedResultMode::Streamed ? E__ViewShedSamplingPattern::Grid : SamplingPattern;
 }
 
 /**
@@ -503,13 +903,118 @@ void ACPP_Actor__Viewshed::GenerateTraceEndpoints()
 void ACPP_Actor__Viewshed::ProcessSingleTrace(int32 TraceIndex)
 {
     // Validate input parameters
-    if (!IsValid(GetWorld()) || TraceIndex >= TracePointQueue.Num() || TraceIndex >= AnalysisResults.Num())
+    if (!IsValid(GetWorld()) || TraceIndex >= RayStore.Num() || TraceIndex >= AnalysisResults.Num())
+    {
+        return;
+    }
+
+    // Debug lines are drawn by the caller from the stored result (DrawTraceDebugLines)
+    FS__ViewShedTracePoint TracePoint;
+    RayStore.GetTracePoint(TraceIndex, TracePoint);
+    TraceRay(TracePoint, AnalysisResults[TraceIndex]);
+}
+
+/**
+ * Draw the debug lines of a range of traces from their stored results
+ * Band points run from the observer to the hit location; horizon traces run up to their first occluder
+ */
+void ACPP_Actor__Viewshed::DrawTraceDebugLines(int32 StartIndex, int32 EndIndex)
+{
+    if (!bDebug_ShowLines || IsAnalysisOnly() || !GetWorld())
+    {
+        return;
+    }
+
+    const bool bHorizonTraces = ResultMode == E__ViewShedResultMode::HorizonMap;
+    if (bHorizonTraces)
+    {
+        if (!HorizonMap.IsBuilt())
+        {
+            return;
+        }
+        StartIndex = FMath::Max(StartIndex, GetHorizonTraceStartIndex());
+    }
+    EndIndex = FMath::Min(EndIndex, RayStore.Num());
+
+    DebugLineBuffer.Reserve(FMath::Max(0, EndIndex - StartIndex));
+    for (int32 TraceIndex = StartIndex; TraceIndex < EndIndex; ++TraceIndex)
+    {
+        FS__ViewShedTracePoint TracePoint;
+        RayStore.GetTracePoint(TraceIndex, TracePoint);
+        if (!ShouldDrawDebugLine(TracePoint))
+        {
+            continue;
+        }
+        if (bHorizonTraces)
+        {
+            const FVector Ray = TracePoint.TraceEnd - TracePoint.TraceStart;
+            const int32 DirectionIndex = HorizonMap.Lattice.ToIndex(TracePoint.HorizontalSampleIndex, TracePoint.VerticalSampleIndex);
+            const float Reach = FMath::Min(HorizonMap.GetOccluderDistance(DirectionIndex), float(Ray.Size()));
+            AddDebugLine(TracePoint.TraceStart, TracePoint.TraceStart + Ray.GetSafeNormal() * Reach, FColor::Green);
+        }
+        else if (AnalysisResults.IsValidIndex(TraceIndex))
+        {
+            const FS__ViewShedPoint &Point = AnalysisResults[TraceIndex];
+            AddDebugLine(TracePoint.TraceStart, Point.HitLocation, Point.bIsVisible ? FColor::Green : FColor::Red);
+        }
+    }
+    FlushDebugLines();
+}
+
+/**
+ * Whether a trace passes the debug line stride and band filters
+ */
+bool ACPP_Actor__Viewshed::ShouldDrawDebugLine(const FS__ViewShedTracePoint &TracePoint) const
+{
+    if (Debug_LineBand >= 0 && TracePoint.DistanceBandIndex != Debug_LineBand)
+    {
+        return false;
+    }
+    const int32 Stride = FMath::Max(1, Debug_LineStride);
+    return (TracePoint.HorizontalSampleIndex % Stride) == 0 && (TracePoint.VerticalSampleIndex % Stride) == 0;
+}
+
+/**
+ * Draw one debug line, or queue it for FlushDebugLines when batching
+ */
+void ACPP_Actor__Viewshed::AddDebugLine(const FVector &Start, const FVector &End, const FColor &Color)
+{
+    if (bDebug_BatchLines)
+    {
+        DebugLineBuffer.Emplace(Start, End, FLinearColor(Color), bDebug_LineDuration, 2.0f, SDPG_World);
+    }
+    else
+    {
+        DrawDebugLine(GetWorld(), Start, End, Color, false, bDebug_LineDuration, 0, 2.0f);
+    }
+}
+
+/**
+ * Submit every queued debug line in one call
+ */
+void ACPP_Actor__Viewshed::FlushDebugLines()
+{
+    if (DebugLineBuffer.IsEmpty())
     {
         return;
     }
+    // Same batcher DrawDebugLine picks: lines with a lifetime persist, the rest last a single frame
+    if (UWorld *World = GetWorld())
+    {
+        if (ULineBatchComponent *LineBatcher = bDebug_LineDuration > 0.0f ? World->PersistentLineBatcher : World->LineBatcher)
+        {
+            LineBatcher->DrawLines(DebugLineBuffer);
+        }
+    }
+    DebugLineBuffer.Reset();
+}
 
+/**
+ * Line trace one ray and write its visibility, hit location, normal and actor
+ */
+void ACPP_Actor__Viewshed::TraceRay(const FS__ViewShedTracePoint &TracePoint, FS__ViewShedPoint &OutPoint) const
+{
     // Get observer and target locations
-    const FS__ViewShedTracePoint &TracePoint = TracePointQueue[TraceIndex];
     const FVector ObserverLoc = TracePoint.TraceStart;
     const FVector TargetLoc = TracePoint.TraceEnd;
 
@@ -536,18 +1041,18 @@ void ACPP_Actor__Viewshed::ProcessSingleTrace(int32 TraceIndex)
     if (!bHit)
     {
         // Nothing blocked the view all the way to the intended ground position
-        AnalysisResults[TraceIndex].bIsVisible = true;
-        AnalysisResults[TraceIndex].HitLocation = TargetLoc;
-        AnalysisResults[TraceIndex].HitNormal = TracePoint.GroundNormal;
-        AnalysisResults[TraceIndex].HitActor = nullptr;
+        OutPoint.bIsVisible = true;
+        OutPoint.HitLocation = TargetLoc;
+        OutPoint.HitNormal = TracePoint.GroundNormal;
+        OutPoint.HitActor = nullptr;
     }
     else if (TraceLength <= KINDA_SMALL_NUMBER)
     {
         // Degenerate trace (observer origin) - treat as visible anchor
-        AnalysisResults[TraceIndex].bIsVisible = true;
-        AnalysisResults[TraceIndex].HitLocation = TargetLoc;
-        AnalysisResults[TraceIndex].HitNormal = TracePoint.GroundNormal;
-        AnalysisResults[TraceIndex].HitActor = HitResult.GetActor();
+        OutPoint.bIsVisible = true;
+        OutPoint.HitLocation = TargetLoc;
+        OutPoint.HitNormal = TracePoint.GroundNormal;
+        OutPoint.HitActor = HitResult.GetActor();
     }
     else
     {
@@ -557,267 +1062,785 @@ void ACPP_Actor__Viewshed::ProcessSingleTrace(int32 TraceIndex)
         if (bReachedTarget)
         {
             // Reached near the intended endpoint, but we still have a concrete surface from the trace
-            AnalysisResults[TraceIndex].bIsVisible = true;
-            AnalysisResults[TraceIndex].HitLocation = HitResult.Location; // use the actual surface contact point
-            AnalysisResults[TraceIndex].HitNormal = TracePoint.GroundNormal.IsNearlyZero() ? HitResult.Normal : TracePoint.GroundNormal;
-            AnalysisResults[TraceIndex].HitActor = HitResult.GetActor();
+            OutPoint.bIsVisible = true;
+            OutPoint.HitLocation = HitResult.Location; // use the actual surface contact point
+            OutPoint.HitNormal = TracePoint.GroundNormal.IsNearlyZero() ? HitResult.Normal : TracePoint.GroundNormal;
+            OutPoint.HitActor = HitResult.GetActor();
         }
         else
         {
             // Something obstructed the path before reaching the target
-            AnalysisResults[TraceIndex].bIsVisible = false;
-            AnalysisResults[TraceIndex].HitLocation = HitResult.Location;
-            AnalysisResults[TraceIndex].HitNormal = HitResult.Normal;
-            AnalysisResults[TraceIndex].HitActor = HitResult.GetActor();
+            OutPoint.bIsVisible = false;
+            OutPoint.HitLocation = HitResult.Location;
+            OutPoint.HitNormal = HitResult.Normal;
+            OutPoint.HitActor = HitResult.GetActor();
         }
     }
 
     // Ground support no longer affects visibility; only occluder hits vs reaching the target matters
-
-    // Draw debug line if enabled
-    if (bDebug_ShowLines)
-    {
-        // Choose color based on visibility
-        FColor LineColor = AnalysisResults[TraceIndex].bIsVisible ? FColor::Green : FColor::Red;
-        // Draw line from observer to hit location (not necessarily endpoint)
-        DrawDebugLine(GetWorld(), ObserverLoc, AnalysisResults[TraceIndex].HitLocation,
-                      LineColor, false, bDebug_LineDuration, 0, 2.0f);
-    }
 }
 
 /**
- * Build Debug Point Mesh
+ * Trace one far-band ray and record its first occluder in the horizon map
  */
-void ACPP_Actor__Viewshed::
-    BuildDebug_PointMesh()
+void ACPP_Actor__Viewshed::ProcessHorizonTrace(int32 TraceIndex)
 {
-    const FVector ObserverLoc = GetObserverLocation();
-    // Clear existing debug points (defensive)
-    if (Debug_VisiblePointsISMC)
+    if (!IsValid(GetWorld()) || !RayStore.IsValidIndex(TraceIndex) || !HorizonMap.IsBuilt())
     {
-        Debug_VisiblePointsISMC->ClearInstances();
-    }
-    if (Debug_HiddenPointsISMC)
-    {
-        Debug_HiddenPointsISMC->ClearInstances();
+        return;
     }
 
-    // Use instanced mesh visualization as before
-    // Process each analysis result
-    for (const FS__ViewShedPoint &Point : AnalysisResults)
+    const int32 DirectionIndex = RayStore.GetDirectionIndex(TraceIndex);
+    const FVector TraceEnd = RayStore.GetTraceEnd(TraceIndex);
+
+    FCollisionQueryParams QueryParams;
+    QueryParams.AddIgnoredActor(this); // Ignore self to avoid self-collision
+    QueryParams.bTraceComplex = false; // Use simple collision for performance
+
+    // The far-band ray covers every nearer band along the same direction
+    FHitResult HitResult;
+    const bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, RayStore.Origin, TraceEnd, ECC_Visibility, QueryParams);
+    if (bHit)
     {
-        // Create transform for this instance
-        FTransform InstanceTransform;
-        // Position relative to the viewshed origin (slightly offset upward for visibility)
-        InstanceTransform.SetLocation((Point.WorldPosition - ObserverLoc) + FVector(0, 0, 10));
-        // Set uniform scale based on point scale setting
-        InstanceTransform.SetScale3D(FVector(Debug_PointScale, Debug_PointScale, Debug_PointScale));
-        // Use default rotation (no rotation needed for spheres)
-        InstanceTransform.SetRotation(FQuat::Identity);
-
-        // Add to appropriate component based on visibility and display settings
-        if (Point.bIsVisible && bDebug_ShowVisiblePoints)
-        {
-            // Add to visible points component (defensive)
-            if (Debug_VisiblePointsISMC)
-            {
-                Debug_VisiblePointsISMC->AddInstance(InstanceTransform);
-            }
-        }
-        else if (!Point.bIsVisible && bDebug_ShowHiddenPoints)
-        {
-            // Add to hidden points component (defensive)
-            if (Debug_HiddenPointsISMC)
-            {
-                Debug_HiddenPointsISMC->AddInstance(InstanceTransform);
-            }
-        }
+        HorizonMap.SetOccluder(DirectionIndex, float(FVector::Dist(RayStore.Origin, HitResult.Location)), HitResult.Normal);
     }
 }
 
 /**
- * Build Debug Procedural Merged Mesh
+ * Open the stream file and size the ray lattice for a streamed analysis
  */
-void ACPP_Actor__Viewshed::BuildDebug_ProceduralMergedMesh()
+bool ACPP_Actor__Viewshed::BeginStreamingAnalysis()
 {
-    if (!Debug_ProceduralMeshComponent)
+    ClearResults();
+
+    const FString OutputPath = GetStreamOutputPath();
+    if (OutputPath.IsEmpty() || !GetWorld())
     {
-        return;
+        return false;
     }
 
-    Debug_ProceduralMeshComponent->ClearAllMeshSections();
+    int32 HorizontalSectionCount = 1;
+    int32 VerticalSectionCount = 1;
+    ComputeSamplingLayout(HorizontalSectionCount, VerticalSectionCount, CachedHorizontalSampleCount, CachedVerticalSampleCount, CachedDistanceBandCount);
 
-    if (AnalysisResults.IsEmpty())
+    const FVector ObserverLoc = GetObserverLocation();
+    const FQuat ObserverRotation = GetObserverRotation();
+    const FS__ViewShedHorizonLattice Lattice = GetHorizonLattice();
+
+    FS__ViewShedStreamFileHeader Header;
+    Header.ConfigHash = ComputeConfigHash();
+    Header.ObserverLocation[0] = ObserverLoc.X;
+    Header.ObserverLocation[1] = ObserverLoc.Y;
+    Header.ObserverLocation[2] = ObserverLoc.Z;
+    Header.ObserverRotation[0] = ObserverRotation.X;
+    Header.ObserverRotation[1] = ObserverRotation.Y;
+    Header.ObserverRotation[2] = ObserverRotation.Z;
+    Header.ObserverRotation[3] = ObserverRotation.W;
+    Header.DistanceBandCount = CachedDistanceBandCount;
+    Header.HorizontalSampleCount = Lattice.HorizontalSampleCount;
+    Header.VerticalSampleCount = Lattice.VerticalSampleCount;
+    Header.HalfHorizontalFOV = Lattice.HalfHorizontalFOV;
+    Header.HalfVerticalFOV = Lattice.HalfVerticalFOV;
+    Header.MaxDistance = Lattice.MaxDistance;
+    Header.RaysPerChunk = FMath::Max(1, StreamRaysPerChunk);
+    Header.RayCount = int64(CachedDistanceBandCount) * Lattice.HorizontalSampleCount * Lattice.VerticalSampleCount;
+
+    StreamWriter = MakeUnique<FS__ViewShedStreamFileWriter>();
+    if (!StreamWriter->Open(OutputPath, Header, bStream_StoreNormals))
     {
-        return;
+        StreamWriter.Reset();
+        return false;
     }
-    // TODO Invisible points should have HiddenMaterial
+    StreamNextRay = 0;
+
+    // The raster has a fixed size, so it can still be filled as chunks complete
+    InitializeWorldRaster();
+    return true;
 }
 
 /**
- * Build Visible Visualization Procedural Merged Mesh
+ * Trace the next rays of a streamed analysis and append them to the stream file
  */
-void ACPP_Actor__Viewshed::BuildVisibleVisualization_ProceduralMergedMesh()
+bool ACPP_Actor__Viewshed::ProcessStreamingRays(int64 MaxRays, bool bParallel)
 {
-    if (!VisibleVisualization_ProceduralMeshComponent)
+    if (!StreamWriter.IsValid())
     {
-        return;
+        return false;
     }
 
-    VisibleVisualization_ProceduralMeshComponent->ClearAllMeshSections();
-
-    if (AnalysisResults.IsEmpty())
+    const FS__ViewShedStreamFileHeader &Header = StreamWriter->GetHeader();
+    const int64 FirstRay = StreamNextRay;
+    const int32 BatchCount = int32(FMath::Clamp<int64>(Header.RayCount - FirstRay, 0, FMath::Max<int64>(MaxRays, 1)));
+    if (BatchCount == 0)
     {
-        return;
+        return true;
     }
 
-    const FVector ObserverLoc = GetObserverLocation();
-    const float QuadHalfSize = FMath::Max(1.0f, VisibleVisualization_QuadHalfSize);
-    const FTransform ComponentTransform = VisibleVisualization_ProceduralMeshComponent->GetComponentTransform();
-    const FTransform WorldToComponent = ComponentTransform.Inverse();
-
-    TArray<FVector> Vertices;
-    TArray<int32> Triangles;
-    TArray<FVector> Normals;
-    TArray<FVector2D> UVs;
-    TArray<FLinearColor> VertexColors;
-    TArray<FProcMeshTangent> Tangents;
-    Vertices.Reserve(AnalysisResults.Num() * 8);
-    Normals.Reserve(AnalysisResults.Num() * 8);
-    UVs.Reserve(AnalysisResults.Num() * 8);
-    VertexColors.Reserve(AnalysisResults.Num() * 8);
-    Tangents.Reserve(AnalysisResults.Num() * 8);
-    Triangles.Reserve(AnalysisResults.Num() * 12);
-
-    const FLinearColor VisibleColor(0.0f, 1.0f, 0.0f, 1.0f);
-    const FLinearColor HiddenColor(1.0f, 0.0f, 0.0f, 1.0f);
-
-    const FVector2D QuadUVs[4] = {
-        FVector2D(1.0f, 1.0f),
-        FVector2D(0.0f, 1.0f),
-        FVector2D(0.0f, 0.0f),
-        FVector2D(1.0f, 0.0f)};
-
-    for (const FS__ViewShedPoint &Point : AnalysisResults)
+    // Batch results are scratch: appended, rasterized, then dropped
+    TArray<FS__ViewShedPoint> Batch;
+    Batch.SetNum(BatchCount);
+    auto TraceBatchRay = [this, &Header, &Batch, FirstRay](int32 i)
+    {
+        FS__ViewShedTracePoint TracePoint;
+        Header.GetTracePoint(FirstRay + i, TracePoint);
+        FS__ViewShedPoint &Point = Batch[i];
+        Point.WorldPosition = TracePoint.TraceEnd;
+        Point.Distance = float(FVector::Dist(TracePoint.TraceStart, TracePoint.TraceEnd));
+        TraceRay(TracePoint, Point);
+    };
+
+    if (bParallel)
+    {
+        ParallelFor(BatchCount, TraceBatchRay);
+    }
+    else
     {
-        // Only place geometry where we actually hit a surface (visible or occluded)
-        const bool bHasRealHit = (Point.HitActor != nullptr) || (!Point.HitNormal.IsNearlyZero());
-        if (!bHasRealHit)
+        for (int32 i = 0; i < BatchCount; ++i)
         {
-            continue;
+            TraceBatchRay(i);
         }
+    }
 
-        // Choose surface normal from hit; fallback points back to observer
-        FVector SurfaceNormal = Point.HitNormal;
-        if (!SurfaceNormal.Normalize())
+    // Debug lines of the whole batch in one submission
+    if (bDebug_ShowLines && !IsAnalysisOnly())
+    {
+        for (int32 i = 0; i < BatchCount; ++i)
         {
-            SurfaceNormal = (ObserverLoc - Point.HitLocation).GetSafeNormal();
-            if (!SurfaceNormal.Normalize())
+            FS__ViewShedTracePoint TracePoint;
+            Header.GetTracePoint(FirstRay + i, TracePoint);
+            if (ShouldDrawDebugLine(TracePoint))
             {
-                SurfaceNormal = FVector::UpVector;
+                AddDebugLine(TracePoint.TraceStart, Batch[i].HitLocation, Batch[i].bIsVisible ? FColor::Green : FColor::Red);
             }
         }
+        FlushDebugLines();
+    }
 
-        // Lift slightly off the surface along the surface normal
-        const FVector BaseWorldPosition = Point.HitLocation + SurfaceNormal * VisibleVisualization_SurfaceOffset;
-
-        // Build a tangent frame on the surface
-        FVector TangentX, TangentY;
-        SurfaceNormal.FindBestAxisVectors(TangentX, TangentY);
-        const FVector TangentDir = TangentX.GetSafeNormal();
-        TangentX = TangentX.GetSafeNormal() * QuadHalfSize;
-        TangentY = TangentY.GetSafeNormal() * QuadHalfSize;
-
-        FVector LocalNormal = WorldToComponent.TransformVectorNoScale(SurfaceNormal).GetSafeNormal();
-        if (LocalNormal.IsNearlyZero())
-        {
-            LocalNormal = FVector::UpVector;
-        }
+    if (!StreamWriter->Append(Batch))
+    {
+        return false;
+    }
+    StreamNextRay = FirstRay + BatchCount;
 
-        FVector LocalTangentDir = WorldToComponent.TransformVectorNoScale(TangentDir).GetSafeNormal();
-        if (LocalTangentDir.IsNearlyZero())
+    // Consumers with bounded memory are fed batch by batch instead of from the full result set
+    if (bEnableWorldRaster)
+    {
+        if (bParallel)
         {
-            LocalTangentDir = FVector::ForwardVector;
+            WorldRaster.SplatAllParallel(Batch, bWorldRaster_SurfaceHitsOnly);
         }
-
-        FVector OffsetCorners[4] = {
-            TangentX + TangentY,
-            -TangentX + TangentY,
-            -TangentX - TangentY,
-            TangentX - TangentY};
-
-        const int32 FrontBaseIndex = Vertices.Num();
-        for (int32 CornerIdx = 0; CornerIdx < 4; ++CornerIdx)
+        else
         {
-            const FVector WorldPosition = BaseWorldPosition + OffsetCorners[CornerIdx];
-            Vertices.Add(WorldToComponent.TransformPosition(WorldPosition));
-            Normals.Add(LocalNormal);
-            UVs.Add(QuadUVs[CornerIdx]);
-            VertexColors.Add(Point.bIsVisible ? VisibleColor : HiddenColor);
-            Tangents.Add(FProcMeshTangent(LocalTangentDir, false));
+            WorldRaster.SplatRange(Batch, 0, BatchCount, bWorldRaster_SurfaceHitsOnly);
         }
-
-        const int32 BackBaseIndex = Vertices.Num();
-        for (int32 CornerIdx = 0; CornerIdx < 4; ++CornerIdx)
+    }
+    if (bContributeToExploration)
+    {
+        if (UCPP_Subsystem__ViewshedExploration *Exploration = GetWorld()->GetSubsystem<UCPP_Subsystem__ViewshedExploration>())
         {
-            const FVector WorldPosition = BaseWorldPosition + OffsetCorners[CornerIdx];
-            Vertices.Add(WorldToComponent.TransformPosition(WorldPosition));
-            Normals.Add(-LocalNormal);
-            UVs.Add(QuadUVs[CornerIdx]);
-            VertexColors.Add(Point.bIsVisible ? VisibleColor : HiddenColor);
-            Tangents.Add(FProcMeshTangent(-LocalTangentDir, false));
+            Exploration->AccumulatePoints(Batch, bWorldRaster_SurfaceHitsOnly);
         }
-
-        // Front face
-        Triangles.Add(FrontBaseIndex + 0);
-        Triangles.Add(FrontBaseIndex + 1);
-        Triangles.Add(FrontBaseIndex + 2);
-
-        Triangles.Add(FrontBaseIndex + 0);
-        Triangles.Add(FrontBaseIndex + 2);
-        Triangles.Add(FrontBaseIndex + 3);
-
-        // Back face (reverse winding)
-        Triangles.Add(BackBaseIndex + 0);
-        Triangles.Add(BackBaseIndex + 2);
-        Triangles.Add(BackBaseIndex + 1);
-
-        Triangles.Add(BackBaseIndex + 0);
-        Triangles.Add(BackBaseIndex + 3);
-        Triangles.Add(BackBaseIndex + 2);
     }
+    return true;
+}
 
-    if (Triangles.Num() == 0 || Vertices.Num() == 0)
+/**
+ * Write the stream file index and finalize a streamed analysis
+ */
+void ACPP_Actor__Viewshed::FinishStreamingAnalysis()
+{
+    const bool bWritten = StreamWriter.IsValid() && StreamWriter->Close();
+    StreamWriter.Reset();
+    bAnalysisInProgress = false;
+    if (!bWritten)
     {
         return;
     }
 
-    VisibleVisualization_ProceduralMeshComponent->CreateMeshSection_LinearColor(
-        0,
-        Vertices,
-        Triangles,
-        Normals,
-        UVs,
-        {},
-        {},
-        {},
-        VertexColors,
-        Tangents,
-        false,
-        false);
+    // No band results are resident: the raster, its pyramid and listeners see the completed analysis
+    FinalizeAnalysis();
+}
+
+/**
+ * Absolute path of the stream output file
+ */
+FString ACPP_Actor__Viewshed::GetStreamOutputPath() const
+{
+    FString OutputPath = StreamOutputFile.FilePath;
+    if (!OutputPath.IsEmpty() && FPaths::IsRelative(OutputPath))
+    {
+        OutputPath = FPaths::Combine(FPaths::ProjectDir(), OutputPath);
+    }
+    return OutputPath;
+}
+
+/**
+ * Build Debug Point Mesh
+ * Transforms are built in parallel and each component receives a single batched submission
+ */
+void ACPP_Actor__Viewshed::BuildDebug_PointMesh()
+{
+    if (!Debug_VisiblePointsISMC && !Debug_HiddenPointsISMC)
+    {
+        return;
+    }
+
+    // A combined material lets the visible component carry both states through per-instance custom data
+    const bool bCombined = Debug_CombinedPointMaterial != nullptr;
+    UInstancedStaticMeshComponent *VisibleTarget = Debug_VisiblePointsISMC;
+    UInstancedStaticMeshComponent *HiddenTarget = bCombined ? Debug_VisiblePointsISMC : Debug_HiddenPointsISMC;
+    if (bCombined && Debug_VisiblePointsISMC)
+    {
+        Debug_VisiblePointsISMC->SetMaterial(0, Debug_CombinedPointMaterial);
+    }
+
+    // Number the shown points per target component so the parallel pass writes straight into its slot
+    TArray<int32> InstanceSlots;
+    InstanceSlots.SetNumUninitialized(AnalysisResults.Num());
+    int32 VisibleCount = 0;
+    int32 HiddenCount = 0;
+    for (int32 i = 0; i < AnalysisResults.Num(); ++i)
+    {
+        const bool bIsVisible = AnalysisResults[i].bIsVisible;
+        const bool bShown = bIsVisible ? (bDebug_ShowVisiblePoints && VisibleTarget) : (bDebug_ShowHiddenPoints && HiddenTarget);
+        if (!bShown)
+        {
+            InstanceSlots[i] = INDEX_NONE;
+        }
+        else if (bIsVisible || bCombined)
+        {
+            InstanceSlots[i] = VisibleCount++;
+        }
+        else
+        {
+            InstanceSlots[i] = HiddenCount++;
+        }
+    }
+
+    TArray<FTransform> VisibleTransforms;
+    TArray<float> VisibleCustomData;
+    TArray<FTransform> HiddenTransforms;
+    TArray<float> HiddenCustomData;
+    VisibleTransforms.SetNumUninitialized(VisibleCount);
+    VisibleCustomData.SetNumUninitialized(VisibleCount);
+    HiddenTransforms.SetNumUninitialized(HiddenCount);
+    HiddenCustomData.SetNumUninitialized(HiddenCount);
+
+    const FVector ObserverLoc = GetObserverLocation();
+    const FVector PointScale(Debug_PointScale);
+    ParallelFor(AnalysisResults.Num(), [&](int32 PointIndex)
+                {
+        const int32 Slot = InstanceSlots[PointIndex];
+        if (Slot == INDEX_NONE)
+        {
+            return;
+        }
+        const FS__ViewShedPoint &Point = AnalysisResults[PointIndex];
+
+        // Position relative to the viewshed origin (slightly offset upward for visibility); spheres need no rotation
+        const FTransform InstanceTransform(FQuat::Identity, (Point.WorldPosition - ObserverLoc) + FVector(0, 0, 10), PointScale);
+        const bool bToVisibleTarget = Point.bIsVisible || bCombined;
+        (bToVisibleTarget ? VisibleTransforms : HiddenTransforms)[Slot] = InstanceTransform;
+        (bToVisibleTarget ? VisibleCustomData : HiddenCustomData)[Slot] = Point.bIsVisible ? 1.0f : 0.0f; });
+
+    SubmitPointInstances(VisibleTarget, VisibleTransforms, VisibleCustomData, Debug_VisiblePointsSubmittedData);
+    if (!bCombined)
+    {
+        SubmitPointInstances(HiddenTarget, HiddenTransforms, HiddenCustomData, Debug_HiddenPointsSubmittedData);
+    }
+}
+
+/**
+ * Replace a point component's instances in one batch
+ */
+void ACPP_Actor__Viewshed::SubmitPointInstances(UInstancedStaticMeshComponent *Component, const TArray<FTransform> &Transforms, const TArray<float> &Visibility,
+                                                TArray<float> &InOutSubmittedVisibility)
+{
+    if (!Component)
+    {
+        return;
+    }
+
+    // Same instance count keeps the per-instance buffers and only rewrites transforms
+    const bool bSameLayout = Component->GetInstanceCount() == Transforms.Num() && Component->NumCustomDataFloats == 1 &&
+                             InOutSubmittedVisibility.Num() == Visibility.Num();
+    if (bSameLayout)
+    {
+        Component->BatchUpdateInstancesTransforms(0, Transforms, false, false, true);
+    }
+    else
+    {
+        Component->ClearInstances();
+        Component->SetNumCustomDataFloats(1);
+        Component->AddInstances(Transforms, false, false);
+    }
+
+    // Custom data goes through the instance update path so the render copy follows; in place, only changed values are sent
+    bool bVisibilityChanged = false;
+    for (int32 i = 0; i < Visibility.Num(); ++i)
+    {
+        if (!bSameLayout || InOutSubmittedVisibility[i] != Visibility[i])
+        {
+            Component->SetCustomDataValue(i, 0, Visibility[i], false);
+            bVisibilityChanged = true;
+        }
+    }
+    InOutSubmittedVisibility = Visibility;
+
+    if (bVisibilityChanged)
+    {
+        Component->MarkRenderStateDirty();
+    }
+}
+
+namespace
+{
+    /** Octahedron marker: unit axis vertices and outward-facing (clockwise) triangles */
+    const FVector OctahedronVertices[6] = {
+        FVector(1, 0, 0), FVector(-1, 0, 0), FVector(0, 1, 0), FVector(0, -1, 0), FVector(0, 0, 1), FVector(0, 0, -1)};
+    const int32 OctahedronIndices[24] = {
+        0, 4, 2, 0, 2, 5, 0, 3, 4, 0, 5, 3, 1, 2, 4, 1, 5, 2, 1, 4, 3, 1, 3, 5};
+
+    /** Tetrahedron marker used in far bands */
+    const FVector TetrahedronVertices[4] = {
+        FVector(1, 1, 1) * UE_INV_SQRT_3, FVector(1, -1, -1) * UE_INV_SQRT_3, FVector(-1, 1, -1) * UE_INV_SQRT_3, FVector(-1, -1, 1) * UE_INV_SQRT_3};
+    const int32 TetrahedronIndices[12] = {
+        0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3};
+}
+
+/**
+ * Build Debug Procedural Merged Mesh
+ * One low-poly marker per sample, merged into a visible and a hidden section; far bands get fewer, simpler markers
+ */
+void ACPP_Actor__Viewshed::BuildDebug_ProceduralMergedMesh()
+{
+    if (!Debug_ProceduralMeshComponent)
+    {
+        return;
+    }
+
+    Debug_ProceduralMeshComponent->ClearAllMeshSections();
+
+    if (AnalysisResults.IsEmpty())
+    {
+        return;
+    }
+
+    // Band and lattice position are only known when the results line up with the trace queue
+    const bool bHasLattice = RayStore.Num() == AnalysisResults.Num();
+    const int32 FarStride = FMath::Max(1, Debug_MarkerFarStride);
+    const auto IsFarBand = [&](int32 PointIndex)
+    {
+        return bHasLattice && RayStore.GetBandIndex(PointIndex) >= Debug_MarkerLODStartBand;
+    };
+
+    // Pass 1: density LOD - far bands keep every FarStride-th lattice row and column
+    TArray<bool> Kept;
+    Kept.SetNumUninitialized(AnalysisResults.Num());
+    int32 KeptCount = 0;
+    for (int32 i = 0; i < AnalysisResults.Num(); ++i)
+    {
+        const bool bShown = AnalysisResults[i].bIsVisible ? bDebug_ShowVisiblePoints : bDebug_ShowHiddenPoints;
+        bool bKeep = bShown;
+        if (bKeep && IsFarBand(i))
+        {
+            int32 BandIndex = 0;
+            int32 HorizontalIndex = 0;
+            int32 VerticalIndex = 0;
+            RayStore.GetRayCoordinates(i, BandIndex, HorizontalIndex, VerticalIndex);
+            bKeep = (HorizontalIndex % FarStride) == 0 && (VerticalIndex % FarStride) == 0;
+        }
+        Kept[i] = bKeep;
+        KeptCount += bKeep ? 1 : 0;
+    }
+
+    // Pass 2: bound the total by uniform decimation, then give every marker its vertex and index offsets
+    const int32 CapStride = FMath::DivideAndRoundUp(KeptCount, FMath::Max(1, Debug_MaxMarkers));
+    TArray<FIntPoint> MarkerOffsets;
+    MarkerOffsets.SetNumUninitialized(AnalysisResults.Num());
+    FIntPoint SectionSizes[2] = {FIntPoint::ZeroValue, FIntPoint::ZeroValue};
+    int32 KeptSeen = 0;
+    for (int32 i = 0; i < AnalysisResults.Num(); ++i)
+    {
+        MarkerOffsets[i] = FIntPoint(INDEX_NONE, INDEX_NONE);
+        if (!Kept[i] || (KeptSeen++ % CapStride) != 0)
+        {
+            continue;
+        }
+        FIntPoint &Size = SectionSizes[AnalysisResults[i].bIsVisible ? 0 : 1];
+        MarkerOffsets[i] = Size;
+        Size += IsFarBand(i) ? FIntPoint(UE_ARRAY_COUNT(TetrahedronVertices), UE_ARRAY_COUNT(TetrahedronIndices))
+                             : FIntPoint(UE_ARRAY_COUNT(OctahedronVertices), UE_ARRAY_COUNT(OctahedronIndices));
+    }
+
+    for (int32 Section = 0; Section < 2; ++Section)
+    {
+        DebugMarkerSections[Section].Reset();
+        DebugMarkerSections[Section].SetVertexCount(SectionSizes[Section].X);
+        DebugMarkerSections[Section].Triangles.SetNumUninitialized(SectionSizes[Section].Y);
+    }
+
+    // Pass 3: every marker writes its own slice of its section in parallel
+    const FVector ObserverLoc = GetObserverLocation();
+    // Matches the radius of the engine sphere used by the instanced points
+    const float MarkerRadius = 50.0f * Debug_PointScale;
+    ParallelFor(AnalysisResults.Num(), [&](int32 PointIndex)
+                {
+        const FIntPoint Offset = MarkerOffsets[PointIndex];
+        if (Offset.X == INDEX_NONE)
+        {
+            return;
+        }
+        const FS__ViewShedPoint &Point = AnalysisResults[PointIndex];
+        FS__ViewShedBlanketMesh &Target = DebugMarkerSections[Point.bIsVisible ? 0 : 1];
+        const FLinearColor &Color = Point.bIsVisible ? FS__ViewShedBlanketMesh::VisibleColor : FS__ViewShedBlanketMesh::HiddenColor;
+
+        const bool bFar = IsFarBand(PointIndex);
+        const TConstArrayView<FVector> MarkerVertices = bFar ? TConstArrayView<FVector>(TetrahedronVertices) : TConstArrayView<FVector>(OctahedronVertices);
+        const TConstArrayView<int32> MarkerIndices = bFar ? TConstArrayView<int32>(TetrahedronIndices) : TConstArrayView<int32>(OctahedronIndices);
+
+        // Same placement as the instanced points: relative to the viewshed origin, slightly raised
+        const FVector Center = (Point.WorldPosition - ObserverLoc) + FVector(0, 0, 10);
+        for (int32 VertexIdx = 0; VertexIdx < MarkerVertices.Num(); ++VertexIdx)
+        {
+            Target.WriteVertex(Offset.X + VertexIdx, Center + MarkerVertices[VertexIdx] * MarkerRadius, MarkerVertices[VertexIdx],
+                               FVector2D::ZeroVector, Color, FVector::ForwardVector);
+        }
+        for (int32 IndexIdx = 0; IndexIdx < MarkerIndices.Num(); ++IndexIdx)
+        {
+            Target.Triangles[Offset.Y + IndexIdx] = Offset.X + MarkerIndices[IndexIdx];
+        } });
+
+    // One section per state so each gets its own material: at most two draw calls
+    UMaterialInterface *SectionMaterials[2] = {VisibleMaterial, HiddenMaterial};
+    for (int32 Section = 0; Section < 2; ++Section)
+    {
+        const FS__ViewShedBlanketMesh &Mesh = DebugMarkerSections[Section];
+        if (Mesh.IsEmpty())
+        {
+            continue;
+        }
+        Debug_ProceduralMeshComponent->CreateMeshSection_LinearColor(
+            Section,
+            Mesh.Vertices,
+            Mesh.Triangles,
+            Mesh.Normals,
+            Mesh.UVs,
+            {},
+            {},
+            {},
+            Mesh.VertexColors,
+            Mesh.Tangents,
+            false,
+            false);
+        if (SectionMaterials[Section])
+        {
+            Debug_ProceduralMeshComponent->SetMaterial(Section, SectionMaterials[Section]);
+        }
+    }
+}
+
+/**
+ * Build Visible Visualization Procedural Merged Mesh
+ * Snapshots the results and builds the section buffers on the thread pool; ApplyBlanketBuild uploads them
+ */
+void ACPP_Actor__Viewshed::BuildVisibleVisualization_ProceduralMergedMesh()
+{
+    if (!VisibleVisualization_ProceduralMeshComponent)
+    {
+        return;
+    }
+
+    if (AnalysisResults.IsEmpty())
+    {
+        VisibleVisualization_ProceduralMeshComponent->ClearAllMeshSections();
+        UploadedBlanketTopologyHash = 0;
+        return;
+    }
+
+    // The worker owns the build buffers until it finishes; pick up the newest results afterwards
+    if (BlanketBuildFuture.IsValid())
+    {
+        bBlanketRebuildQueued = true;
+        return;
+    }
+
+    if (!BlanketBuild.IsValid())
+    {
+        BlanketBuild = MakeShared<FS__ViewShedBlanketBuild>();
+    }
+
+    // Snapshot the inputs into the reused build; results may be replaced or released before the worker finishes
+    FS__ViewShedBlanketBuild &Build = *BlanketBuild;
+    Build.Mode = VisibleVisualization_MeshMode;
+    Build.Points.Reset();
+    Build.Points.Append(AnalysisResults);
+    // The ray store is one direction per lattice sample, so copying it is cheap next to the results
+    Build.Rays.Reset();
+    if (VisibleVisualization_MeshMode != E__ViewShedBlanketMode::Quads)
+    {
+        Build.Rays = RayStore;
+    }
+    Build.Lattice = GetHorizonLattice();
+    Build.ObserverLocation = GetObserverLocation();
+    Build.ObserverRotation = GetObserverRotation();
+    Build.WorldToComponent = VisibleVisualization_ProceduralMeshComponent->GetComponentTransform().Inverse();
+    Build.SurfaceOffset = VisibleVisualization_SurfaceOffset;
+    Build.QuadHalfSize = FMath::Max(1.0f, VisibleVisualization_QuadHalfSize);
+    Build.GridContinuity = VisibleVisualization_GridContinuity;
+    Build.MergeToleranceDegrees = VisibleVisualization_MergeToleranceDegrees;
+    Build.MergeBandGrowth = VisibleVisualization_MergeBandGrowth;
+
+    // The task holds its own reference, so the buffers outlive the actor if it is destroyed mid-build
+    TSharedPtr<FS__ViewShedBlanketBuild> BuildRef = BlanketBuild;
+    BlanketBuildFuture = Async(EAsyncExecution::ThreadPool, [BuildRef]()
+                               { BuildRef->Execute(); });
+}
+
+/**
+ * Upload a finished blanket build and start any queued rebuild
+ */
+void ACPP_Actor__Viewshed::ApplyBlanketBuild()
+{
+    if (!BlanketBuildFuture.IsValid() || !BlanketBuildFuture.IsReady())
+    {
+        return;
+    }
+    BlanketBuildFuture = TFuture<void>();
+
+    // Newer results arrived while building; this mesh is already stale
+    if (bBlanketRebuildQueued)
+    {
+        bBlanketRebuildQueued = false;
+        BuildVisibleVisualization_ProceduralMergedMesh();
+        return;
+    }
+
+    // The blanket may have been disabled while building
+    UProceduralMeshComponent *MeshComponent = VisibleVisualization_ProceduralMeshComponent;
+    if (!MeshComponent)
+    {
+        UploadedBlanketTopologyHash = 0;
+        return;
+    }
+
+    const FS__ViewShedBlanketMesh &Mesh = BlanketBuild->Mesh;
+    if (Mesh.IsEmpty())
+    {
+        MeshComponent->ClearAllMeshSections();
+        UploadedBlanketTopologyHash = 0;
+        return;
+    }
+
+    // Same index buffer and vertex count: only stream the vertex attributes into the existing section
+    const FProcMeshSection *Section = MeshComponent->GetProcMeshSection(0);
+    if (Section && Section->ProcVertexBuffer.Num() == Mesh.Vertices.Num() && UploadedBlanketTopologyHash == BlanketBuild->TopologyHash)
+    {
+        MeshComponent->UpdateMeshSection_LinearColor(
+            0,
+            Mesh.Vertices,
+            Mesh.Normals,
+            Mesh.UVs,
+            {},
+            {},
+            {},
+            Mesh.VertexColors,
+            Mesh.Tangents,
+            false);
+        return;
+    }
+
+    MeshComponent->CreateMeshSection_LinearColor(
+        0,
+        Mesh.Vertices,
+        Mesh.Triangles,
+        Mesh.Normals,
+        Mesh.UVs,
+        {},
+        {},
+        {},
+        Mesh.VertexColors,
+        Mesh.Tangents,
+        false,
+        false);
+    UploadedBlanketTopologyHash = BlanketBuild->TopologyHash;
 
     if (VisibleMaterial)
     {
-        VisibleVisualization_ProceduralMeshComponent->SetMaterial(0, VisibleMaterial);
+        MeshComponent->SetMaterial(0, VisibleMaterial);
+    }
+}
+
+/**
+ * Rebuild the spatial index from current results
+ */
+void ACPP_Actor__Viewshed::RebuildSpatialIndex()
+{
+    SpatialIndex.Reset();
+
+    if (!bBuildSpatialIndex)
+    {
+        return;
+    }
+
+    // Horizon results are indexed per direction rather than per band sample
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        SpatialIndex.Build(HorizonMap, RayStore, SpatialIndex_TargetPointsPerCell);
+        return;
+    }
+
+    if (AnalysisResults.IsEmpty())
+    {
+        return;
+    }
+
+    SpatialIndex.Build(AnalysisResults, SpatialIndex_TargetPointsPerCell);
+}
+
+/**
+ * Rebuild the packed result columns from current results
+ */
+void ACPP_Actor__Viewshed::RebuildResultColumns()
+{
+    // Horizon results pack their columns straight from the horizon map once; a few bits per ray stay resident instead of the points
+    if (HorizonMap.IsBuilt())
+    {
+        ResultColumns.Build(HorizonMap, RayStore);
+        return;
+    }
+    ResultColumns.Build(AnalysisResults, RayStore);
+}
+
+/**
+ * Centre and clear the world raster around the observer
+ */
+void ACPP_Actor__Viewshed::InitializeWorldRaster()
+{
+    if (!bEnableWorldRaster)
+    {
+        WorldRaster.Reset();
+        return;
+    }
+
+    const FVector ObserverLoc = GetObserverLocation();
+    WorldRaster.Initialize(FVector2D(ObserverLoc.X, ObserverLoc.Y), WorldRaster_CellSize, WorldRaster_Resolution);
+    // The pyramid describes the previous raster until the new analysis completes
+    VisibilityPyramid.Reset();
+}
+
+/**
+ * Create or resize the raster texture and upload the current raster
+ */
+void ACPP_Actor__Viewshed::UpdateWorldRasterTexture()
+{
+    if (!bEnableWorldRaster || !bWorldRaster_CreateTexture || !WorldRaster.IsInitialized() || IsAnalysisOnly())
+    {
+        return;
+    }
+
+    const int32 Resolution = WorldRaster.GetResolution();
+    if (!WorldRasterTexture || WorldRasterTexture->GetSizeX() != Resolution || WorldRasterTexture->GetSizeY() != Resolution)
+    {
+        WorldRasterTexture = UTexture2D::CreateTransient(Resolution, Resolution, PF_B8G8R8A8, TEXT("ViewshedWorldRaster"));
+        if (!WorldRasterTexture)
+        {
+            return;
+        }
+        // Cells are discrete states, so sample without filtering
+        WorldRasterTexture->Filter = TF_Nearest;
+        WorldRasterTexture->SRGB = false;
+        WorldRasterTexture->UpdateResource();
+    }
+
+    WorldRaster.FillTexture(WorldRasterTexture);
+}
+
+/**
+ * Pack the current first-occluder distances into the decal's occluder texture
+ */
+void ACPP_Actor__Viewshed::UpdateHorizonOccluderTexture()
+{
+    // The decal shader looks occluders up on a grid lattice; patterned rays have no texel layout
+    if (!bVS_UseOcclusionTexture || IsAnalysisOnly() || SamplingPatternData)
+    {
+        return;
+    }
+
+    // Horizon Map mode already holds the distances; other modes collapse their band results first
+    FS__ViewShedHorizonMap CollapsedHorizon;
+    const FS__ViewShedHorizonMap *Source = &HorizonMap;
+    if (ResultMode != E__ViewShedResultMode::HorizonMap)
+    {
+        CollapsedHorizon.Build(GetHorizonLattice(), AnalysisResults, RayStore);
+        Source = &CollapsedHorizon;
+    }
+    if (!Source->IsBuilt())
+    {
+        return;
+    }
+
+    const int32 Width = Source->Lattice.HorizontalSampleCount;
+    const int32 Height = Source->Lattice.VerticalSampleCount;
+    if (!HorizonOccluderTexture || HorizonOccluderTexture->GetSizeX() != Width || HorizonOccluderTexture->GetSizeY() != Height)
+    {
+        HorizonOccluderTexture = UTexture2D::CreateTransient(Width, Height, PF_R32_FLOAT, TEXT("ViewshedHorizonOccluders"));
+        if (!HorizonOccluderTexture)
+        {
+            return;
+        }
+        // One texel per ray direction: nearest sampling matches FindDirectionIndex, clamping keeps edge rays at the FOV border
+        HorizonOccluderTexture->Filter = TF_Nearest;
+        HorizonOccluderTexture->AddressX = TA_Clamp;
+        HorizonOccluderTexture->AddressY = TA_Clamp;
+        HorizonOccluderTexture->SRGB = false;
+        HorizonOccluderTexture->UpdateResource();
+    }
+
+    Source->FillOccluderTexture(HorizonOccluderTexture);
+    HorizonOccluderLattice = Source->Lattice;
+}
+
+/**
+ * Re-rasterize all current results in parallel tiles
+ */
+void ACPP_Actor__Viewshed::RebuildWorldRaster()
+{
+    InitializeWorldRaster();
+    ForEachResultBatch([this](TConstArrayView<FS__ViewShedPoint> Batch)
+                       { WorldRaster.SplatAllParallel(Batch, bWorldRaster_SurfaceHitsOnly); });
+    UpdateWorldRasterTexture();
+    RebuildVisibilityPyramid();
+}
+
+/**
+ * Rebuild the visibility pyramid from the finished world raster
+ */
+void ACPP_Actor__Viewshed::RebuildVisibilityPyramid()
+{
+    VisibilityPyramid.Reset();
+
+    if (!bEnableWorldRaster || !bWorldRaster_BuildVisibilityPyramid)
+    {
+        return;
     }
+
+    VisibilityPyramid.Build(WorldRaster);
 }
 
 /**
  * Update visualization based on current analysis results
- * Clears existing instances and creates new ones based on visibility
+ * Replaces point instances and rebuilds meshes based on visibility
  */
 void ACPP_Actor__Viewshed::UpdateVisualization()
 {
+    // Bring the component set in line with the flags; analysis-only observers end up with none
+    SyncVisualizationComponents();
+    if (IsAnalysisOnly())
+    {
+        return;
+    }
+
     // Anchor components at the viewshed origin so they rotate around the correct pivot
     const FVector ObserverLoc = GetObserverLocation();
     const FVector ActorLocation = GetActorLocation();
@@ -852,31 +1875,147 @@ void ACPP_Actor__Viewshed::UpdateVisualization()
         VisibleVisualization_ProceduralMeshComponent->SetWorldRotation(ActorRotation);
     }
 
-    // Clear existing instances from both components (defensive checks)
-    if (Debug_VisiblePointsISMC)
-        Debug_VisiblePointsISMC->ClearInstances();
-    if (Debug_HiddenPointsISMC)
-        Debug_HiddenPointsISMC->ClearInstances();
+    // Point instances are replaced in place by BuildDebug_PointMesh
     if (Debug_ProceduralMeshComponent)
         Debug_ProceduralMeshComponent->ClearAllMeshSections();
-    if (VisibleVisualization_ProceduralMeshComponent)
-        VisibleVisualization_ProceduralMeshComponent->ClearAllMeshSections();
 
-    if (bDebug_ShowDebugVisualization)
+    if (bDebug_ShowDebugVisualization)
+    {
+        if (bDebug_UseProceduralMesh)
+        {
+            // Build and update the merged procedural mesh from current points
+            BuildDebug_ProceduralMergedMesh();
+        }
+        else
+        {
+            // Build and update the point mesh from current points
+            BuildDebug_PointMesh();
+        }
+    }
+
+    BuildVisibleVisualization_ProceduralMergedMesh();
+}
+
+/**
+ * Rebuild the visualization from the current results
+ */
+void ACPP_Actor__Viewshed::RefreshVisualization()
+{
+    // Streamed results are not resident: keep whatever was built and only bring the component set in line with the flags
+    if (ResultMode == E__ViewShedResultMode::Streamed)
+    {
+        SyncVisualizationComponents();
+        return;
+    }
+
+    // Horizon Map results are expanded only for the rebuild, as in FinalizeAnalysis
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        DeriveResultsFromHorizonMap(AnalysisResults);
+        UpdateVisualization();
+        AnalysisResults.Empty();
+        return;
+    }
+
+    UpdateVisualization();
+}
+
+namespace
+{
+    /** Create a lazily owned component when first needed and destroy it once it is not */
+    template <typename ComponentType, typename CreateFunctionType>
+    void SyncLazyComponent(ComponentType *&Component, bool bNeeded, CreateFunctionType &&CreateFunction)
+    {
+        if (bNeeded && !Component)
+        {
+            Component = CreateFunction();
+        }
+        else if (!bNeeded && Component)
+        {
+            Component->DestroyComponent();
+            Component = nullptr;
+        }
+    }
+}
+
+/**
+ * Create the visualization components the current flags need and destroy the ones they no longer need
+ */
+void ACPP_Actor__Viewshed::SyncVisualizationComponents()
+{
+    const bool bVisualize = !IsAnalysisOnly();
+    const bool bDebugPoints = bVisualize && bDebug_ShowDebugVisualization && !bDebug_UseProceduralMesh;
+    const bool bDebugMesh = bVisualize && bDebug_ShowDebugVisualization && bDebug_UseProceduralMesh;
+
+    // With a combined material the visible component also carries the hidden points
+    const bool bCombinedPoints = Debug_CombinedPointMaterial != nullptr;
+
+    SyncLazyComponent(Debug_VisiblePointsISMC, bDebugPoints && (bDebug_ShowVisiblePoints || (bCombinedPoints && bDebug_ShowHiddenPoints)),
+                      [this]() { return CreatePointsISMC(TEXT("VisiblePointsISMC"), VisibleMaterial); });
+    SyncLazyComponent(Debug_HiddenPointsISMC, bDebugPoints && bDebug_ShowHiddenPoints && !bCombinedPoints,
+                      [this]() { return CreatePointsISMC(TEXT("HiddenPointsISMC"), HiddenMaterial); });
+    SyncLazyComponent(Debug_ProceduralMeshComponent, bDebugMesh,
+                      [this]() { return CreateVisualizationMesh(TEXT("ProceduralMeshComponent")); });
+    SyncLazyComponent(VisibleVisualization_ProceduralMeshComponent, bVisualize && bShowVisibleVisualization,
+                      [this]() { return CreateVisualizationMesh(TEXT("VisibleVisualization_ProceduralMeshComponent")); });
+}
+
+/**
+ * Create and register a debug point instance component
+ */
+UInstancedStaticMeshComponent *ACPP_Actor__Viewshed::CreatePointsISMC(FName BaseName, UMaterialInterface *Material)
+{
+    // The default sphere is only loaded once an observer actually shows points
+    if (!Debug_VisiblePointMesh)
+    {
+        Debug_VisiblePointMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+    }
+
+    // Unique name so a component still pending destruction never collides with its replacement
+    UInstancedStaticMeshComponent *Component = NewObject<UInstancedStaticMeshComponent>(
+        this, MakeUniqueObjectName(this, UInstancedStaticMeshComponent::StaticClass(), BaseName));
+    Component->SetupAttachment(RootComponent);
+    // Disable collision since these are just visualization
+    Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    // Disable shadows for better performance
+    Component->SetCastShadow(false);
+    Component->SetMobility(EComponentMobility::Movable);
+    // Instances are placed relative to the observer, not the actor transform
+    Component->SetUsingAbsoluteLocation(true);
+    Component->SetUsingAbsoluteRotation(true);
+    // Exclude from receiving decals (so our own decal doesn't paint our markers)
+    Component->SetReceivesDecals(false);
+    if (Debug_VisiblePointMesh)
     {
-        if (bDebug_UseProceduralMesh)
-        {
-            // Build and update the merged procedural mesh from current points
-            BuildDebug_ProceduralMergedMesh();
-        }
-        else
-        {
-            // Build and update the point mesh from current points
-            BuildDebug_PointMesh();
-        }
+        Component->SetStaticMesh(Debug_VisiblePointMesh);
     }
+    if (Material)
+    {
+        Component->SetMaterial(0, Material);
+    }
+    Component->RegisterComponent();
+    return Component;
+}
 
-    BuildVisibleVisualization_ProceduralMergedMesh();
+/**
+ * Create and register a visualization procedural mesh component
+ */
+UProceduralMeshComponent *ACPP_Actor__Viewshed::CreateVisualizationMesh(FName BaseName)
+{
+    UProceduralMeshComponent *Component = NewObject<UProceduralMeshComponent>(
+        this, MakeUniqueObjectName(this, UProceduralMeshComponent::StaticClass(), BaseName));
+    Component->SetupAttachment(RootComponent);
+    // Disable shadows for better performance
+    Component->SetCastShadow(false);
+    // Use async cooking for performance
+    Component->bUseAsyncCooking = true;
+    Component->SetMobility(EComponentMobility::Movable);
+    Component->SetUsingAbsoluteLocation(true);
+    Component->SetUsingAbsoluteRotation(true);
+    // Exclude from receiving decals
+    Component->SetReceivesDecals(false);
+    Component->RegisterComponent();
+    return Component;
 }
 
 /**
@@ -888,6 +2027,15 @@ FVector ACPP_Actor__Viewshed::GetObserverLocation() const
     return GetActorLocation() + FVector(0, 0, ObserverHeight);
 }
 
+/**
+ * Orthonormal observer frame every ray direction is rotated by
+ * MakeFromZX keeps Up fixed and re-derives Forward perpendicular to it; Right is Up x Forward
+ */
+FQuat ACPP_Actor__Viewshed::GetObserverRotation() const
+{
+    return FRotationMatrix::MakeFromZX(GetActorUpVector(), GetActorForwardVector()).ToQuat();
+}
+
 /**
  * Draw debug visualization showing the viewshed pyramid bounds
  */
@@ -946,6 +2094,24 @@ void ACPP_Actor__Viewshed::DrawDebugPyramid() const
     DrawDebugLine(GetWorld(), ObserverLoc, CenterEnd, FColor::Yellow, false, -1, 0, 4.0f);
 }
 
+namespace
+{
+    /** Running hash of the inputs of a decal update; all hashed types are padding-free PODs or pointers */
+    struct FViewshedDecalHash
+    {
+        uint64 Value = 0;
+
+        template <typename ValueType>
+        void Add(const ValueType &InValue)
+        {
+            Value = CityHash64WithSeed(reinterpret_cast<const char *>(&InValue), sizeof(ValueType), Value);
+        }
+    };
+}
+
+/**
+ * Place the decal over the frustum and feed its material, skipping whatever did not change since the last call
+ */
 void ACPP_Actor__Viewshed::UpdateHiddenVisualizationDecal()
 {
     if (!HiddenVisualizationDecalComponent)
@@ -960,43 +2126,156 @@ void ACPP_Actor__Viewshed::UpdateHiddenVisualizationDecal()
     // Re-orthonormalize Up in case of near-colinearity with Forward
     Up = FVector::CrossProduct(Right, Forward).GetSafeNormal();
 
-    // Align decal so X+ projects forward
-    const FRotator DecalRot = FRotationMatrix::MakeFromXZ(Forward, Up).Rotator();
-    // Place the projector mid-way along the frustum depth so the box spans from origin to far plane
-    // UE decals use a box centered on the component location; X is depth (half-size), Y/Z are half extents
-    const float HalfDepth = MaxDistance * 0.5f;
-    HiddenVisualizationDecalComponent->SetWorldLocation(Origin + Forward * HalfDepth);
-    HiddenVisualizationDecalComponent->SetWorldRotation(DecalRot);
-
-    // Size decal to encompass the frustum at MaxDistance
-    const float HalfH = FMath::DegreesToRadians(HorizontalFOV * 0.5f);
-    const float HalfV = FMath::DegreesToRadians(VerticalFOV * 0.5f);
-    const float HalfWidthAtFar = MaxDistance * FMath::Tan(HalfH);
-    const float HalfHeightAtFar = MaxDistance * FMath::Tan(HalfV);
-    // Slightly pad the projector to avoid edge clipping
-    const float Pad = 1.02f;
-    HiddenVisualizationDecalComponent->DecalSize = FVector(HalfDepth * Pad, HalfWidthAtFar * Pad, HalfHeightAtFar * Pad);
-
-    // Feed runtime parameters to the decal material (shader should test frustum and normal dot)
-    if (HiddenVisualizationDecalMID)
-    {
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_MaxDistance"), MaxDistance);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_VertFOVDeg"), VerticalFOV);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_HorizFOVDeg"), HorizontalFOV);
-        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Origin"), FLinearColor(Origin));
-        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Forward"), FLinearColor(Forward));
-        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Right"), FLinearColor(Right));
-        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Up"), FLinearColor(Up));
-        // Additional tunables for the decal material
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_NormalThreshold"), VS_NormalThreshold);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_FrustumFeather"), VS_FrustumFeather);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_FacingFeather"), VS_FacingFeather);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_FacingEnabled"), VS_FacingEnabled);
-        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_ColorInside"), VS_ColorInside);
-        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_ColorOutside"), VS_ColorOutside);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_GridIntensity"), VS_GridIntensity);
-        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_Opacity"), VS_Opacity);
+    // Join or leave the shared parameter texture before hashing, so a new slot or texture forces a rebind
+    UCPP_Subsystem__ViewshedDecalParameters *SharedParameters = nullptr;
+    if (bVS_UseSharedParameters && HiddenVisualizationDecalMID && GetWorld())
+    {
+        SharedParameters = GetWorld()->GetSubsystem<UCPP_Subsystem__ViewshedDecalParameters>();
+    }
+    if (SharedParameters && SharedDecalSlot == INDEX_NONE)
+    {
+        SharedDecalSlot = SharedParameters->AcquireSlot();
+    }
+    else if (!SharedParameters)
+    {
+        ReleaseSharedDecalSlot();
+    }
+    const bool bShared = SharedParameters && SharedDecalSlot != INDEX_NONE;
+
+    // Frustum: projector transform and the parameters the mask is computed from
+    FViewshedDecalHash FrustumHash;
+    FrustumHash.Add(Origin);
+    FrustumHash.Add(Forward);
+    FrustumHash.Add(Right);
+    FrustumHash.Add(MaxDistance);
+    FrustumHash.Add(HorizontalFOV);
+    FrustumHash.Add(VerticalFOV);
+    FrustumHash.Add(VS_NormalThreshold);
+    FrustumHash.Add(HiddenVisualizationDecalMID);
+    FrustumHash.Add(SharedDecalSlot);
+    if (FrustumHash.Value != DecalFrustumHash)
+    {
+        DecalFrustumHash = FrustumHash.Value;
+
+        // Align decal so X+ projects forward
+        const FRotator DecalRot = FRotationMatrix::MakeFromXZ(Forward, Up).Rotator();
+        // Place the projector mid-way along the frustum depth so the box spans from origin to far plane
+        // UE decals use a box centered on the component location; X is depth (half-size), Y/Z are half extents
+        const float HalfDepth = MaxDistance * 0.5f;
+        HiddenVisualizationDecalComponent->SetWorldLocation(Origin + Forward * HalfDepth);
+        HiddenVisualizationDecalComponent->SetWorldRotation(DecalRot);
+
+        // Size decal to encompass the frustum at MaxDistance
+        const float HalfH = FMath::DegreesToRadians(HorizontalFOV * 0.5f);
+        const float HalfV = FMath::DegreesToRadians(VerticalFOV * 0.5f);
+        const float HalfWidthAtFar = MaxDistance * FMath::Tan(HalfH);
+        const float HalfHeightAtFar = MaxDistance * FMath::Tan(HalfV);
+        // Slightly pad the projector to avoid edge clipping
+        const float Pad = 1.02f;
+        HiddenVisualizationDecalComponent->DecalSize = FVector(HalfDepth * Pad, HalfWidthAtFar * Pad, HalfHeightAtFar * Pad);
+
+        if (bShared)
+        {
+            // One row in the shared texture; every observer's rows are uploaded together once per frame
+            SharedParameters->WriteFrustum(SharedDecalSlot, Origin, Forward, Right, Up, MaxDistance, VerticalFOV, HorizontalFOV, VS_NormalThreshold);
+        }
+        else if (HiddenVisualizationDecalMID)
+        {
+            // Feed runtime parameters to the decal material (shader should test frustum and normal dot)
+            HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_MaxDistance"), MaxDistance);
+            HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_VertFOVDeg"), VerticalFOV);
+            HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_HorizFOVDeg"), HorizontalFOV);
+            HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Origin"), FLinearColor(Origin));
+            HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Forward"), FLinearColor(Forward));
+            HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Right"), FLinearColor(Right));
+            HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_Up"), FLinearColor(Up));
+            HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_NormalThreshold"), VS_NormalThreshold);
+        }
+    }
+
+    if (!HiddenVisualizationDecalMID)
+    {
+        return;
+    }
+
+    // Tunables, occlusion texture and shared texture binding: only touched when edited or rebound
+    UTexture2D *SharedTexture = bShared ? SharedParameters->GetParameterTexture() : nullptr;
+    FViewshedDecalHash MaterialHash;
+    MaterialHash.Add(HiddenVisualizationDecalMID);
+    MaterialHash.Add(VS_FrustumFeather);
+    MaterialHash.Add(VS_FacingFeather);
+    MaterialHash.Add(VS_FacingEnabled);
+    MaterialHash.Add(VS_ColorInside);
+    MaterialHash.Add(VS_ColorOutside);
+    MaterialHash.Add(VS_GridIntensity);
+    MaterialHash.Add(VS_Opacity);
+    MaterialHash.Add(bVS_UseOcclusionTexture);
+    MaterialHash.Add(HorizonOccluderTexture);
+    // The lattice holds a pattern pointer after its PODs, so hash the packed fields rather than its padded bytes
+    MaterialHash.Add(HorizonOccluderLattice.HorizontalSampleCount);
+    MaterialHash.Add(HorizonOccluderLattice.VerticalSampleCount);
+    MaterialHash.Add(HorizonOccluderLattice.HalfHorizontalFOV);
+    MaterialHash.Add(HorizonOccluderLattice.HalfVerticalFOV);
+    MaterialHash.Add(VS_OcclusionTolerance);
+    MaterialHash.Add(VS_OcclusionFeather);
+    MaterialHash.Add(VS_ColorVisible);
+    MaterialHash.Add(SharedTexture);
+    MaterialHash.Add(SharedDecalSlot);
+    if (MaterialHash.Value == DecalMaterialHash)
+    {
+        return;
+    }
+    DecalMaterialHash = MaterialHash.Value;
+
+    // Additional tunables for the decal material
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_FrustumFeather"), VS_FrustumFeather);
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_FacingFeather"), VS_FacingFeather);
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_FacingEnabled"), VS_FacingEnabled);
+    HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_ColorInside"), VS_ColorInside);
+    HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_ColorOutside"), VS_ColorOutside);
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_GridIntensity"), VS_GridIntensity);
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_Opacity"), VS_Opacity);
+
+    // Shared frustum rows (ViewshedFetchSharedFrustum); per-MID frustum parameters are ignored while enabled
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_UseSharedParameters"), SharedTexture ? 1.0f : 0.0f);
+    if (SharedTexture)
+    {
+        HiddenVisualizationDecalMID->SetTextureParameterValue(TEXT("VS_SharedParameterTexture"), SharedTexture);
+        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_SharedParameterSlot"), float(SharedDecalSlot));
+    }
+
+    // Occlusion texture lookup (ViewshedMaskOccluded); disabled until a texture has been packed
+    const bool bOcclusion = bVS_UseOcclusionTexture && HorizonOccluderTexture;
+    HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_OcclusionEnabled"), bOcclusion ? 1.0f : 0.0f);
+    if (bOcclusion)
+    {
+        HiddenVisualizationDecalMID->SetTextureParameterValue(TEXT("VS_OccluderTexture"), HorizonOccluderTexture);
+        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_OccluderLattice"),
+                                                             FLinearColor(float(HorizonOccluderLattice.HorizontalSampleCount), float(HorizonOccluderLattice.VerticalSampleCount),
+                                                                          HorizonOccluderLattice.HalfHorizontalFOV, HorizonOccluderLattice.HalfVerticalFOV));
+        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_OcclusionTolerance"), VS_OcclusionTolerance);
+        HiddenVisualizationDecalMID->SetScalarParameterValue(TEXT("VS_OcclusionFeather"), VS_OcclusionFeather);
+        HiddenVisualizationDecalMID->SetVectorParameterValue(TEXT("VS_ColorVisible"), VS_ColorVisible);
+    }
+}
+
+/**
+ * Return this observer's row of the shared decal parameter texture
+ */
+void ACPP_Actor__Viewshed::ReleaseSharedDecalSlot()
+{
+    if (SharedDecalSlot == INDEX_NONE)
+    {
+        return;
     }
+    if (UWorld *World = GetWorld())
+    {
+        if (UCPP_Subsystem__ViewshedDecalParameters *SharedParameters = World->GetSubsystem<UCPP_Subsystem__ViewshedDecalParameters>())
+        {
+            SharedParameters->ReleaseSlot(SharedDecalSlot);
+        }
+    }
+    SharedDecalSlot = INDEX_NONE;
 }
 
 /**
@@ -1034,7 +2313,7 @@ bool ACPP_Actor__Viewshed::ShouldUpdateAnalysis() const
 {
     // Check if enough time has passed since last update
     float CurrentTime = GetWorld()->GetTimeSeconds();
-    return (CurrentTime - LastUpdateTime) >= UpdateInterval;
+    return (CurrentTime - LastUpdateTime) >= GetEffectiveUpdateInterval();
 }
 
 /**
@@ -1042,6 +2321,12 @@ bool ACPP_Actor__Viewshed::ShouldUpdateAnalysis() const
  */
 int32 ACPP_Actor__Viewshed::GetVisiblePointCount() const
 {
+    // Horizon Map mode counts on the columns packed from the horizon map instead of the points
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        return FS__ViewShedResultColumns::CountMask(ResultColumns.VisibilityBits);
+    }
+
     int32 Count = 0;
     // Count all visible points
     for (const FS__ViewShedPoint &Point : AnalysisResults)
@@ -1059,6 +2344,12 @@ int32 ACPP_Actor__Viewshed::GetVisiblePointCount() const
  */
 int32 ACPP_Actor__Viewshed::GetHiddenPointCount() const
 {
+    // Horizon Map mode counts on the columns packed from the horizon map instead of the points
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        return ResultColumns.Num() - FS__ViewShedResultColumns::CountMask(ResultColumns.VisibilityBits);
+    }
+
     int32 Count = 0;
     // Count all hidden points
     for (const FS__ViewShedPoint &Point : AnalysisResults)
@@ -1077,12 +2368,422 @@ int32 ACPP_Actor__Viewshed::GetHiddenPointCount() const
 float ACPP_Actor__Viewshed::GetVisibilityPercentage() const
 {
     // Avoid division by zero
-    if (AnalysisResults.Num() == 0)
+    const int32 ResultCount = GetAnalysisResultCount();
+    if (ResultCount == 0)
     {
         return 0.0f;
     }
 
     // Calculate percentage of visible points
     int32 VisibleCount = GetVisiblePointCount();
-    return (float(VisibleCount) / float(AnalysisResults.Num())) * 100.0f;
+    return (float(VisibleCount) / float(ResultCount)) * 100.0f;
+}
+
+/**
+ * Get a single analysis result by index
+ */
+bool ACPP_Actor__Viewshed::GetAnalysisResultAt(int32 Index, FS__ViewShedPoint &OutPoint) const
+{
+    // Horizon Map mode derives the single requested point
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        if (!RayStore.IsValidIndex(Index))
+        {
+            return false;
+        }
+        FS__ViewShedTracePoint TracePoint;
+        RayStore.GetTracePoint(Index, TracePoint);
+        HorizonMap.DeriveBandPoint(TracePoint, OutPoint);
+        return true;
+    }
+
+    if (!AnalysisResults.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    OutPoint = AnalysisResults[Index];
+    return true;
+}
+
+/**
+ * Find the visible result closest to a location using the spatial index
+ */
+int32 ACPP_Actor__Viewshed::FindNearestVisiblePointIndex(FVector Location, float MaxSearchDistance) const
+{
+    double BestDistanceSquared = TNumericLimits<double>::Max();
+    return SpatialIndex.VisibleGrid.FindNearest(Location, MaxSearchDistance, BestDistanceSquared);
+}
+
+/**
+ * Find the hidden result closest to a location using the spatial index
+ */
+int32 ACPP_Actor__Viewshed::FindNearestHiddenPointIndex(FVector Location, float MaxSearchDistance) const
+{
+    double BestDistanceSquared = TNumericLimits<double>::Max();
+    return SpatialIndex.HiddenGrid.FindNearest(Location, MaxSearchDistance, BestDistanceSquared);
+}
+
+/**
+ * Find the K closest results, merging both grids when no visibility filter is applied
+ */
+TArray<int32> ACPP_Actor__Viewshed::FindNearestPointIndices(FVector Location, int32 Count, E__ViewShedPointFilter Filter, float MaxSearchDistance) const
+{
+    TArray<int32> Indices;
+    if (Count <= 0)
+    {
+        return Indices;
+    }
+
+    // Candidates stay sorted by squared distance so both grids can contribute to one list
+    TArray<TPair<double, int32>> Candidates;
+    Candidates.Reserve(Count + 1);
+    if (Filter != E__ViewShedPointFilter::Hidden)
+    {
+        SpatialIndex.VisibleGrid.FindKNearest(Location, Count, MaxSearchDistance, Candidates);
+    }
+    if (Filter != E__ViewShedPointFilter::Visible)
+    {
+        SpatialIndex.HiddenGrid.FindKNearest(Location, Count, MaxSearchDistance, Candidates);
+    }
+
+    Indices.Reserve(Candidates.Num());
+    for (const TPair<double, int32> &Candidate : Candidates)
+    {
+        Indices.Add(Candidate.Value);
+    }
+    return Indices;
+}
+
+/**
+ * Find all results within a radius using the spatial index
+ */
+TArray<int32> ACPP_Actor__Viewshed::FindPointIndicesInRadius(FVector Location, float Radius, E__ViewShedPointFilter Filter) const
+{
+    TArray<int32> Indices;
+    if (Filter != E__ViewShedPointFilter::Hidden)
+    {
+        SpatialIndex.VisibleGrid.FindInRadius(Location, Radius, Indices);
+    }
+    if (Filter != E__ViewShedPointFilter::Visible)
+    {
+        SpatialIndex.HiddenGrid.FindInRadius(Location, Radius, Indices);
+    }
+    return Indices;
+}
+
+/**
+ * Find all results inside an axis-aligned box using the spatial index
+ */
+TArray<int32> ACPP_Actor__Viewshed::FindPointIndicesInBox(FVector Center, FVector Extent, E__ViewShedPointFilter Filter) const
+{
+    TArray<int32> Indices;
+    const FBox Box = FBox::BuildAABB(Center, Extent.GetAbs());
+    if (Filter != E__ViewShedPointFilter::Hidden)
+    {
+        SpatialIndex.VisibleGrid.FindInBox(Box, Indices);
+    }
+    if (Filter != E__ViewShedPointFilter::Visible)
+    {
+        SpatialIndex.HiddenGrid.FindInBox(Box, Indices);
+    }
+    return Indices;
+}
+
+/**
+ * Evaluate a fused predicate over the packed result columns
+ */
+TArray<int32> ACPP_Actor__Viewshed::FilterResultIndices(const FS__ViewShedFilterPredicate &Predicate) const
+{
+    TArray<uint32> Mask;
+    ResultColumns.FilterToMask(Predicate, Mask);
+
+    TArray<int32> Indices;
+    FS__ViewShedResultColumns::MaskToIndices(Mask, Indices);
+    return Indices;
+}
+
+/**
+ * Count results matching a fused predicate
+ */
+int32 ACPP_Actor__Viewshed::CountResultsMatching(const FS__ViewShedFilterPredicate &Predicate) const
+{
+    TArray<uint32> Mask;
+    ResultColumns.FilterToMask(Predicate, Mask);
+    return FS__ViewShedResultColumns::CountMask(Mask);
+}
+
+/**
+ * Evaluate a fused predicate and copy only the matching results
+ */
+TArray<FS__ViewShedPoint> ACPP_Actor__Viewshed::FilterResults(const FS__ViewShedFilterPredicate &Predicate) const
+{
+    return MaterializeResults(FilterResultIndices(Predicate));
+}
+
+/**
+ * Copy the results at the given indices
+ */
+TArray<FS__ViewShedPoint> ACPP_Actor__Viewshed::MaterializeResults(const TArray<int32> &Indices) const
+{
+    // Horizon Map mode derives only the selected points
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        TArray<FS__ViewShedPoint> Selected;
+        Selected.Reserve(Indices.Num());
+        FS__ViewShedTracePoint TracePoint;
+        for (const int32 Index : Indices)
+        {
+            if (RayStore.IsValidIndex(Index))
+            {
+                RayStore.GetTracePoint(Index, TracePoint);
+                HorizonMap.DeriveBandPoint(TracePoint, Selected.AddDefaulted_GetRef());
+            }
+        }
+        return Selected;
+    }
+
+    return FS__ViewShedResultColumns::Materialize(AnalysisResults, Indices);
+}
+
+/**
+ * State of the world raster cell containing a location
+ */
+E__ViewShedRasterCellState ACPP_Actor__Viewshed::GetWorldRasterCellState(FVector Location) const
+{
+    const FIntPoint Cell = WorldRaster.WorldToCell(Location);
+    return static_cast<E__ViewShedRasterCellState>(WorldRaster.GetCellState(Cell.X, Cell.Y));
+}
+
+/**
+ * World XY bounds covered by the raster
+ */
+bool ACPP_Actor__Viewshed::GetWorldRasterBounds(FVector2D &OutMin, FVector2D &OutMax) const
+{
+    if (!WorldRaster.IsInitialized())
+    {
+        return false;
+    }
+
+    OutMin = WorldRaster.GetOrigin();
+    OutMax = OutMin + FVector2D(WorldRaster.GetResolution() * WorldRaster.GetCellSize());
+    return true;
+}
+
+/**
+ * Visibility of a world-space XY box using the visibility pyramid
+ */
+float ACPP_Actor__Viewshed::GetRegionVisibility(FVector Center, FVector2D HalfExtent, int32 &VisibleCells, int32 &ObservedCells, int32 &TotalCells) const
+{
+    const FVector2D Center2D(Center.X, Center.Y);
+    const FVector2D SafeExtent = HalfExtent.GetAbs();
+    const FS__ViewShedRegionCounts Counts = VisibilityPyramid.QueryWorldBox(Center2D - SafeExtent, Center2D + SafeExtent);
+
+    VisibleCells = Counts.VisibleCells;
+    ObservedCells = Counts.ObservedCells;
+    TotalCells = Counts.TotalCells;
+    return Counts.GetVisibleFraction();
+}
+
+/**
+ * Hash of every property that shapes the ray lattice
+ */
+uint64 ACPP_Actor__Viewshed::ComputeConfigHash() const
+{
+    // Bump the leading version value whenever GenerateTraceEndpoints changes its layout
+    const float Config[] = {
+        1.0f,
+        MaxDistance,
+        VerticalFOV,
+        HorizontalFOV,
+        ObserverHeight,
+        Horizontal_Sample_Section_Ratio,
+        Vertical_Sample_Section_Ratio,
+        float(DistanceSteps),
+        Maximum_Distance_Between_Samples,
+        float(Minimum_Samples_Per_Section)};
+    const uint64 Hash = CityHash64(reinterpret_cast<const char *>(Config), sizeof(Config));
+    // Non-grid patterns and per-band density change the ray layout; folded in only when used so full-density grid files stay valid
+    const E__ViewShedSamplingPattern Pattern = GetEffectiveSamplingPattern();
+    if (Pattern != E__ViewShedSamplingPattern::Grid)
+    {
+        return CityHash64WithSeed(reinterpret_cast<const char *>(&Pattern), sizeof(Pattern), Hash);
+    }
+    // Band strides only apply to the grid lattice
+    if (bPerBandSampleDensity)
+    {
+        const uint8 PerBandSampleDensity = uint8(bPerBandSampleDensity);
+        return CityHash64WithSeed(reinterpret_cast<const char *>(&PerBandSampleDensity), sizeof(PerBandSampleDensity), Hash);
+    }
+    return Hash;
+}
+
+/**
+ * Write the completed analysis to a versioned binary result file
+ */
+bool ACPP_Actor__Viewshed::SaveAnalysisToFile(const FString &FilePath, bool bIncludeNormals, bool bIncludeActorTable)
+{
+    // Horizon Map mode writes the derived band points so files stay interchangeable between modes
+    TArray<FS__ViewShedPoint> DerivedResults;
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        DeriveResultsFromHorizonMap(DerivedResults);
+    }
+    const TArray<FS__ViewShedPoint> &Results = DerivedResults.IsEmpty() ? AnalysisResults : DerivedResults;
+
+    // Only complete analyses are saved; a partial one would load as final
+    if (bAnalysisInProgress || Results.IsEmpty() || Results.Num() != RayStore.Num())
+    {
+        return false;
+    }
+
+    FS__ViewShedResultFileHeader Header;
+    Header.ConfigHash = ComputeConfigHash();
+    const FVector ObserverLoc = GetObserverLocation();
+    const FQuat ObserverQuat = GetActorQuat();
+    Header.ObserverLocation[0] = ObserverLoc.X;
+    Header.ObserverLocation[1] = ObserverLoc.Y;
+    Header.ObserverLocation[2] = ObserverLoc.Z;
+    Header.ObserverRotation[0] = ObserverQuat.X;
+    Header.ObserverRotation[1] = ObserverQuat.Y;
+    Header.ObserverRotation[2] = ObserverQuat.Z;
+    Header.ObserverRotation[3] = ObserverQuat.W;
+    Header.DistanceBandCount = CachedDistanceBandCount;
+    Header.HorizontalSampleCount = CachedHorizontalSampleCount;
+    Header.VerticalSampleCount = CachedVerticalSampleCount;
+
+    // Distances are stored relative to the shared trace start
+    return FS__ViewShedResultFileView::Write(FilePath, Header, Results, RayStore.Origin, bIncludeNormals, bIncludeActorTable);
+}
+
+/**
+ * Replace the current results with a result file written for this observer
+ */
+bool ACPP_Actor__Viewshed::LoadAnalysisFromFile(const FString &FilePath)
+{
+    if (bAnalysisInProgress)
+    {
+        return false;
+    }
+
+    // The mapping lives only for this call: its sections are decoded once into the result store and then released
+    FS__ViewShedResultFileView File;
+    if (!File.Open(FilePath))
+    {
+        return false;
+    }
+
+    // Reject files produced by other settings or from another position/orientation
+    const FS__ViewShedResultFileHeader &Header = File.GetHeader();
+    const FVector FileLocation(Header.ObserverLocation[0], Header.ObserverLocation[1], Header.ObserverLocation[2]);
+    const FQuat FileRotation(Header.ObserverRotation[0], Header.ObserverRotation[1], Header.ObserverRotation[2], Header.ObserverRotation[3]);
+    const float LocationTolerance = 1.0f;
+    if (Header.ConfigHash != ComputeConfigHash() ||
+        !FileLocation.Equals(GetObserverLocation(), LocationTolerance) ||
+        !FileRotation.Equals(GetActorQuat(), KINDA_SMALL_NUMBER))
+    {
+        return false;
+    }
+
+    // Rebuild the ray lattice; it must match the file ray for ray, and the previous results are gone from here on
+    ClearResults();
+    GenerateTraceEndpoints();
+    if (RayStore.Num() != Header.ResultCount ||
+        CachedDistanceBandCount != Header.DistanceBandCount ||
+        CachedHorizontalSampleCount != Header.HorizontalSampleCount ||
+        CachedVerticalSampleCount != Header.VerticalSampleCount)
+    {
+        ClearResults();
+        return false;
+    }
+
+    InitializeResultsFromTraceQueue();
+
+    // Resolve hit actors once per table entry rather than once per ray
+    TArray<AActor *> HitActors;
+    for (const FString &ActorPath : File.ReadActorTable())
+    {
+        HitActors.Add(Cast<AActor>(FSoftObjectPath(ActorPath).ResolveObject()));
+    }
+
+    // Decode straight from the (mapped) sections; rays are independent
+    const TConstArrayView<float> HitDistances = File.GetHitDistances();
+    const TConstArrayView<uint32> Normals = File.GetPackedNormals();
+    const TConstArrayView<uint16> ActorIndices = File.GetActorIndices();
+    ParallelFor(AnalysisResults.Num(), [&](int32 i)
+                {
+                    FS__ViewShedPoint &Point = AnalysisResults[i];
+
+                    Point.bIsVisible = File.IsVisible(i);
+                    Point.HitLocation = RayStore.Origin + RayStore.GetDirection(i) * HitDistances[i];
+                    if (!Normals.IsEmpty())
+                    {
+                        Point.HitNormal = FS__ViewShedResultFileView::DecodeNormal(Normals[i]);
+                    }
+                    if (!ActorIndices.IsEmpty() && HitActors.IsValidIndex(ActorIndices[i]))
+                    {
+                        Point.HitActor = HitActors[ActorIndices[i]];
+                    } });
+
+    InitializeWorldRaster();
+    CurrentTraceIndex = RayStore.Num();
+    // Horizon Map mode keeps only the collapsed form; FinalizeAnalysis splats and indexes it like a traced one
+    if (ResultMode == E__ViewShedResultMode::HorizonMap)
+    {
+        HorizonMap.Build(GetHorizonLattice(), AnalysisResults, RayStore, bHorizonMap_HalfPrecision, bHorizonMap_StoreNormals);
+        AnalysisResults.Empty();
+    }
+    else if (bEnableWorldRaster)
+    {
+        WorldRaster.SplatAllParallel(AnalysisResults, bWorldRaster_SurfaceHitsOnly);
+    }
+    FinalizeAnalysis();
+    return true;
+}
+
+/**
+ * Get the current analysis results
+ */
+TArray<FS__ViewShedPoint> ACPP_Actor__Viewshed::GetAnalysisResults() const
+{
+    if (AnalysisResults.IsEmpty() && HorizonMap.IsBuilt())
+    {
+        TArray<FS__ViewShedPoint> DerivedResults;
+        DeriveResultsFromHorizonMap(DerivedResults);
+        return DerivedResults;
+    }
+    return AnalysisResults;
+}
+
+/**
+ * Number of results, whether stored or derived
+ */
+int32 ACPP_Actor__Viewshed::GetAnalysisResultCount() const
+{
+    return AnalysisResults.IsEmpty() && HorizonMap.IsBuilt() ? RayStore.Num() : AnalysisResults.Num();
+}
+
+/**
+ * First-occluder distances as a texture-shaped grid
+ */
+bool ACPP_Actor__Viewshed::GetHorizonDistances(TArray<float> &OutDistances, int32 &OutWidth, int32 &OutHeight) const
+{
+    OutDistances.Reset();
+    OutWidth = 0;
+    OutHeight = 0;
+
+    if (!HorizonMap.IsBuilt())
+    {
+        return false;
+    }
+
+    OutWidth = HorizonMap.Lattice.HorizontalSampleCount;
+    OutHeight = HorizonMap.Lattice.VerticalSampleCount;
+    OutDistances.SetNumUninitialized(HorizonMap.Lattice.Num());
+    for (int32 i = 0; i < OutDistances.Num(); ++i)
+    {
+        const float Distance = HorizonMap.GetOccluderDistance(i);
+        OutDistances[i] = Distance == FS__ViewShedHorizonMap::Unoccluded ? -1.0f : Distance;
+    }
+    return true;
 }
@@ -13,6 +13,18 @@
 #include "DrawDebugHelpers.h"
 #include "ProceduralMeshComponent.h"
 #include "Components/DecalComponent.h"
+#include "Components/LineBatchComponent.h"
+#include "Async/Future.h"
+#include "CPP_Struct__ViewshedSpatialIndex.h"
+#include "CPP_Struct__ViewshedResultColumns.h"
+#include "CPP_Struct__ViewshedWorldRaster.h"
+#include "CPP_Struct__ViewshedVisibilityPyramid.h"
+#include "CPP_Struct__ViewshedHorizonMap.h"
+#include "CPP_Struct__ViewshedStreamFile.h"
+#include "CPP_Struct__ViewshedBlanketMesh.h"
+#include "CPP_Struct__ViewshedDirectionTable.h"
+#include "CPP_Struct__ViewshedRayStore.h"
+#include "CPP_Struct__ViewshedSamplingPattern.h"
 #include "CPP_Actor__ViewShed.generated.h"
 
 /**
@@ -110,60 +122,116 @@ struct P_VIEWSHEDANALYSIS_API FS__ViewShedTracePoint
 };
 
 /**
- * Structure Containing Trace End Points
+ * Visibility filter applied by the indexed result queries
  */
-USTRUCT(BlueprintType)
-struct P_VIEWSHEDANALYSIS_API FS__ViewShedTraceEndPoints
+UENUM(BlueprintType)
+enum class E__ViewShedPointFilter : uint8
 {
-    GENERATED_BODY()
+    /** Consider visible and hidden points */
+    Any UMETA(DisplayName = "Any"),
+    /** Consider only visible points */
+    Visible UMETA(DisplayName = "Visible"),
+    /** Consider only hidden/occluded points */
+    Hidden UMETA(DisplayName = "Hidden")
+};
 
-    /** Trace Start and End Point */
-    UPROPERTY(BlueprintReadOnly, Category = "ViewShed Trace End Point")
-    TArray<FS__ViewShedTracePoint> TraceEndPoints;
+/**
+ * State of a world raster cell
+ */
+UENUM(BlueprintType)
+enum class E__ViewShedRasterCellState : uint8
+{
+    /** No sample landed in this cell */
+    Unobserved = 0 UMETA(DisplayName = "Unobserved"),
+    /** Only visible samples landed in this cell */
+    Visible = 1 UMETA(DisplayName = "Visible"),
+    /** Only hidden samples landed in this cell */
+    Hidden = 2 UMETA(DisplayName = "Hidden"),
+    /** Both visible and hidden samples landed in this cell */
+    Mixed = 3 UMETA(DisplayName = "Mixed")
+};
 
-    /** Number of samples along the horizontal axis within this slice */
-    UPROPERTY(BlueprintReadOnly, Category = "ViewShed Trace End Point")
-    int32 HorizontalSampleCount;
+/**
+ * How an analysis stores its results
+ */
+UENUM(BlueprintType)
+enum class E__ViewShedResultMode : uint8
+{
+    /** One FS__ViewShedPoint per trace in every distance band */
+    BandPoints UMETA(DisplayName = "Band Points"),
+    /** One first-occluder distance per direction; band points are derived on demand */
+    HorizonMap UMETA(DisplayName = "Horizon Map"),
+    /** Results are written chunk by chunk to a compressed stream file; only the current chunk is held in memory */
+    Streamed UMETA(DisplayName = "Streamed To Disk")
+};
 
-    /** Number of samples along the vertical axis within this slice */
-    UPROPERTY(BlueprintReadOnly, Category = "ViewShed Trace End Point")
-    int32 VerticalSampleCount;
+/**
+ * Geometry used for the visible blanket
+ */
+UENUM(BlueprintType)
+enum class E__ViewShedBlanketMode : uint8
+{
+    /** One double-sided quad per surface hit */
+    Quads UMETA(DisplayName = "Per-Sample Quads"),
+    /** One shared vertex per surface hit, connected across the H/V sample lattice where hit distances are continuous */
+    Grid UMETA(DisplayName = "Shared-Vertex Grid"),
+    /** One quad per lattice rectangle of samples sharing a visibility state and a near-coplanar surface */
+    Merged UMETA(DisplayName = "Greedy Merged Quads")
+};
 
-    /** Default constructor - initializes all values to safe defaults */
-    FS__ViewShedTraceEndPoints()
-    {
-        TraceEndPoints.Empty();
-        HorizontalSampleCount = 0;
-        VerticalSampleCount = 0;
-    }
+/**
+ * How ray directions are spread over the field of view
+ */
+UENUM(BlueprintType)
+enum class E__ViewShedSamplingPattern : uint8
+{
+    /** Uniform yaw/pitch lattice; rays crowd together towards the top and bottom of the frustum */
+    Grid UMETA(DisplayName = "Grid"),
+    /** Spherical Fibonacci lattice: near-hexagonal, equal-area spacing without rows */
+    Fibonacci UMETA(DisplayName = "Fibonacci"),
+    /** Iso-latitude rings of equal-area cells, offset every other ring */
+    EqualArea UMETA(DisplayName = "Equal Area (HEALPix-style)"),
+    /** Equal-area rings jittered within their cells; trades regular spacing for freedom from aliasing */
+    BlueNoise UMETA(DisplayName = "Stratified Blue Noise")
 };
 
 /**
- * Structure Containing Trace End Points
+ * Fused predicate evaluated by the columnar result filter kernels in a single pass
+ * Example: Visibility = Visible, distance range 1000..3000, BandIndex = 2
  */
 USTRUCT(BlueprintType)
-struct P_VIEWSHEDANALYSIS_API FS__ViewShedTraceSection
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedFilterPredicate
 {
     GENERATED_BODY()
 
-    /** Trace Start and End Points */
-    UPROPERTY(BlueprintReadOnly, Category = "ViewShed Trace End Point")
-    TArray<FS__ViewShedTraceEndPoints> TraceSections;
+    /** Visibility state a result must have to pass */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ViewShed Filter")
+    E__ViewShedPointFilter Visibility;
 
-    /** Number of horizontal sub-sections that partition this distance layer */
-    UPROPERTY(BlueprintReadOnly, Category = "ViewShed Trace End Point")
-    int32 HorizontalSectionCount;
+    /** Whether the distance range below is applied */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ViewShed Filter")
+    bool bFilterByDistance;
 
-    /** Number of vertical sub-sections that partition this distance layer */
-    UPROPERTY(BlueprintReadOnly, Category = "ViewShed Trace End Point")
-    int32 VerticalSectionCount;
+    /** Minimum sample distance (inclusive) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ViewShed Filter", meta = (EditCondition = "bFilterByDistance"))
+    float MinDistance;
 
-    /** Default constructor - initializes all values to safe defaults */
-    FS__ViewShedTraceSection()
+    /** Maximum sample distance (inclusive) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ViewShed Filter", meta = (EditCondition = "bFilterByDistance"))
+    float MaxDistance;
+
+    /** Distance band a result must belong to (-1 accepts every band) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ViewShed Filter", meta = (ClampMin = "-1"))
+    int32 BandIndex;
+
+    /** Default constructor - accepts every result */
+    FS__ViewShedFilterPredicate()
     {
-        TraceSections.Empty();
-        HorizontalSectionCount = 0;
-        VerticalSectionCount = 0;
+        Visibility = E__ViewShedPointFilter::Any; // Any visibility state
+        bFilterByDistance = false;                // No distance range
+        MinDistance = 0.0f;                       // Range start
+        MaxDistance = 0.0f;                       // Range end
+        BandIndex = INDEX_NONE;                   // Any band
     }
 };
 
@@ -191,10 +259,47 @@ protected:
     /** Called when the game starts or when spawned */
     virtual void BeginPlay() override;
 
+    /** Called when the actor leaves play */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Keeps visualization components unregistered in analysis-only mode */
+    virtual void PreRegisterAllComponents() override;
+
 public:
     /** Called every frame to update analysis if needed */
     virtual void Tick(float DeltaTime) override;
 
+    //////////////////////////////////////////////////////////////////////////
+    // SIGNIFICANCE
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Apply an evaluated significance (0-1): scales update rate, trace budget and visualization, and sleeps or wakes the tick */
+    void SetSignificance(float InSignificance);
+
+    /** Last significance applied (1 when significance is not used) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Significance")
+    float GetSignificance() const { return CurrentSignificance; }
+
+    /** Resume ticking at full significance until the next evaluation (e.g. from a gameplay event) */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Significance")
+    void WakeObserver();
+
+    /** Change the Gameplay Relevance and have the observer re-rated at the next evaluation */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Significance")
+    void SetGameplayRelevance(float InRelevance);
+
+    /** Whether the observer is insignificant and has no analysis or blanket build left to finish */
+    bool ShouldSleep() const;
+
+    /** Update interval after significance scaling */
+    float GetEffectiveUpdateInterval() const;
+
+    /** Traces per frame after significance scaling */
+    int32 GetEffectiveTraceBudget() const;
+
+    /** Whether visualization is drawn at the current significance */
+    bool IsVisualizationSignificant() const;
+
     //////////////////////////////////////////////////////////////////////////
     // CORE VIEWSHED PROPERTIES
     //////////////////////////////////////////////////////////////////////////
@@ -267,6 +372,23 @@ public:
               meta = (DisplayName = "Samples Per Section", ClampMin = "1", UIMax = "5000"))
     int32 Minimum_Samples_Per_Section = 500;
 
+    /** Choose the angular resolution of each nearer distance band so its on-surface spacing stays near Maximum Distance Between Samples.
+     *  The farthest band always samples the full lattice; nearer bands keep every 2nd, 4th, ... column and row of it, so every
+     *  sample keeps its lattice index. Streamed analyses always sample every band at full density.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling Resolution",
+              meta = (DisplayName = "Per-Band Sample Density"))
+    bool bPerBandSampleDensity = false;
+
+    /** How ray directions are spread over the field of view.
+     *  Non-grid patterns keep the grid's angular spacing but spend it by solid angle, so wide vertical FOVs need
+     *  noticeably fewer rays. They are meshed by triangulation, ignore Per-Band Sample Density and Greedy Merged Quads,
+     *  and do not feed the horizon occluder texture; Streamed analyses always use the grid.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sampling Resolution",
+              meta = (DisplayName = "Sampling Pattern"))
+    E__ViewShedSamplingPattern SamplingPattern = E__ViewShedSamplingPattern::Grid;
+
     //////////////////////////////////////////////////////////////////////////
     // VISUALIZATION PROPERTIES
     //////////////////////////////////////////////////////////////////////////
@@ -281,6 +403,34 @@ public:
               meta = (DisplayName = "Hidden Material"))
     UMaterialInterface *HiddenMaterial;
 
+    /** Whether to build the procedural blanket over visible hit locations (its component exists only while enabled) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visualization",
+              meta = (DisplayName = "Show Visible Blanket"))
+    bool bShowVisibleVisualization = true;
+
+    /** Blanket geometry; the grid shares vertices between lattice neighbours and relies on a two-sided material */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visualization",
+              meta = (DisplayName = "Visible Blanket Mode"))
+    E__ViewShedBlanketMode VisibleVisualization_MeshMode = E__ViewShedBlanketMode::Quads;
+
+    /** Grid mode: largest hit distance spread a triangle may bridge, as a fraction of its nearest corner's distance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visualization",
+              meta = (DisplayName = "Visible Blanket Grid Continuity", ClampMin = "0.0", UIMax = "1.0",
+                      EditCondition = "VisibleVisualization_MeshMode == E__ViewShedBlanketMode::Grid"))
+    float VisibleVisualization_GridContinuity = 0.1f;
+
+    /** Merged mode: largest normal and plane deviation (degrees) merged into one quad in the nearest band */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visualization",
+              meta = (DisplayName = "Visible Blanket Merge Tolerance", ClampMin = "0.0", ClampMax = "45.0",
+                      EditCondition = "VisibleVisualization_MeshMode == E__ViewShedBlanketMode::Merged"))
+    float VisibleVisualization_MergeToleranceDegrees = 2.0f;
+
+    /** Merged mode: fractional tolerance increase per distance band, so far bands merge more aggressively */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visualization",
+              meta = (DisplayName = "Visible Blanket Merge Band Growth", ClampMin = "0.0", UIMax = "2.0",
+                      EditCondition = "VisibleVisualization_MeshMode == E__ViewShedBlanketMode::Merged"))
+    float VisibleVisualization_MergeBandGrowth = 0.5f;
+
     /** Height offset applied to the procedural blanket that visualises visible areas */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visualization",
               meta = (DisplayName = "Visible Blanket Offset", ClampMin = "0.0", UIMax = "50.0"))
@@ -310,11 +460,168 @@ public:
               meta = (DisplayName = "Update Interval", ClampMin = "0.1", UIMax = "10.0"))
     float UpdateInterval = 2.0f;
 
+    /**
+     * Run only the analysis core: no visualization components, asset loads, decal updates, mesh builds or raster texture
+     * Always in effect on dedicated servers and processes without rendering (-nullrhi)
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Analysis Control",
+              meta = (DisplayName = "Analysis Only"))
+    bool bAnalysisOnly = false;
+
     /** Maximum number of traces to process per frame (for performance) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance",
               meta = (DisplayName = "Max Traces Per Frame", ClampMin = "10", UIMax = "500"))
     int32 MaxTracesPerFrame = 50;
 
+    //////////////////////////////////////////////////////////////////////////
+    // SIGNIFICANCE PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Let the world's significance subsystem scale this observer's update interval, trace budget and visualization
+     * with viewer distance, on-screen presence and Gameplay Relevance; insignificant observers stop ticking
+     * Read on BeginPlay
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance",
+              meta = (DisplayName = "Use Significance"))
+    bool bUseSignificance = false;
+
+    /** Gameplay weight multiplied into the evaluated significance (0 = never significant, >1 = favoured); change at runtime through SetGameplayRelevance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetGameplayRelevance, Category = "Significance",
+              meta = (DisplayName = "Gameplay Relevance", ClampMin = "0.0", UIMax = "4.0", EditCondition = "bUseSignificance"))
+    float Significance_GameplayRelevance = 1.0f;
+
+    /** Update interval multiplier at zero significance (full significance uses Update Interval as is) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance",
+              meta = (DisplayName = "Max Interval Scale", ClampMin = "1.0", UIMax = "32.0", EditCondition = "bUseSignificance"))
+    float Significance_MaxIntervalScale = 8.0f;
+
+    /** Fraction of Max Traces Per Frame spent at zero significance */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance",
+              meta = (DisplayName = "Min Trace Budget Scale", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseSignificance"))
+    float Significance_MinTraceBudgetScale = 0.1f;
+
+    /** Below this significance the decal and debug pyramid are hidden and not updated */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance",
+              meta = (DisplayName = "Visualization Threshold", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseSignificance"))
+    float Significance_VisualizationThreshold = 0.25f;
+
+    /** At or below this significance the observer stops ticking once its current analysis is done */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance",
+              meta = (DisplayName = "Sleep Threshold", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseSignificance"))
+    float Significance_SleepThreshold = 0.05f;
+
+    //////////////////////////////////////////////////////////////////////////
+    // RESULT STORAGE PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Storage for completed analyses
+     * Horizon Map traces only the far band (one ray per direction) and keeps one distance per direction,
+     * cutting result memory and trace count by the number of distance steps; band points are derived when read.
+     * Streamed To Disk writes every result to a chunked, compressed file instead of keeping it in memory, for
+     * analyses too large to hold; queries, indices and visualization then stay empty, the world raster is still filled
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Storage",
+              meta = (DisplayName = "Result Mode"))
+    E__ViewShedResultMode ResultMode = E__ViewShedResultMode::BandPoints;
+
+    /** Store horizon distances as float16 instead of float32 (coarser at long range); Max Distance beyond 65504 always uses float32 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Storage",
+              meta = (DisplayName = "Half Precision Distances", EditCondition = "ResultMode == E__ViewShedResultMode::HorizonMap"))
+    bool bHorizonMap_HalfPrecision = false;
+
+    /** Keep the surface normal of each first occluder in the horizon map */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Storage",
+              meta = (DisplayName = "Store Normals", EditCondition = "ResultMode == E__ViewShedResultMode::HorizonMap"))
+    bool bHorizonMap_StoreNormals = true;
+
+    /**
+     * Chunked file streamed analyses are written to (relative paths are resolved against the project directory)
+     * Read it back with FS__ViewShedStreamFileView, which decompresses chunks individually on demand
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Storage",
+              meta = (DisplayName = "Stream Output File", FilePathFilter = "vsst", EditCondition = "ResultMode == E__ViewShedResultMode::Streamed"))
+    FFilePath StreamOutputFile;
+
+    /** Rays per compressed chunk; bounds the results held in memory by Run Analysis Immediate */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Storage",
+              meta = (DisplayName = "Rays Per Chunk", ClampMin = "1024", ClampMax = "16777216", EditCondition = "ResultMode == E__ViewShedResultMode::Streamed"))
+    int32 StreamRaysPerChunk = 262144;
+
+    /** Store an octahedron-encoded hit normal per ray in the stream file */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Storage",
+              meta = (DisplayName = "Stream Normals", EditCondition = "ResultMode == E__ViewShedResultMode::Streamed"))
+    bool bStream_StoreNormals = false;
+
+    //////////////////////////////////////////////////////////////////////////
+    // RESULT QUERY PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Build a spatial index over hit locations when an analysis completes (used by the Find*Index queries).
+     *  Horizon Map analyses index one visible and one hidden sample per direction: the farthest visible and the first occluded band sample.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Queries",
+              meta = (DisplayName = "Build Spatial Index"))
+    bool bBuildSpatialIndex = true;
+
+    /** Average number of points per spatial index cell; lower values trade memory for faster queries */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result Queries",
+              meta = (DisplayName = "Spatial Index Points Per Cell", ClampMin = "1", UIMax = "32"))
+    int32 SpatialIndex_TargetPointsPerCell = 4;
+
+    //////////////////////////////////////////////////////////////////////////
+    // WORLD RASTER PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Rasterize results into a world-aligned XY grid as traces complete (for minimaps and export) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Raster",
+              meta = (DisplayName = "Enable World Raster"))
+    bool bEnableWorldRaster = false;
+
+    /** World size of one raster cell (in Unreal units) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Raster",
+              meta = (DisplayName = "Cell Size", ClampMin = "1.0", UIMax = "1000.0", EditCondition = "bEnableWorldRaster"))
+    float WorldRaster_CellSize = 100.0f;
+
+    /** Cells per side of the raster (rounded up to a multiple of 64), centred on the observer */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Raster",
+              meta = (DisplayName = "Resolution", ClampMin = "64", ClampMax = "16384", UIMax = "2048", EditCondition = "bEnableWorldRaster"))
+    int32 WorldRaster_Resolution = 512;
+
+    /** Only rasterize samples that reached a surface; mid-air visible samples say nothing about the ground */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Raster",
+              meta = (DisplayName = "Surface Hits Only", EditCondition = "bEnableWorldRaster"))
+    bool bWorldRaster_SurfaceHitsOnly = true;
+
+    /** Also fill a transient BGRA8 texture from the raster when an analysis completes */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Raster",
+              meta = (DisplayName = "Create Texture", EditCondition = "bEnableWorldRaster"))
+    bool bWorldRaster_CreateTexture = false;
+
+    /** Build summed-area tables and a mip chain over the raster on completion for O(1) region coverage queries */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Raster",
+              meta = (DisplayName = "Build Visibility Pyramid", EditCondition = "bEnableWorldRaster"))
+    bool bWorldRaster_BuildVisibilityPyramid = true;
+
+    //////////////////////////////////////////////////////////////////////////
+    // EXPLORATION PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /** OR each completed analysis into the world's persistent exploration (fog-of-war) map */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Exploration",
+              meta = (DisplayName = "Contribute To Exploration"))
+    bool bContributeToExploration = false;
+
+    //////////////////////////////////////////////////////////////////////////
+    // RESULT FILE PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Result file loaded on BeginPlay instead of tracing (ignored if missing or made with different settings or transform) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Result File",
+              meta = (DisplayName = "Precomputed Results File", FilePathFilter = "vshr"))
+    FFilePath PrecomputedResultsFile;
+
     //////////////////////////////////////////////////////////////////////////
     // HIDDEN VISUALIZATION DECAL MATERIAL PARAMETERS
     //////////////////////////////////////////////////////////////////////////
@@ -358,6 +665,31 @@ public:
               meta = (DisplayName = "Opacity Multiplier", ClampMin = "0.0", ClampMax = "1.0"))
     float VS_Opacity = 0.6f;
 
+    /** Write frustum parameters into the world's shared parameter texture (one row per observer, one upload per frame) instead of this MID */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hidden Decal|Material",
+              meta = (DisplayName = "Share Frustum Parameters"))
+    bool bVS_UseSharedParameters = false;
+
+    /** Pack per-direction first-occluder distances into VS_OccluderTexture so the decal shades true visibility (ViewshedMaskOccluded) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hidden Decal|Occlusion",
+              meta = (DisplayName = "Use Occlusion Texture"))
+    bool bVS_UseOcclusionTexture = false;
+
+    /** Distance a surface may lie behind its direction's first occluder and still count as visible (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hidden Decal|Occlusion",
+              meta = (DisplayName = "Occlusion Tolerance", ClampMin = "0.0", UIMax = "500.0", EditCondition = "bVS_UseOcclusionTexture"))
+    float VS_OcclusionTolerance = 25.0f;
+
+    /** Distance over which visibility fades to hidden behind the tolerance (cm) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hidden Decal|Occlusion",
+              meta = (DisplayName = "Occlusion Feather", ClampMin = "0.0", UIMax = "1000.0", EditCondition = "bVS_UseOcclusionTexture"))
+    float VS_OcclusionFeather = 100.0f;
+
+    /** Color of visible surfaces inside the viewshed when occlusion is shaded */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hidden Decal|Occlusion",
+              meta = (DisplayName = "Color Visible", EditCondition = "bVS_UseOcclusionTexture"))
+    FLinearColor VS_ColorVisible = FLinearColor(0.f, 1.f, 0.f, 1.f);
+
     //////////////////////////////////////////////////////////////////////////
     // DEBUG PROPERTIES
     //////////////////////////////////////////////////////////////////////////
@@ -375,11 +707,34 @@ public:
               meta = (DisplayName = "Visible Point Mesh"))
     UStaticMesh *Debug_VisiblePointMesh;
 
+    /**
+     * Optional material for a single point component serving both states; it reads PerInstanceCustomData[0]
+     * (1 = visible, 0 = hidden). When unset, visible and hidden points use separate components and materials.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Combined Point Material"))
+    UMaterialInterface *Debug_CombinedPointMaterial = nullptr;
+
     /** Scale multiplier for visualization points */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
               meta = (DisplayName = "Point Scale", ClampMin = "0.1", UIMax = "5.0"))
     float Debug_PointScale = 1.0f;
 
+    /** Merged debug mesh: first distance band drawn with reduced markers (tetrahedra instead of octahedra, decimated) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Marker LOD Start Band", ClampMin = "0", EditCondition = "bDebug_UseProceduralMesh"))
+    int32 Debug_MarkerLODStartBand = 2;
+
+    /** Merged debug mesh: far bands keep every Nth lattice row and column */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Far Band Marker Stride", ClampMin = "1", UIMax = "8", EditCondition = "bDebug_UseProceduralMesh"))
+    int32 Debug_MarkerFarStride = 2;
+
+    /** Merged debug mesh: upper bound on markers; larger results are decimated uniformly to fit */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Max Markers", ClampMin = "1000", EditCondition = "bDebug_UseProceduralMesh"))
+    int32 Debug_MaxMarkers = 100000;
+
     /** Whether to show visible points */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
               meta = (DisplayName = "Show Visible Points"))
@@ -400,6 +755,21 @@ public:
               meta = (DisplayName = "Debug Line Duration", ClampMin = "0.1", UIMax = "30.0"))
     float bDebug_LineDuration = 5.0f;
 
+    /** Collect each frame's debug lines and submit them to the world line batcher in one call instead of one draw per trace */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Batch Debug Lines", EditCondition = "bDebug_ShowLines"))
+    bool bDebug_BatchLines = true;
+
+    /** Draw lines only for every Nth horizontal and vertical lattice sample */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Debug Line Stride", ClampMin = "1", UIMax = "16", EditCondition = "bDebug_ShowLines"))
+    int32 Debug_LineStride = 1;
+
+    /** Draw lines only for this distance band (-1 = all bands) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
+              meta = (DisplayName = "Debug Line Band", ClampMin = "-1", EditCondition = "bDebug_ShowLines"))
+    int32 Debug_LineBand = -1;
+
     /** Whether to show the viewshed pyramid bounds */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization",
               meta = (DisplayName = "Show Pyramid Bounds"))
@@ -429,9 +799,78 @@ public:
     UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis")
     void ClearResults();
 
-    /** Get the current analysis results */
+    /**
+     * Run a complete analysis in one call, tracing every ray in parallel, then finalize as usual
+     * Stalls the calling frame for the whole trace pass; meant for tools, loading screens and bakes
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis")
+    void RunAnalysisImmediate();
+
+    /**
+     * Regenerate the rays for the current transform and trace all of them in parallel
+     * Leaves the results unfinalized (no indices, raster or visualization), for batch tools such as the bake commandlet
+     * @return False if an analysis is already running or no rays were produced
+     */
+    bool TraceAllImmediate();
+
+    /** Angular lattice of the current ray layout (valid once endpoints have been generated) */
+    FS__ViewShedHorizonLattice GetHorizonLattice() const;
+
+    /** Collapse the current results into one first-occluder distance per lattice direction (copies it in Horizon Map mode) */
+    void BuildHorizonMap(FS__ViewShedHorizonMap &OutHorizon) const;
+
+    /** Horizon map of the last analysis in Horizon Map mode (empty otherwise) */
+    const FS__ViewShedHorizonMap &GetHorizonMap() const { return HorizonMap; }
+
+    /**
+     * First-occluder distances as a texture-shaped grid (Width = horizontal samples, one row per vertical sample index)
+     * Clear directions report a negative distance
+     * @return False if no horizon map is available
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Horizon Map")
+    bool GetHorizonDistances(TArray<float> &OutDistances, int32 &OutWidth, int32 &OutHeight) const;
+
+    /** Absolute path of the stream output file (empty if none is set) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Result File")
+    FString GetStreamOutputPath() const;
+
+    /**
+     * Rebuild the visualization from the current results, creating or destroying components to match the flags
+     * Horizon Map results are derived for the rebuild; Streamed analyses keep their current visualization
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis")
+    void RefreshVisualization();
+
+    /** Whether visualization is skipped for this observer (Analysis Only or a headless process) */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
-    TArray<FS__ViewShedPoint> GetAnalysisResults() const { return AnalysisResults; }
+    bool IsAnalysisOnly() const;
+
+    /** Whether this process can never present visualization (dedicated server or no rendering) */
+    static bool IsHeadlessProcess();
+
+    /** Rays of the current analysis, matching the analysis results index for index */
+    const FS__ViewShedRayStore &GetRayStore() const { return RayStore; }
+
+    /** Get the current analysis results (derived from the horizon map in Horizon Map mode) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
+    TArray<FS__ViewShedPoint> GetAnalysisResults() const;
+
+    /**
+     * Non-copying view of the stored band results for native consumers
+     * Empty in Horizon Map mode outside of completion callbacks; use GetAnalysisResultAt or GetHorizonMap there
+     */
+    TConstArrayView<FS__ViewShedPoint> GetAnalysisResultsView() const { return AnalysisResults; }
+
+    /** Visit every result, stored or derived; Horizon Map results are derived and visited one distance band at a time */
+    void ForEachResultBatch(TFunctionRef<void(TConstArrayView<FS__ViewShedPoint>)> Visit) const;
+
+    /** Number of results (one per trace of every band), whether stored or derived */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
+    int32 GetAnalysisResultCount() const;
+
+    /** Get a single analysis result by index without copying the whole result array */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
+    bool GetAnalysisResultAt(int32 Index, FS__ViewShedPoint &OutPoint) const;
 
     /** Get number of visible points in current analysis */
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
@@ -445,6 +884,131 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
     float GetVisibilityPercentage() const;
 
+    //////////////////////////////////////////////////////////////////////////
+    // INDEXED RESULT QUERIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Find the visible result whose hit location is closest to Location
+     * @param MaxSearchDistance - Search radius limit (<= 0 means unlimited)
+     * @return Index into the analysis results, or -1 if none was found
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Queries")
+    int32 FindNearestVisiblePointIndex(FVector Location, float MaxSearchDistance = 0.0f) const;
+
+    /**
+     * Find the hidden result whose hit location is closest to Location
+     * @param MaxSearchDistance - Search radius limit (<= 0 means unlimited)
+     * @return Index into the analysis results, or -1 if none was found
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Queries")
+    int32 FindNearestHiddenPointIndex(FVector Location, float MaxSearchDistance = 0.0f) const;
+
+    /**
+     * Find up to Count results closest to Location, sorted by ascending distance
+     * @return Indices into the analysis results
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Queries")
+    TArray<int32> FindNearestPointIndices(FVector Location, int32 Count, E__ViewShedPointFilter Filter, float MaxSearchDistance = 0.0f) const;
+
+    /**
+     * Find all results whose hit location lies within Radius of Location
+     * @return Indices into the analysis results (unordered)
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Queries")
+    TArray<int32> FindPointIndicesInRadius(FVector Location, float Radius, E__ViewShedPointFilter Filter) const;
+
+    /**
+     * Find all results whose hit location lies inside the axis-aligned box (Center +/- Extent)
+     * @return Indices into the analysis results (unordered)
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Queries")
+    TArray<int32> FindPointIndicesInBox(FVector Center, FVector Extent, E__ViewShedPointFilter Filter) const;
+
+    /**
+     * Evaluate a fused predicate over the packed result columns in one pass
+     * @return Ascending indices into the analysis results
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Queries")
+    TArray<int32> FilterResultIndices(const FS__ViewShedFilterPredicate &Predicate) const;
+
+    /** Count results matching a fused predicate without producing indices or copies */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Queries")
+    int32 CountResultsMatching(const FS__ViewShedFilterPredicate &Predicate) const;
+
+    /** Evaluate a fused predicate and copy only the matching results */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Queries")
+    TArray<FS__ViewShedPoint> FilterResults(const FS__ViewShedFilterPredicate &Predicate) const;
+
+    /** Copy the results at the given indices (as returned by the indexed and filter queries) */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Queries")
+    TArray<FS__ViewShedPoint> MaterializeResults(const TArray<int32> &Indices) const;
+
+    /** State of the world raster cell containing Location (Unobserved if outside the raster) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|World Raster")
+    E__ViewShedRasterCellState GetWorldRasterCellState(FVector Location) const;
+
+    /** World XY bounds covered by the raster; false if the raster has not been initialized */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|World Raster")
+    bool GetWorldRasterBounds(FVector2D &OutMin, FVector2D &OutMax) const;
+
+    /** Texture filled from the raster (null unless bWorldRaster_CreateTexture is set) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|World Raster")
+    UTexture2D *GetWorldRasterTexture() const { return WorldRasterTexture; }
+
+    /** First-occluder distance per lattice direction (R32F), bound to the decal as VS_OccluderTexture; null unless bVS_UseOcclusionTexture is set */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Hidden Decal")
+    UTexture2D *GetHorizonOccluderTexture() const { return HorizonOccluderTexture; }
+
+    /** Re-rasterize all current results in parallel tiles (e.g. after changing cell size) and refresh the texture */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|World Raster")
+    void RebuildWorldRaster();
+
+    /**
+     * Visibility of a world-space XY box in O(1) using the visibility pyramid
+     * @param Center - Box centre (Z is ignored)
+     * @param HalfExtent - Box half size along X and Y
+     * @param VisibleCells - Raster cells inside the box with visible samples
+     * @param ObservedCells - Raster cells inside the box with any sample
+     * @param TotalCells - Raster cells covered by the box
+     * @return Fraction (0-1) of observed cells that are visible
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|World Raster")
+    float GetRegionVisibility(FVector Center, FVector2D HalfExtent, int32 &VisibleCells, int32 &ObservedCells, int32 &TotalCells) const;
+
+    /** Summed-area tables and mip chain over the world raster for native consumers */
+    const FS__ViewShedVisibilityPyramid &GetVisibilityPyramid() const { return VisibilityPyramid; }
+
+    /** Raw raster for native consumers (two bits per cell, sixteen cells per word) */
+    const FS__ViewShedWorldRaster &GetWorldRaster() const { return WorldRaster; }
+
+    /** Packed result columns for native consumers that compose their own masks (packed from the horizon map in Horizon Map mode) */
+    const FS__ViewShedResultColumns &GetResultColumns() const { return ResultColumns; }
+
+    //////////////////////////////////////////////////////////////////////////
+    // RESULT FILES
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Write the completed analysis to a versioned binary result file
+     * @param bIncludeNormals - Store octahedron-encoded hit normals (4 bytes per ray)
+     * @param bIncludeActorTable - Store hit actor paths (2 bytes per ray plus the table)
+     * @return False if no completed analysis exists or the file could not be written
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Result File")
+    bool SaveAnalysisToFile(const FString &FilePath, bool bIncludeNormals = true, bool bIncludeActorTable = false);
+
+    /**
+     * Replace the current results with a result file written for this observer
+     * Fails leaving results untouched if the file is unreadable or its configuration hash or observer transform differ;
+     * the ray lattice is only rebuilt after those checks, so a file whose ray layout still disagrees fails with results cleared
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Result File")
+    bool LoadAnalysisFromFile(const FString &FilePath);
+
+    /** Hash of every property that shapes the ray lattice; result files only load into matching observers */
+    uint64 ComputeConfigHash() const;
+
 protected:
     //////////////////////////////////////////////////////////////////////////
     // COMPONENTS
@@ -454,35 +1018,94 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UDecalComponent *HiddenVisualizationDecalComponent;
 
-    // Procedural mesh component to Visualize Visible mesh
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UProceduralMeshComponent *VisibleVisualization_ProceduralMeshComponent;
+    // Procedural mesh component to Visualize Visible mesh (created while Show Visible Blanket is enabled)
+    UPROPERTY(VisibleAnywhere, Transient, BlueprintReadOnly, Category = "Components")
+    UProceduralMeshComponent *VisibleVisualization_ProceduralMeshComponent = nullptr;
 
-    /** Component for rendering visible point instances */
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UInstancedStaticMeshComponent *Debug_VisiblePointsISMC;
+    /** Component for rendering visible point instances (created while visible debug points are shown) */
+    UPROPERTY(VisibleAnywhere, Transient, BlueprintReadOnly, Category = "Components")
+    UInstancedStaticMeshComponent *Debug_VisiblePointsISMC = nullptr;
 
-    /** Component for rendering hidden point instances */
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UInstancedStaticMeshComponent *Debug_HiddenPointsISMC;
+    /** Component for rendering hidden point instances (created while hidden debug points are shown) */
+    UPROPERTY(VisibleAnywhere, Transient, BlueprintReadOnly, Category = "Components")
+    UInstancedStaticMeshComponent *Debug_HiddenPointsISMC = nullptr;
 
-    // Procedural mesh component to show Viewshed Step merged mesh
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UProceduralMeshComponent *Debug_ProceduralMeshComponent;
+    // Procedural mesh component to show Viewshed Step merged mesh (created while the merged debug mesh is shown)
+    UPROPERTY(VisibleAnywhere, Transient, BlueprintReadOnly, Category = "Components")
+    UProceduralMeshComponent *Debug_ProceduralMeshComponent = nullptr;
 
 private:
     //////////////////////////////////////////////////////////////////////////
     // INTERNAL DATA
     //////////////////////////////////////////////////////////////////////////
 
-    /** Array storing all analysis point results */
+    /** Array storing all analysis point results (only held transiently in Horizon Map mode) */
     TArray<FS__ViewShedPoint> AnalysisResults;
 
-    /** Hierarchical layout of traces organised by distance steps and FOV sub-sections */
-    TArray<FS__ViewShedTraceSection> TraceSections;
+    /** First-occluder distance per direction, the stored result in Horizon Map mode */
+    FS__ViewShedHorizonMap HorizonMap;
+
+    /** Uniform grid index over visible and hidden hit locations, rebuilt after each completed analysis */
+    FS__ViewShedSpatialIndex SpatialIndex;
 
-    /** Flattened queue of trace start/end pairs, consumed sequentially during analysis */
-    TArray<FS__ViewShedTracePoint> TracePointQueue;
+    /** Packed visibility/distance/band columns, rebuilt after each completed analysis */
+    FS__ViewShedResultColumns ResultColumns;
+
+    /** World-aligned raster updated incrementally as traces complete */
+    FS__ViewShedWorldRaster WorldRaster;
+
+    /** Region coverage tables over WorldRaster, rebuilt when an analysis completes */
+    FS__ViewShedVisibilityPyramid VisibilityPyramid;
+
+    /** Visibility custom data last submitted to Debug_VisiblePointsISMC, one float per instance */
+    TArray<float> Debug_VisiblePointsSubmittedData;
+
+    /** Visibility custom data last submitted to Debug_HiddenPointsISMC, one float per instance */
+    TArray<float> Debug_HiddenPointsSubmittedData;
+
+    /** Debug line segments waiting for FlushDebugLines, reused between submissions */
+    TArray<FBatchedLine> DebugLineBuffer;
+
+    /** Merged debug mesh section buffers (0 = visible, 1 = hidden), reused between rebuilds */
+    FS__ViewShedBlanketMesh DebugMarkerSections[2];
+
+    /** Blanket inputs and section buffers, reused between rebuilds and owned by a worker while BlanketBuildFuture runs */
+    TSharedPtr<FS__ViewShedBlanketBuild> BlanketBuild;
+
+    /** Blanket build running on the thread pool (invalid when idle) */
+    TFuture<void> BlanketBuildFuture;
+
+    /** Results changed while a blanket build was running; rebuild once it finishes */
+    bool bBlanketRebuildQueued = false;
+
+    /** Topology hash of the uploaded blanket section (0 = none) */
+    uint64 UploadedBlanketTopologyHash = 0;
+
+    /** Writer of the streamed analysis in progress (Streamed mode only) */
+    TUniquePtr<FS__ViewShedStreamFileWriter> StreamWriter;
+
+    /** Next ray of the streamed analysis in progress, in stream file order */
+    int64 StreamNextRay = 0;
+
+    /** Transient texture mirroring WorldRaster */
+    UPROPERTY(Transient)
+    UTexture2D *WorldRasterTexture = nullptr;
+
+    /** Transient texture of per-direction first-occluder distances for the hidden decal */
+    UPROPERTY(Transient)
+    UTexture2D *HorizonOccluderTexture = nullptr;
+
+    /** Lattice HorizonOccluderTexture was packed on */
+    FS__ViewShedHorizonLattice HorizonOccluderLattice;
+
+    /** Shared local direction table of the current lattice (kept alive while this observer uses it) */
+    TSharedPtr<const FS__ViewShedDirectionTable> DirectionTable;
+
+    /** Shared sampling pattern of the current analysis (null on the grid); DirectionTable aliases its directions */
+    TSharedPtr<const FS__ViewShedSamplingPattern> SamplingPatternData;
+
+    /** Rays of the current analysis in queue order, consumed sequentially during analysis; bands and rows are index ranges into it */
+    FS__ViewShedRayStore RayStore;
 
     /** Current state of analysis processing */
     bool bAnalysisInProgress = false;
@@ -493,9 +1116,19 @@ private:
     /** Time when last analysis update occurred */
     float LastUpdateTime = 0.0f;
 
+    /** Significance last applied by SetSignificance */
+    float CurrentSignificance = 1.0f;
+
     /** Dynamic material instance used by the hidden visualization decal to receive runtime parameters */
     UMaterialInstanceDynamic *HiddenVisualizationDecalMID = nullptr;
 
+    /** Hashes of the decal frustum and material inputs last pushed by UpdateHiddenVisualizationDecal */
+    uint64 DecalFrustumHash = 0;
+    uint64 DecalMaterialHash = 0;
+
+    /** Row of the shared decal parameter texture (INDEX_NONE unless bVS_UseSharedParameters) */
+    int32 SharedDecalSlot = INDEX_NONE;
+
     /** Cached number of horizontal samples produced during the last GenerateTraceEndpoints pass */
     int32 CachedHorizontalSampleCount = 0;
 
@@ -509,30 +1142,138 @@ private:
     // INTERNAL FUNCTIONS
     //////////////////////////////////////////////////////////////////////////
 
+    /** Section, sample and band counts of the current sampling configuration */
+    void ComputeSamplingLayout(int32 &OutHorizontalSectionCount, int32 &OutVerticalSectionCount,
+                               int32 &OutHorizontalSampleCount, int32 &OutVerticalSampleCount, int32 &OutDistanceBandCount) const;
+
+    /** Horizontal (X) and vertical (Y) lattice stride of every band for Per-Band Sample Density (empty when disabled) */
+    void ComputeBandStrides(int32 HorizontalSampleCount, int32 VerticalSampleCount, int32 DistanceBandCount, TArray<FIntPoint> &OutBandStrides) const;
+
     /** Generate all trace endpoints in pyramid pattern */
     void GenerateTraceEndpoints();
 
+    /** Sampling pattern the next analysis will use (the grid for Streamed analyses) */
+    E__ViewShedSamplingPattern GetEffectiveSamplingPattern() const;
+
+    /** Size AnalysisResults to the trace queue and seed each result from its endpoint */
+    void InitializeResultsFromTraceQueue();
+
+    /** Build derived structures, update visualization and broadcast once every result is final */
+    void FinalizeAnalysis();
+
     /** Process a single line trace by index */
     void ProcessSingleTrace(int32 TraceIndex);
 
+    /** Draw the debug lines of traces [StartIndex, EndIndex) from their stored results (game thread) */
+    void DrawTraceDebugLines(int32 StartIndex, int32 EndIndex);
+
+    /** Whether a trace passes the debug line stride and band filters */
+    bool ShouldDrawDebugLine(const FS__ViewShedTracePoint &TracePoint) const;
+
+    /** Draw one debug line, or queue it for FlushDebugLines when batching */
+    void AddDebugLine(const FVector &Start, const FVector &End, const FColor &Color);
+
+    /** Submit every queued debug line to the world line batcher in one call */
+    void FlushDebugLines();
+
+    /** Line trace one ray and write its visibility, hit location, normal and actor; safe to call from worker threads */
+    void TraceRay(const FS__ViewShedTracePoint &TracePoint, FS__ViewShedPoint &OutPoint) const;
+
+    /** Open the stream file and size the ray lattice for a streamed analysis */
+    bool BeginStreamingAnalysis();
+
+    /**
+     * Trace the next rays of a streamed analysis and append them to the stream file
+     * @param bParallel - Trace on worker threads
+     * @return False if the stream file could not be written
+     */
+    bool ProcessStreamingRays(int64 MaxRays, bool bParallel);
+
+    /** Write the stream file index and finalize a streamed analysis */
+    void FinishStreamingAnalysis();
+
+    /** Trace one far-band ray and record its first occluder in the horizon map */
+    void ProcessHorizonTrace(int32 TraceIndex);
+
+    /** Index of the first far-band trace; the only traces run in Horizon Map mode */
+    int32 GetHorizonTraceStartIndex() const;
+
+    /** Prepare result storage for the current trace queue according to ResultMode */
+    void InitializeResultStorage();
+
+    /** Derive every band result from the horizon map */
+    void DeriveResultsFromHorizonMap(TArray<FS__ViewShedPoint> &OutResults) const;
+
+    /** Derive the band results of a range of rays from the horizon map */
+    void DeriveResultsFromHorizonMap(const FS__ViewShedRayRange &Range, TArray<FS__ViewShedPoint> &OutResults) const;
+
     /** Build Debug Point Mesh */
     void BuildDebug_PointMesh();
 
     /** Build Debug Procedural Merged Mesh */
     void BuildDebug_ProceduralMergedMesh();
 
-    /** Build Visible Visualization Procedural Merged Mesh */
+    /** Build Visible Visualization Procedural Merged Mesh (starts a worker build, uploaded by ApplyBlanketBuild) */
     void BuildVisibleVisualization_ProceduralMergedMesh();
 
+    /** Rebuild the spatial index from current results */
+    void RebuildSpatialIndex();
+
+    /** Rebuild the packed result columns from current results */
+    void RebuildResultColumns();
+
+    /** Centre and clear the world raster around the observer for a new analysis */
+    void InitializeWorldRaster();
+
+    /** Create or resize the raster texture and upload the current raster */
+    void UpdateWorldRasterTexture();
+
+    /** Pack the current first-occluder distances into HorizonOccluderTexture */
+    void UpdateHorizonOccluderTexture();
+
+    /** Rebuild the visibility pyramid from the finished world raster */
+    void RebuildVisibilityPyramid();
+
+    /** Upload a finished blanket build, in place when the topology is unchanged, and start any queued rebuild */
+    void ApplyBlanketBuild();
+
+    /** Create the visualization components the current flags need and destroy the ones they no longer need */
+    void SyncVisualizationComponents();
+
+    /**
+     * Replace a point component's instances in one batch, updating in place when the count is unchanged
+     * @param InOutSubmittedVisibility - Custom data last sent to Component; only values that differ from it are resent
+     */
+    static void SubmitPointInstances(UInstancedStaticMeshComponent *Component, const TArray<FTransform> &Transforms, const TArray<float> &Visibility,
+                                     TArray<float> &InOutSubmittedVisibility);
+
+    /** Create and register a debug point instance component */
+    UInstancedStaticMeshComponent *CreatePointsISMC(FName BaseName, UMaterialInterface *Material);
+
+    /** Create and register a visualization procedural mesh component */
+    UProceduralMeshComponent *CreateVisualizationMesh(FName BaseName);
+
     /** Update visualization based on current results */
     void UpdateVisualization();
 
-    /** Update or initialize the hidden visualization decal component transform and material parameters */
+    /** Update the hidden visualization decal transform and material parameters that changed since the last call */
     void UpdateHiddenVisualizationDecal();
 
+    /** Return this observer's row of the shared decal parameter texture */
+    void ReleaseSharedDecalSlot();
+
+    /** Ask the significance subsystem to re-rate this observer */
+    void NotifySignificanceChanged();
+
+    /** Root component moved: the observer's significance may have changed */
+    void OnSignificanceTransformUpdated(USceneComponent *UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
     /** Get the world position of the observer (actor + height offset) */
     FVector GetObserverLocation() const;
 
+    /** Orthonormal observer frame shared by the trace lattice, streamed analyses and the blanket build (Up kept, Forward re-derived) */
+    FQuat GetObserverRotation() const;
+
     /** Draw debug visualization for the viewshed pyramid */
     void DrawDebugPyramid() const;
 
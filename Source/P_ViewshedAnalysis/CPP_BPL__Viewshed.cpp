@@ -46,6 +46,19 @@ bool UCPP_BPL__Viewshed::IsPointVisibleFromLocation(
     return !bHit;
 }
 
+/**
+ * Count visible points with a branchless accumulation
+ */
+int32 UCPP_BPL__Viewshed::CountVisiblePoints(const TArray<FS__ViewShedPoint> &ViewShedPoints)
+{
+    int32 VisibleCount = 0;
+    for (const FS__ViewShedPoint &Point : ViewShedPoints)
+    {
+        VisibleCount += Point.bIsVisible ? 1 : 0;
+    }
+    return VisibleCount;
+}
+
 /**
  * Calculate visibility percentage from viewshed results
  */
@@ -58,14 +71,7 @@ float UCPP_BPL__Viewshed::CalculateVisibilityPercentage(const TArray<FS__ViewShe
     }
 
     // Count visible points
-    int32 VisibleCount = 0;
-    for (const FS__ViewShedPoint &Point : ViewShedPoints)
-    {
-        if (Point.bIsVisible)
-        {
-            VisibleCount++;
-        }
-    }
+    const int32 VisibleCount = CountVisiblePoints(ViewShedPoints);
 
     // Calculate and return percentage
     return (float(VisibleCount) / float(ViewShedPoints.Num())) * 100.0f;
@@ -81,6 +87,14 @@ TArray<FS__ViewShedPoint> UCPP_BPL__Viewshed::FilterPointsByDistance(
 {
     TArray<FS__ViewShedPoint> FilteredPoints;
 
+    // Count matches first so the output is allocated exactly once
+    int32 MatchCount = 0;
+    for (const FS__ViewShedPoint &Point : ViewShedPoints)
+    {
+        MatchCount += (Point.Distance >= MinDistance && Point.Distance <= MaxDistance) ? 1 : 0;
+    }
+    FilteredPoints.Reserve(MatchCount);
+
     // Iterate through all points and filter by distance
     for (const FS__ViewShedPoint &Point : ViewShedPoints)
     {
@@ -101,6 +115,7 @@ TArray<FS__ViewShedPoint> UCPP_BPL__Viewshed::FilterPointsByDistance(
 TArray<FS__ViewShedPoint> UCPP_BPL__Viewshed::GetVisiblePoints(const TArray<FS__ViewShedPoint> &ViewShedPoints)
 {
     TArray<FS__ViewShedPoint> VisiblePoints;
+    VisiblePoints.Reserve(CountVisiblePoints(ViewShedPoints));
 
     // Filter for visible points only
     for (const FS__ViewShedPoint &Point : ViewShedPoints)
@@ -120,6 +135,7 @@ TArray<FS__ViewShedPoint> UCPP_BPL__Viewshed::GetVisiblePoints(const TArray<FS__
 TArray<FS__ViewShedPoint> UCPP_BPL__Viewshed::GetHiddenPoints(const TArray<FS__ViewShedPoint> &ViewShedPoints)
 {
     TArray<FS__ViewShedPoint> HiddenPoints;
+    HiddenPoints.Reserve(ViewShedPoints.Num() - CountVisiblePoints(ViewShedPoints));
 
     // Filter for hidden points only
     for (const FS__ViewShedPoint &Point : ViewShedPoints)
@@ -167,3 +183,13 @@ bool UCPP_BPL__Viewshed::FindClosestVisiblePoint(
 
     return bFoundAny;
 }
+
+/**
+ * Copy the points at the given indices into a new, exactly sized array
+ */
+TArray<FS__ViewShedPoint> UCPP_BPL__Viewshed::GetPointsByIndices(
+    const TArray<FS__ViewShedPoint> &ViewShedPoints,
+    const TArray<int32> &Indices)
+{
+    return FS__ViewShedResultColumns::Materialize(ViewShedPoints, Indices);
+}
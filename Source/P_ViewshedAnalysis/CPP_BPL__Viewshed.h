@@ -37,6 +37,14 @@ public:
         FVector TargetLocation,
         AActor *IgnoreActor = nullptr);
 
+    /**
+     * Count visible points in an array of viewshed points
+     * @param ViewShedPoints - Array of analysis points
+     * @return Number of points marked visible
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis")
+    static int32 CountVisiblePoints(const TArray<FS__ViewShedPoint> &ViewShedPoints);
+
     /**
      * Calculate visibility percentage from an array of viewshed points
      * @param ViewShedPoints - Array of analysis points
@@ -86,4 +94,15 @@ public:
         const TArray<FS__ViewShedPoint> &ViewShedPoints,
         FVector Location,
         FS__ViewShedPoint &FoundPoint);
+
+    /**
+     * Materialize points selected by an index list (from the actor's indexed or filter queries)
+     * @param ViewShedPoints - Array of analysis points the indices refer to
+     * @param Indices - Indices into ViewShedPoints; invalid entries are skipped
+     * @return Array containing only the selected points
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis")
+    static TArray<FS__ViewShedPoint> GetPointsByIndices(
+        const TArray<FS__ViewShedPoint> &ViewShedPoints,
+        const TArray<int32> &Indices);
 };
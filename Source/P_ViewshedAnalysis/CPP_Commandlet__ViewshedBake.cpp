@@ -0,0 +1,310 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Commandlet__ViewshedBake.h"
+#include "CPP_Actor__Viewshed.h"
+#include "CPP_Struct__ViewshedBakeDatabase.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogViewshedBake, Log, All);
+
+namespace ViewshedBake
+{
+    /** Parse "X,Y,Z" into a vector */
+    static bool ParseVector(const FString &Text, FVector &OutVector)
+    {
+        TArray<FString> Parts;
+        Text.ParseIntoArray(Parts, TEXT(","));
+        if (Parts.Num() < 3)
+        {
+            return false;
+        }
+        OutVector = FVector(FCString::Atod(*Parts[0]), FCString::Atod(*Parts[1]), FCString::Atod(*Parts[2]));
+        return true;
+    }
+}
+
+/**
+ * Constructor - commandlet runs headless without an editor UI
+ */
+UCPP_Commandlet__ViewshedBake::UCPP_Commandlet__ViewshedBake()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Bake viewshed horizon maps for a grid or list of observer positions into a chunked database");
+    HelpUsage = TEXT("-run=CPP_Commandlet__ViewshedBake -Map=<Package> -Output=<File> [-Template=<Class>] [-GridMin=X,Y,Z -GridMax=X,Y,Z -GridSpacing=N] [-Points=<File>] [-Yaw=N] [-ChunkSize=N] [-SnapToGround]");
+}
+
+/**
+ * Commandlet entry point
+ */
+int32 UCPP_Commandlet__ViewshedBake::Main(const FString &Params)
+{
+    FString MapName;
+    FString OutputPath;
+    if (!FParse::Value(*Params, TEXT("Map="), MapName) || !FParse::Value(*Params, TEXT("Output="), OutputPath))
+    {
+        UE_LOG(LogViewshedBake, Error, TEXT("Missing -Map or -Output. Usage: %s"), *HelpUsage);
+        return 1;
+    }
+    if (FPaths::IsRelative(OutputPath))
+    {
+        OutputPath = FPaths::Combine(FPaths::ProjectDir(), OutputPath);
+    }
+
+    float ChunkSize = 10000.0f;
+    FParse::Value(*Params, TEXT("ChunkSize="), ChunkSize);
+    const bool bSnapToGround = FParse::Param(*Params, TEXT("SnapToGround"));
+
+    // Observer template: a Blueprint subclass carries the sampling configuration in its defaults
+    TSubclassOf<ACPP_Actor__Viewshed> TemplateClass = ACPP_Actor__Viewshed::StaticClass();
+    FString TemplatePath;
+    if (FParse::Value(*Params, TEXT("Template="), TemplatePath))
+    {
+        TemplateClass = LoadClass<ACPP_Actor__Viewshed>(nullptr, *TemplatePath);
+        if (!TemplateClass)
+        {
+            UE_LOG(LogViewshedBake, Error, TEXT("Template class %s could not be loaded"), *TemplatePath);
+            return 1;
+        }
+    }
+
+    TArray<FTransform> ObserverTransforms;
+    if (!GatherObserverTransforms(Params, ObserverTransforms))
+    {
+        UE_LOG(LogViewshedBake, Error, TEXT("No observer positions; pass -GridMin/-GridMax/-GridSpacing and/or -Points"));
+        return 1;
+    }
+
+    UWorld *World = LoadBakeWorld(MapName);
+    if (!World)
+    {
+        UE_LOG(LogViewshedBake, Error, TEXT("Map %s could not be loaded"), *MapName);
+        return 1;
+    }
+
+    // One virtual observer is moved from position to position
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ACPP_Actor__Viewshed *Observer = World->SpawnActor<ACPP_Actor__Viewshed>(TemplateClass, FTransform::Identity, SpawnParams);
+    if (!Observer)
+    {
+        UE_LOG(LogViewshedBake, Error, TEXT("Failed to spawn the observer template"));
+        ReleaseBakeWorld(World);
+        return 1;
+    }
+    Observer->bAutoUpdate = false;
+    // The database header describes a grid lattice
+    if (Observer->SamplingPattern != E__ViewShedSamplingPattern::Grid)
+    {
+        UE_LOG(LogViewshedBake, Warning, TEXT("Template sampling pattern is not supported by the bake database; baking on the grid"));
+        Observer->SamplingPattern = E__ViewShedSamplingPattern::Grid;
+    }
+
+    TArray<FS__ViewShedBakedObserver> BakedObservers;
+    BakedObservers.Reserve(ObserverTransforms.Num());
+    FS__ViewShedBakeDatabaseHeader Header;
+    Header.ConfigHash = Observer->ComputeConfigHash();
+    Header.ChunkSize = ChunkSize;
+
+    const double StartTime = FPlatformTime::Seconds();
+    FS__ViewShedHorizonMap Horizon;
+    for (int32 i = 0; i < ObserverTransforms.Num(); ++i)
+    {
+        FTransform ObserverTransform = ObserverTransforms[i];
+        if (bSnapToGround)
+        {
+            SnapTransformToGround(World, ObserverTransform);
+        }
+        Observer->SetActorTransform(ObserverTransform);
+
+        // Rays of one observer are traced in parallel
+        if (!Observer->TraceAllImmediate())
+        {
+            UE_LOG(LogViewshedBake, Warning, TEXT("Observer %d produced no rays; skipped"), i);
+            continue;
+        }
+
+        Observer->BuildHorizonMap(Horizon);
+        if (BakedObservers.IsEmpty())
+        {
+            // Every observer shares the template configuration, so the first lattice describes them all
+            Header.HorizontalSampleCount = Horizon.Lattice.HorizontalSampleCount;
+            Header.VerticalSampleCount = Horizon.Lattice.VerticalSampleCount;
+            Header.HalfHorizontalFOV = Horizon.Lattice.HalfHorizontalFOV;
+            Header.HalfVerticalFOV = Horizon.Lattice.HalfVerticalFOV;
+            Header.MaxDistance = Horizon.Lattice.MaxDistance;
+        }
+
+        FS__ViewShedBakedObserver &Baked = BakedObservers.AddDefaulted_GetRef();
+        Baked.EyeLocation = Observer->GetRayStore().Origin;
+        Baked.Rotation = Observer->GetActorQuat();
+        Baked.SetHorizon(Horizon);
+
+        if ((i + 1) % 16 == 0 || i + 1 == ObserverTransforms.Num())
+        {
+            UE_LOG(LogViewshedBake, Display, TEXT("Baked %d / %d observers (%.1fs)"), i + 1, ObserverTransforms.Num(), FPlatformTime::Seconds() - StartTime);
+        }
+    }
+
+    Observer->Destroy();
+
+    const bool bWritten = !BakedObservers.IsEmpty() && FS__ViewShedBakeDatabase::Write(OutputPath, Header, BakedObservers);
+    ReleaseBakeWorld(World);
+
+    if (!bWritten)
+    {
+        UE_LOG(LogViewshedBake, Error, TEXT("Failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogViewshedBake, Display, TEXT("Wrote %d observers to %s"), BakedObservers.Num(), *OutputPath);
+    return 0;
+}
+
+/**
+ * Load and initialize a map for collision queries
+ */
+UWorld *UCPP_Commandlet__ViewshedBake::LoadBakeWorld(const FString &MapName)
+{
+    UPackage *Package = LoadPackage(nullptr, *MapName, LOAD_None);
+    UWorld *World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    World->AddToRoot();
+    World->WorldType = EWorldType::Editor;
+
+    FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+    WorldContext.SetCurrentWorld(World);
+
+    // Only collision is needed: no audio, navigation, AI or simulation
+    if (!World->bIsWorldInitialized)
+    {
+        World->InitWorld(UWorld::InitializationValues()
+                             .AllowAudioPlayback(false)
+                             .CreatePhysicsScene(true)
+                             .RequiresHitProxies(false)
+                             .CreateNavigation(false)
+                             .CreateAISystem(false)
+                             .ShouldSimulatePhysics(false)
+                             .SetTransactional(false));
+    }
+
+    // Register components so their collision enters the physics scene, including streamed sublevels
+    World->UpdateWorldComponents(true, false);
+    World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+    return World;
+}
+
+/**
+ * Release a world created by LoadBakeWorld
+ */
+void UCPP_Commandlet__ViewshedBake::ReleaseBakeWorld(UWorld *World)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+    CollectGarbage(RF_NoFlags);
+}
+
+/**
+ * Collect observer transforms from the grid and/or point list parameters
+ */
+bool UCPP_Commandlet__ViewshedBake::GatherObserverTransforms(const FString &Params, TArray<FTransform> &OutTransforms) const
+{
+    OutTransforms.Reset();
+
+    float DefaultYaw = 0.0f;
+    FParse::Value(*Params, TEXT("Yaw="), DefaultYaw);
+
+    // Regular grid
+    FString GridMinText;
+    FString GridMaxText;
+    float GridSpacing = 0.0f;
+    FVector GridMin;
+    FVector GridMax;
+    if (FParse::Value(*Params, TEXT("GridMin="), GridMinText) && FParse::Value(*Params, TEXT("GridMax="), GridMaxText) &&
+        FParse::Value(*Params, TEXT("GridSpacing="), GridSpacing) && GridSpacing > 0.0f &&
+        ViewshedBake::ParseVector(GridMinText, GridMin) && ViewshedBake::ParseVector(GridMaxText, GridMax))
+    {
+        const FQuat GridRotation(FRotator(0.0f, DefaultYaw, 0.0f));
+        for (double Y = FMath::Min(GridMin.Y, GridMax.Y); Y <= FMath::Max(GridMin.Y, GridMax.Y); Y += GridSpacing)
+        {
+            for (double X = FMath::Min(GridMin.X, GridMax.X); X <= FMath::Max(GridMin.X, GridMax.X); X += GridSpacing)
+            {
+                OutTransforms.Add(FTransform(GridRotation, FVector(X, Y, GridMin.Z)));
+            }
+        }
+    }
+
+    // Point list: "X,Y,Z[,Yaw]" per line
+    FString PointsPath;
+    if (FParse::Value(*Params, TEXT("Points="), PointsPath))
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *PointsPath))
+        {
+            UE_LOG(LogViewshedBake, Error, TEXT("Point list %s could not be read"), *PointsPath);
+            return false;
+        }
+
+        for (const FString &RawLine : Lines)
+        {
+            const FString Line = RawLine.TrimStartAndEnd();
+            if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+            {
+                continue;
+            }
+
+            FVector Location;
+            if (!ViewshedBake::ParseVector(Line, Location))
+            {
+                UE_LOG(LogViewshedBake, Warning, TEXT("Skipping malformed point \"%s\""), *Line);
+                continue;
+            }
+
+            TArray<FString> Parts;
+            Line.ParseIntoArray(Parts, TEXT(","));
+            const float Yaw = Parts.Num() >= 4 ? FCString::Atof(*Parts[3]) : DefaultYaw;
+            OutTransforms.Add(FTransform(FQuat(FRotator(0.0f, Yaw, 0.0f)), Location));
+        }
+    }
+
+    return !OutTransforms.IsEmpty();
+}
+
+/**
+ * Move an observer down onto the first surface below it
+ */
+void UCPP_Commandlet__ViewshedBake::SnapTransformToGround(UWorld *World, FTransform &InOutTransform)
+{
+    const FVector Location = InOutTransform.GetLocation();
+    const FVector Start = Location + FVector(0.0, 0.0, 100.0);
+    const FVector End = Location - FVector(0.0, 0.0, 1000000.0);
+
+    FHitResult Hit;
+    if (World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility))
+    {
+        InOutTransform.SetLocation(Hit.Location);
+    }
+}
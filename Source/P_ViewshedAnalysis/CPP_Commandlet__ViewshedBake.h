@@ -0,0 +1,52 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CPP_Commandlet__ViewshedBake.generated.h"
+
+class ACPP_Actor__Viewshed;
+
+/**
+ * Bakes viewshed horizon maps for a set of observer positions into a chunked, compressed database
+ *
+ * Usage:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=CPP_Commandlet__ViewshedBake -Map=/Game/Maps/MyMap -Output=Saved/Viewshed/MyMap.vsbk
+ *       [-Template=/Game/BP_Viewshed.BP_Viewshed_C] [-GridMin=X,Y,Z -GridMax=X,Y,Z -GridSpacing=1000] [-Points=Points.txt]
+ *       [-Yaw=0] [-ChunkSize=10000] [-SnapToGround]
+ *
+ * -Template   Viewshed actor class (usually a Blueprint) whose defaults supply the sampling configuration
+ * -GridMin/Max/Spacing  Regular XY grid of observer positions at Z = GridMin.Z (or snapped to ground)
+ * -Points     Text file with one "X,Y,Z[,Yaw]" observer per line (lines starting with # are ignored)
+ * -Yaw        Facing of grid observers and of point-list observers without an explicit yaw
+ */
+UCLASS()
+class P_VIEWSHEDANALYSIS_API UCPP_Commandlet__ViewshedBake : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    /** Constructor - commandlet runs headless without an editor UI */
+    UCPP_Commandlet__ViewshedBake();
+
+    /** Commandlet entry point */
+    virtual int32 Main(const FString &Params) override;
+
+    /** Load and initialize a map for collision queries (shared with the batch commandlet) */
+    static UWorld *LoadBakeWorld(const FString &MapName);
+
+    /** Release a world created by LoadBakeWorld */
+    static void ReleaseBakeWorld(UWorld *World);
+
+    /** Move an observer down onto the first surface below it */
+    static void SnapTransformToGround(UWorld *World, FTransform &InOutTransform);
+
+private:
+    /** Collect observer transforms from the grid and/or point list parameters */
+    bool GatherObserverTransforms(const FString &Params, TArray<FTransform> &OutTransforms) const;
+};
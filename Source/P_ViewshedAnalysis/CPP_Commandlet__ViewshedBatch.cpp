@@ -0,0 +1,521 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Commandlet__ViewshedBatch.h"
+#include "CPP_Actor__Viewshed.h"
+#include "CPP_Commandlet__ViewshedBake.h"
+#include "CPP_Struct__ViewshedStreamFile.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogViewshedBatch, Log, All);
+
+namespace ViewshedBatch
+{
+    /** Read a [X, Y, Z] array */
+    static bool ReadVector(const FJsonObject &Object, const FString &Field, FVector &OutVector)
+    {
+        const TArray<TSharedPtr<FJsonValue>> *Values = nullptr;
+        if (!Object.TryGetArrayField(Field, Values) || Values->Num() < 3)
+        {
+            return false;
+        }
+        OutVector = FVector((*Values)[0]->AsNumber(), (*Values)[1]->AsNumber(), (*Values)[2]->AsNumber());
+        return true;
+    }
+
+    /** Convert a "Parameters" object into property name / exported text pairs */
+    static void ReadParameters(const FJsonObject &Object, TArray<TPair<FString, FString>> &InOutParameters)
+    {
+        const TSharedPtr<FJsonObject> *Parameters = nullptr;
+        if (!Object.TryGetObjectField(TEXT("Parameters"), Parameters))
+        {
+            return;
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>> &Entry : (*Parameters)->Values)
+        {
+            FString Text;
+            switch (Entry.Value->Type)
+            {
+            case EJson::Number:
+            {
+                // Integral values are written without a fraction so integer and enum properties parse them
+                const double Number = Entry.Value->AsNumber();
+                Text = FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number)) ? FString::Printf(TEXT("%lld"), int64(FMath::RoundToDouble(Number)))
+                                                                                   : FString::SanitizeFloat(Number);
+                break;
+            }
+            case EJson::Boolean:
+                Text = Entry.Value->AsBool() ? TEXT("True") : TEXT("False");
+                break;
+            case EJson::String:
+                // Structs and other complex values use exported text, e.g. "(X=1,Y=2,Z=3)"
+                Text = Entry.Value->AsString();
+                break;
+            default:
+                UE_LOG(LogViewshedBatch, Warning, TEXT("Parameter %s has an unsupported JSON type; pass it as exported text"), *Entry.Key);
+                continue;
+            }
+            InOutParameters.Emplace(Entry.Key, Text);
+        }
+    }
+
+    /** Serialize a JSON object to a file */
+    static bool SaveJson(const TSharedRef<FJsonObject> &Object, const FString &FilePath)
+    {
+        FString Text;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+        return FJsonSerializer::Serialize(Object, Writer) && FFileHelper::SaveStringToFile(Text, *FilePath);
+    }
+
+    /** Parse a JSON object from a file */
+    static TSharedPtr<FJsonObject> LoadJson(const FString &FilePath)
+    {
+        FString Text;
+        TSharedPtr<FJsonObject> Object;
+        if (FFileHelper::LoadFileToString(Text, *FilePath))
+        {
+            FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Object);
+        }
+        return Object;
+    }
+}
+
+/**
+ * Constructor - commandlet runs headless without an editor UI
+ */
+UCPP_Commandlet__ViewshedBatch::UCPP_Commandlet__ViewshedBatch()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Run a JSON list of viewshed analyses headless, optionally sharded across worker processes");
+    HelpUsage = TEXT("-run=CPP_Commandlet__ViewshedBatch -Jobs=<File> -Output=<Dir> [-Map=<Package>] [-Template=<Class>] [-Workers=N] [-SnapToGround]");
+}
+
+/**
+ * Commandlet entry point
+ */
+int32 UCPP_Commandlet__ViewshedBatch::Main(const FString &Params)
+{
+    FString JobsPath;
+    FString OutputDir;
+    if (!FParse::Value(*Params, TEXT("Jobs="), JobsPath) || !FParse::Value(*Params, TEXT("Output="), OutputDir))
+    {
+        UE_LOG(LogViewshedBatch, Error, TEXT("Missing -Jobs or -Output. Usage: %s"), *HelpUsage);
+        return 1;
+    }
+    if (FPaths::IsRelative(JobsPath))
+    {
+        JobsPath = FPaths::Combine(FPaths::ProjectDir(), JobsPath);
+    }
+    if (FPaths::IsRelative(OutputDir))
+    {
+        OutputDir = FPaths::Combine(FPaths::ProjectDir(), OutputDir);
+    }
+    JobsPath = FPaths::ConvertRelativePathToFull(JobsPath);
+    OutputDir = FPaths::ConvertRelativePathToFull(OutputDir);
+    IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+    // Coordinator: fan out to child processes that re-run this commandlet on one shard each
+    int32 WorkerCount = 1;
+    FParse::Value(*Params, TEXT("Workers="), WorkerCount);
+    int32 Shard = 0;
+    int32 ShardCount = 1;
+    const bool bIsWorker = FParse::Value(*Params, TEXT("Shard="), Shard) && FParse::Value(*Params, TEXT("ShardCount="), ShardCount);
+    if (!bIsWorker && WorkerCount > 1)
+    {
+        return RunWorkers(Params, JobsPath, WorkerCount, OutputDir);
+    }
+    if (ShardCount < 1 || Shard < 0 || Shard >= ShardCount)
+    {
+        UE_LOG(LogViewshedBatch, Error, TEXT("Invalid shard %d of %d"), Shard, ShardCount);
+        return 1;
+    }
+
+    FString DefaultMap;
+    FParse::Value(*Params, TEXT("Map="), DefaultMap);
+    TArray<FS__ViewShedBatchJob> Jobs;
+    if (!LoadJobs(JobsPath, DefaultMap, Jobs))
+    {
+        return 1;
+    }
+
+    // Observer template: a Blueprint subclass carries the base configuration in its defaults
+    TSubclassOf<ACPP_Actor__Viewshed> TemplateClass = ACPP_Actor__Viewshed::StaticClass();
+    FString TemplatePath;
+    if (FParse::Value(*Params, TEXT("Template="), TemplatePath))
+    {
+        TemplateClass = LoadClass<ACPP_Actor__Viewshed>(nullptr, *TemplatePath);
+        if (!TemplateClass)
+        {
+            UE_LOG(LogViewshedBatch, Error, TEXT("Template class %s could not be loaded"), *TemplatePath);
+            return 1;
+        }
+    }
+
+    return RunShard(Jobs, Shard, ShardCount, OutputDir, TemplateClass, FParse::Param(*Params, TEXT("SnapToGround")));
+}
+
+/**
+ * Parse the job list file
+ */
+bool UCPP_Commandlet__ViewshedBatch::LoadJobs(const FString &JobsPath, const FString &DefaultMap, TArray<FS__ViewShedBatchJob> &OutJobs) const
+{
+    OutJobs.Reset();
+
+    const TSharedPtr<FJsonObject> Root = ViewshedBatch::LoadJson(JobsPath);
+    const TArray<TSharedPtr<FJsonValue>> *JobValues = nullptr;
+    if (!Root.IsValid() || !Root->TryGetArrayField(TEXT("Jobs"), JobValues))
+    {
+        UE_LOG(LogViewshedBatch, Error, TEXT("Job list %s could not be read or has no \"Jobs\" array"), *JobsPath);
+        return false;
+    }
+
+    // -Map overrides the list's map; a job's own map overrides both
+    FString ListMap = DefaultMap;
+    if (ListMap.IsEmpty())
+    {
+        Root->TryGetStringField(TEXT("Map"), ListMap);
+    }
+    TArray<TPair<FString, FString>> ListParameters;
+    ViewshedBatch::ReadParameters(*Root, ListParameters);
+
+    TSet<FString> UsedNames;
+    for (int32 JobIndex = 0; JobIndex < JobValues->Num(); ++JobIndex)
+    {
+        const TSharedPtr<FJsonObject> *JobObject = nullptr;
+        if (!(*JobValues)[JobIndex]->TryGetObject(JobObject))
+        {
+            UE_LOG(LogViewshedBatch, Warning, TEXT("Skipping job %d: not an object"), JobIndex);
+            continue;
+        }
+
+        FS__ViewShedBatchJob Job;
+        FString Name;
+        (*JobObject)->TryGetStringField(TEXT("Name"), Name);
+        Name = FPaths::MakeValidFileName(Name.IsEmpty() ? FString::Printf(TEXT("Job_%d"), JobIndex) : Name);
+        // Result files are named after jobs, so names must be unique
+        Job.Name = UsedNames.Contains(Name) ? FString::Printf(TEXT("%s_%d"), *Name, JobIndex) : Name;
+        UsedNames.Add(Job.Name);
+
+        Job.Map = ListMap;
+        (*JobObject)->TryGetStringField(TEXT("Map"), Job.Map);
+        if (Job.Map.IsEmpty())
+        {
+            UE_LOG(LogViewshedBatch, Warning, TEXT("Skipping job %s: no map"), *Job.Name);
+            continue;
+        }
+
+        FVector Location = FVector::ZeroVector;
+        FVector Rotation = FVector::ZeroVector;
+        if (!ViewshedBatch::ReadVector(**JobObject, TEXT("Location"), Location))
+        {
+            UE_LOG(LogViewshedBatch, Warning, TEXT("Skipping job %s: missing [X, Y, Z] \"Location\""), *Job.Name);
+            continue;
+        }
+        ViewshedBatch::ReadVector(**JobObject, TEXT("Rotation"), Rotation);
+        Job.Transform = FTransform(FRotator(Rotation.X, Rotation.Y, Rotation.Z), Location);
+
+        Job.Parameters = ListParameters;
+        ViewshedBatch::ReadParameters(**JobObject, Job.Parameters);
+        OutJobs.Add(MoveTemp(Job));
+    }
+
+    if (OutJobs.IsEmpty())
+    {
+        UE_LOG(LogViewshedBatch, Error, TEXT("Job list %s contains no runnable jobs"), *JobsPath);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Run the jobs of one shard in this process and write its summary
+ */
+int32 UCPP_Commandlet__ViewshedBatch::RunShard(const TArray<FS__ViewShedBatchJob> &Jobs, int32 Shard, int32 ShardCount, const FString &OutputDir,
+                                               TSubclassOf<ACPP_Actor__Viewshed> TemplateClass, bool bSnapToGround) const
+{
+    // Round-robin assignment keeps shards balanced when similar jobs are listed together
+    TArray<const FS__ViewShedBatchJob *> ShardJobs;
+    for (int32 JobIndex = Shard; JobIndex < Jobs.Num(); JobIndex += ShardCount)
+    {
+        ShardJobs.Add(&Jobs[JobIndex]);
+    }
+    // Group by map so each map loads once
+    ShardJobs.StableSort([](const FS__ViewShedBatchJob &A, const FS__ViewShedBatchJob &B)
+                         { return A.Map < B.Map; });
+
+    TArray<TSharedPtr<FJsonValue>> JobResults;
+    int32 FailedCount = 0;
+    UWorld *World = nullptr;
+    FString LoadedMap;
+    const double StartTime = FPlatformTime::Seconds();
+
+    for (int32 i = 0; i < ShardJobs.Num(); ++i)
+    {
+        const FS__ViewShedBatchJob &Job = *ShardJobs[i];
+        if (!World || LoadedMap != Job.Map)
+        {
+            UCPP_Commandlet__ViewshedBake::ReleaseBakeWorld(World);
+            LoadedMap = Job.Map;
+            World = UCPP_Commandlet__ViewshedBake::LoadBakeWorld(Job.Map);
+        }
+
+        TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+        if (World)
+        {
+            Result = RunJob(World, Job, OutputDir, TemplateClass, bSnapToGround);
+        }
+        else
+        {
+            Result->SetStringField(TEXT("Name"), Job.Name);
+            Result->SetStringField(TEXT("Map"), Job.Map);
+            Result->SetStringField(TEXT("Status"), TEXT("Failed"));
+            Result->SetStringField(TEXT("Error"), TEXT("Map could not be loaded"));
+        }
+
+        if (Result->GetStringField(TEXT("Status")) != TEXT("Succeeded"))
+        {
+            ++FailedCount;
+            UE_LOG(LogViewshedBatch, Warning, TEXT("Job %s failed: %s"), *Job.Name, *Result->GetStringField(TEXT("Error")));
+        }
+        JobResults.Add(MakeShared<FJsonValueObject>(Result));
+
+        UE_LOG(LogViewshedBatch, Display, TEXT("Shard %d/%d: %d / %d jobs (%.1fs)"), Shard, ShardCount, i + 1, ShardJobs.Num(), FPlatformTime::Seconds() - StartTime);
+    }
+    UCPP_Commandlet__ViewshedBake::ReleaseBakeWorld(World);
+
+    TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetNumberField(TEXT("Shard"), Shard);
+    Summary->SetNumberField(TEXT("ShardCount"), ShardCount);
+    Summary->SetNumberField(TEXT("Succeeded"), ShardJobs.Num() - FailedCount);
+    Summary->SetNumberField(TEXT("Failed"), FailedCount);
+    Summary->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - StartTime);
+    Summary->SetArrayField(TEXT("Jobs"), JobResults);
+
+    const FString SummaryPath = ShardCount > 1 ? GetShardSummaryPath(OutputDir, Shard) : FPaths::Combine(OutputDir, TEXT("Summary.json"));
+    if (!ViewshedBatch::SaveJson(Summary, SummaryPath))
+    {
+        UE_LOG(LogViewshedBatch, Error, TEXT("Failed to write %s"), *SummaryPath);
+        return 1;
+    }
+    return FailedCount == 0 ? 0 : 1;
+}
+
+/**
+ * Run a single job in a loaded world and describe its outcome
+ */
+TSharedRef<FJsonObject> UCPP_Commandlet__ViewshedBatch::RunJob(UWorld *World, const FS__ViewShedBatchJob &Job, const FString &OutputDir,
+                                                               TSubclassOf<ACPP_Actor__Viewshed> TemplateClass, bool bSnapToGround) const
+{
+    TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("Name"), Job.Name);
+    Result->SetStringField(TEXT("Map"), Job.Map);
+    Result->SetStringField(TEXT("Status"), TEXT("Failed"));
+
+    FTransform ObserverTransform = Job.Transform;
+    if (bSnapToGround)
+    {
+        UCPP_Commandlet__ViewshedBake::SnapTransformToGround(World, ObserverTransform);
+    }
+
+    // A fresh observer per job so overrides never leak into the next job
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ACPP_Actor__Viewshed *Observer = World->SpawnActor<ACPP_Actor__Viewshed>(TemplateClass, ObserverTransform, SpawnParams);
+    if (!Observer)
+    {
+        Result->SetStringField(TEXT("Error"), TEXT("Observer could not be spawned"));
+        return Result;
+    }
+    Observer->bAutoUpdate = false;
+
+    for (const TPair<FString, FString> &Parameter : Job.Parameters)
+    {
+        FProperty *Property = FindFProperty<FProperty>(Observer->GetClass(), *Parameter.Key);
+        if (!Property || !Property->ImportText_Direct(*Parameter.Value, Property->ContainerPtrToValuePtr<void>(Observer), Observer, PPF_None))
+        {
+            Result->SetStringField(TEXT("Error"), FString::Printf(TEXT("Parameter %s = %s could not be applied"), *Parameter.Key, *Parameter.Value));
+            Observer->Destroy();
+            return Result;
+        }
+    }
+
+    const FVector Location = ObserverTransform.GetLocation();
+    TArray<TSharedPtr<FJsonValue>> LocationValues;
+    LocationValues.Add(MakeShared<FJsonValueNumber>(Location.X));
+    LocationValues.Add(MakeShared<FJsonValueNumber>(Location.Y));
+    LocationValues.Add(MakeShared<FJsonValueNumber>(Location.Z));
+    Result->SetArrayField(TEXT("Location"), LocationValues);
+    Result->SetStringField(TEXT("ConfigHash"), FString::Printf(TEXT("%016llx"), Observer->ComputeConfigHash()));
+
+    const double StartTime = FPlatformTime::Seconds();
+    bool bSucceeded = false;
+    if (Observer->ResultMode == E__ViewShedResultMode::Streamed)
+    {
+        // Out-of-core jobs write their chunked file as they trace
+        // A file left over from an earlier run would otherwise be reported as this job's result
+        const FString ResultPath = FPaths::Combine(OutputDir, Job.Name + TEXT(".vsst"));
+        if (IFileManager::Get().FileExists(*ResultPath) && !IFileManager::Get().Delete(*ResultPath, false, true, true))
+        {
+            Result->SetStringField(TEXT("Error"), FString::Printf(TEXT("Stale result file %s could not be deleted"), *ResultPath));
+            Observer->Destroy();
+            return Result;
+        }
+        Observer->StreamOutputFile.FilePath = ResultPath;
+        Observer->RunAnalysisImmediate();
+
+        FS__ViewShedStreamFileView StreamFile;
+        bSucceeded = StreamFile.Open(ResultPath);
+        if (bSucceeded)
+        {
+            Result->SetStringField(TEXT("ResultFile"), ResultPath);
+            Result->SetNumberField(TEXT("RayCount"), double(StreamFile.GetHeader().RayCount));
+        }
+    }
+    else if (Observer->TraceAllImmediate())
+    {
+        const FString ResultPath = FPaths::Combine(OutputDir, Job.Name + TEXT(".vshr"));
+        bSucceeded = Observer->SaveAnalysisToFile(ResultPath);
+        if (bSucceeded)
+        {
+            // Counts come from the observer so Horizon Map jobs never expand or copy their band points
+            Result->SetStringField(TEXT("ResultFile"), ResultPath);
+            Result->SetNumberField(TEXT("RayCount"), Observer->GetAnalysisResultCount());
+            Result->SetNumberField(TEXT("VisibleCount"), Observer->GetVisiblePointCount());
+        }
+    }
+    Result->SetNumberField(TEXT("Seconds"), FPlatformTime::Seconds() - StartTime);
+    Observer->Destroy();
+
+    if (!bSucceeded)
+    {
+        Result->SetStringField(TEXT("Error"), TEXT("Analysis produced no rays or its result file could not be written"));
+        return Result;
+    }
+    Result->SetStringField(TEXT("Status"), TEXT("Succeeded"));
+    return Result;
+}
+
+/**
+ * Spawn one child process per shard, wait for all of them and merge their summaries
+ */
+int32 UCPP_Commandlet__ViewshedBatch::RunWorkers(const FString &Params, const FString &JobsPath, int32 WorkerCount, const FString &OutputDir) const
+{
+    // Children re-run this commandlet on the same inputs with a shard assignment and no rendering
+    FString SharedArgs;
+    if (FPaths::IsProjectFilePathSet())
+    {
+        SharedArgs += FString::Printf(TEXT("\"%s\" "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+    }
+    SharedArgs += FString::Printf(TEXT("-run=CPP_Commandlet__ViewshedBatch -Jobs=\"%s\" -Output=\"%s\""), *JobsPath, *OutputDir);
+    for (const TCHAR *Key : {TEXT("Map="), TEXT("Template=")})
+    {
+        FString Value;
+        if (FParse::Value(*Params, Key, Value))
+        {
+            SharedArgs += FString::Printf(TEXT(" -%s\"%s\""), Key, *Value);
+        }
+    }
+    if (FParse::Param(*Params, TEXT("SnapToGround")))
+    {
+        SharedArgs += TEXT(" -SnapToGround");
+    }
+    SharedArgs += TEXT(" -nullrhi -unattended -nopause -nosplash -nosound");
+
+    const FString Executable = FPlatformProcess::ExecutablePath();
+    TArray<FProcHandle> Workers;
+    for (int32 Shard = 0; Shard < WorkerCount; ++Shard)
+    {
+        // Never merge a summary left over from an earlier run
+        IFileManager::Get().Delete(*GetShardSummaryPath(OutputDir, Shard), false, true, true);
+
+        const FString LogPath = FPaths::Combine(OutputDir, FString::Printf(TEXT("Worker_%d.log"), Shard));
+        const FString WorkerArgs = SharedArgs + FString::Printf(TEXT(" -Shard=%d -ShardCount=%d -abslog=\"%s\""), Shard, WorkerCount, *LogPath);
+        FProcHandle Handle = FPlatformProcess::CreateProc(*Executable, *WorkerArgs, false, true, true, nullptr, 0, nullptr, nullptr);
+        if (!Handle.IsValid())
+        {
+            UE_LOG(LogViewshedBatch, Error, TEXT("Failed to start worker %d: %s %s"), Shard, *Executable, *WorkerArgs);
+        }
+        Workers.Add(Handle);
+    }
+
+    // Wait for every worker
+    int32 FailedWorkers = 0;
+    for (int32 Shard = 0; Shard < Workers.Num(); ++Shard)
+    {
+        FProcHandle &Handle = Workers[Shard];
+        if (!Handle.IsValid())
+        {
+            ++FailedWorkers;
+            continue;
+        }
+        while (FPlatformProcess::IsProcRunning(Handle))
+        {
+            FPlatformProcess::Sleep(1.0f);
+        }
+        int32 ReturnCode = 0;
+        FPlatformProcess::GetProcReturnCode(Handle, &ReturnCode);
+        FPlatformProcess::CloseProc(Handle);
+        if (ReturnCode != 0)
+        {
+            ++FailedWorkers;
+            UE_LOG(LogViewshedBatch, Warning, TEXT("Worker %d exited with code %d"), Shard, ReturnCode);
+        }
+    }
+
+    // Merge the shard summaries
+    TArray<TSharedPtr<FJsonValue>> JobResults;
+    int32 Succeeded = 0;
+    int32 Failed = 0;
+    for (int32 Shard = 0; Shard < WorkerCount; ++Shard)
+    {
+        const TSharedPtr<FJsonObject> ShardSummary = ViewshedBatch::LoadJson(GetShardSummaryPath(OutputDir, Shard));
+        if (!ShardSummary.IsValid())
+        {
+            UE_LOG(LogViewshedBatch, Warning, TEXT("Worker %d wrote no summary"), Shard);
+            continue;
+        }
+        Succeeded += int32(ShardSummary->GetNumberField(TEXT("Succeeded")));
+        Failed += int32(ShardSummary->GetNumberField(TEXT("Failed")));
+        JobResults.Append(ShardSummary->GetArrayField(TEXT("Jobs")));
+    }
+
+    TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+    Summary->SetNumberField(TEXT("Workers"), WorkerCount);
+    Summary->SetNumberField(TEXT("Succeeded"), Succeeded);
+    Summary->SetNumberField(TEXT("Failed"), Failed);
+    Summary->SetArrayField(TEXT("Jobs"), JobResults);
+    const FString SummaryPath = FPaths::Combine(OutputDir, TEXT("Summary.json"));
+    if (!ViewshedBatch::SaveJson(Summary, SummaryPath))
+    {
+        UE_LOG(LogViewshedBatch, Error, TEXT("Failed to write %s"), *SummaryPath);
+        return 1;
+    }
+
+    UE_LOG(LogViewshedBatch, Display, TEXT("%d jobs succeeded, %d failed across %d workers; summary at %s"), Succeeded, Failed, WorkerCount, *SummaryPath);
+    return FailedWorkers == 0 && Failed == 0 ? 0 : 1;
+}
+
+/**
+ * Path of a shard's summary file
+ */
+FString UCPP_Commandlet__ViewshedBatch::GetShardSummaryPath(const FString &OutputDir, int32 Shard)
+{
+    return FPaths::Combine(OutputDir, FString::Printf(TEXT("Summary_Shard%d.json"), Shard));
+}
@@ -0,0 +1,85 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CPP_Commandlet__ViewshedBatch.generated.h"
+
+class ACPP_Actor__Viewshed;
+class FJsonObject;
+
+/**
+ * One analysis read from a batch job list
+ */
+struct FS__ViewShedBatchJob
+{
+    /** Unique job name; result files are named after it */
+    FString Name;
+
+    /** Map the observer is placed in */
+    FString Map;
+
+    /** Observer actor transform */
+    FTransform Transform = FTransform::Identity;
+
+    /** Actor property overrides as property name / exported text pairs */
+    TArray<TPair<FString, FString>> Parameters;
+};
+
+/**
+ * Runs a list of viewshed analyses headless and writes one result file per job plus a JSON summary
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=CPP_Commandlet__ViewshedBatch -Jobs=Jobs.json -Output=Saved/Viewshed/Batch
+ *       [-Map=/Game/Maps/MyMap] [-Template=/Game/BP_Viewshed.BP_Viewshed_C] [-Workers=8] [-SnapToGround] [-nullrhi]
+ *
+ * Job list:
+ *   { "Map": "/Game/Maps/MyMap",
+ *     "Parameters": { "MaxDistance": 20000, "DistanceSteps": 8 },
+ *     "Jobs": [ { "Name": "OP_North", "Location": [1000, 2000, 150], "Rotation": [0, 90, 0],
+ *                 "Map": "/Game/Maps/Other", "Parameters": { "HorizontalFOV": 360, "ResultMode": "HorizonMap" } } ] }
+ *
+ * Parameters name any ACPP_Actor__Viewshed property and are applied as exported property text, top-level values
+ * first and per-job values second. Rotation is Pitch, Yaw, Roll in degrees.
+ *
+ * -Workers    Split the job list across N child processes (round robin), wait for them and merge their summaries
+ * -Shard/-ShardCount  Set on child processes: run only jobs whose index modulo ShardCount equals Shard
+ *
+ * Rays of each job are traced in parallel on the task graph; jobs run one after another within a process.
+ * Streamed jobs write <Name>.vsst, all others <Name>.vshr; Summary.json lists every job's status and counts.
+ */
+UCLASS()
+class P_VIEWSHEDANALYSIS_API UCPP_Commandlet__ViewshedBatch : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    /** Constructor - commandlet runs headless without an editor UI */
+    UCPP_Commandlet__ViewshedBatch();
+
+    /** Commandlet entry point */
+    virtual int32 Main(const FString &Params) override;
+
+private:
+    /** Parse the job list file */
+    bool LoadJobs(const FString &JobsPath, const FString &DefaultMap, TArray<FS__ViewShedBatchJob> &OutJobs) const;
+
+    /** Run the jobs of one shard in this process and write its summary */
+    int32 RunShard(const TArray<FS__ViewShedBatchJob> &Jobs, int32 Shard, int32 ShardCount, const FString &OutputDir,
+                   TSubclassOf<ACPP_Actor__Viewshed> TemplateClass, bool bSnapToGround) const;
+
+    /** Spawn one child process per shard, wait for all of them and merge their summaries */
+    int32 RunWorkers(const FString &Params, const FString &JobsPath, int32 WorkerCount, const FString &OutputDir) const;
+
+    /** Run a single job in a loaded world and describe its outcome */
+    TSharedRef<FJsonObject> RunJob(UWorld *World, const FS__ViewShedBatchJob &Job, const FString &OutputDir,
+                                   TSubclassOf<ACPP_Actor__Viewshed> TemplateClass, bool bSnapToGround) const;
+
+    /** Path of a shard's summary file */
+    static FString GetShardSummaryPath(const FString &OutputDir, int32 Shard);
+};
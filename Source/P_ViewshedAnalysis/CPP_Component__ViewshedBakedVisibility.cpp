@@ -0,0 +1,308 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Component__ViewshedBakedVisibility.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/Paths.h"
+
+namespace ViewshedBakedVisibility
+{
+    /** Squared XY distance from a point to a chunk's square area */
+    static double ChunkDistanceSquared2D(const FIntPoint &Key, float ChunkSize, const FVector &Location)
+    {
+        const double MinX = double(Key.X) * ChunkSize;
+        const double MinY = double(Key.Y) * ChunkSize;
+        const double DX = FMath::Max3(MinX - Location.X, 0.0, Location.X - (MinX + ChunkSize));
+        const double DY = FMath::Max3(MinY - Location.Y, 0.0, Location.Y - (MinY + ChunkSize));
+        return DX * DX + DY * DY;
+    }
+}
+
+/**
+ * Constructor - enables ticking for chunk streaming
+ */
+UCPP_Component__ViewshedBakedVisibility::UCPP_Component__ViewshedBakedVisibility()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    // Streaming does not need to run every frame at full rate
+    PrimaryComponentTick.TickInterval = 0.25f;
+}
+
+/**
+ * Open the database
+ */
+void UCPP_Component__ViewshedBakedVisibility::BeginPlay()
+{
+    Super::BeginPlay();
+
+    FString DatabasePath = DatabaseFile.FilePath;
+    if (DatabasePath.IsEmpty())
+    {
+        return;
+    }
+    if (FPaths::IsRelative(DatabasePath))
+    {
+        DatabasePath = FPaths::Combine(FPaths::ProjectDir(), DatabasePath);
+    }
+
+    TSharedPtr<FS__ViewShedBakeDatabase> OpenedDatabase = MakeShared<FS__ViewShedBakeDatabase>();
+    if (OpenedDatabase->Open(DatabasePath))
+    {
+        Database = OpenedDatabase;
+    }
+}
+
+/**
+ * Drop loaded chunks
+ */
+void UCPP_Component__ViewshedBakedVisibility::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // In-flight loads hold their own reference to the database and finish harmlessly
+    PendingLoads.Empty();
+    QueuedLoads.Empty();
+    LoadedChunks.Empty();
+    Database.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * Stream chunks around the player
+ */
+void UCPP_Component__ViewshedBakedVisibility::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!Database.IsValid())
+    {
+        return;
+    }
+
+    const FVector Center = GetStreamingCenter();
+    RequestChunksAround(Center, StreamingRadius);
+    EvictDistantChunks(Center);
+    PumpLoads();
+}
+
+/**
+ * Location chunks are streamed around
+ */
+FVector UCPP_Component__ViewshedBakedVisibility::GetStreamingCenter() const
+{
+    if (const UWorld *World = GetWorld())
+    {
+        if (const APlayerController *PlayerController = World->GetFirstPlayerController())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            return ViewLocation;
+        }
+    }
+
+    return GetOwner() ? GetOwner()->GetActorLocation() : FVector::ZeroVector;
+}
+
+/**
+ * Keys of stored chunks whose XY area intersects the circle
+ */
+void UCPP_Component__ViewshedBakedVisibility::GatherChunksInRadius(const FVector &Location, float Radius, TArray<FIntPoint> &OutKeys) const
+{
+    OutKeys.Reset();
+    if (!Database.IsValid())
+    {
+        return;
+    }
+
+    const float ChunkSize = Database->GetHeader().ChunkSize;
+    const FIntPoint MinKey = Database->WorldToChunk(Location - FVector(Radius, Radius, 0.0f));
+    const FIntPoint MaxKey = Database->WorldToChunk(Location + FVector(Radius, Radius, 0.0f));
+    const double RadiusSquared = double(Radius) * Radius;
+
+    for (int32 Y = MinKey.Y; Y <= MaxKey.Y; ++Y)
+    {
+        for (int32 X = MinKey.X; X <= MaxKey.X; ++X)
+        {
+            const FIntPoint Key(X, Y);
+            if (Database->HasChunk(Key) && ViewshedBakedVisibility::ChunkDistanceSquared2D(Key, ChunkSize, Location) <= RadiusSquared)
+            {
+                OutKeys.Add(Key);
+            }
+        }
+    }
+}
+
+/**
+ * Queue every chunk within Radius of Location for loading
+ */
+void UCPP_Component__ViewshedBakedVisibility::RequestChunksAround(FVector Location, float Radius)
+{
+    TArray<FIntPoint> Keys;
+    GatherChunksInRadius(Location, Radius, Keys);
+    if (Keys.IsEmpty())
+    {
+        return;
+    }
+
+    for (const FIntPoint &Key : Keys)
+    {
+        if (!LoadedChunks.Contains(Key) && !PendingLoads.Contains(Key))
+        {
+            QueuedLoads.AddUnique(Key);
+        }
+    }
+
+    // Nearest chunks first
+    const float ChunkSize = Database->GetHeader().ChunkSize;
+    QueuedLoads.Sort([&](const FIntPoint &A, const FIntPoint &B)
+                     { return ViewshedBakedVisibility::ChunkDistanceSquared2D(A, ChunkSize, Location) <
+                              ViewshedBakedVisibility::ChunkDistanceSquared2D(B, ChunkSize, Location); });
+}
+
+/**
+ * Start queued loads up to the concurrency limit and collect finished ones
+ */
+void UCPP_Component__ViewshedBakedVisibility::PumpLoads()
+{
+    // Collect finished loads
+    for (auto It = PendingLoads.CreateIterator(); It; ++It)
+    {
+        if (It.Value().IsReady())
+        {
+            LoadedChunks.Add(It.Key(), It.Value().Consume());
+            It.RemoveCurrent();
+        }
+    }
+
+    // Start new loads; decompression runs on the thread pool
+    while (!QueuedLoads.IsEmpty() && PendingLoads.Num() < MaxConcurrentLoads)
+    {
+        const FIntPoint Key = QueuedLoads[0];
+        QueuedLoads.RemoveAt(0);
+
+        TSharedPtr<FS__ViewShedBakeDatabase> LoadDatabase = Database;
+        PendingLoads.Add(Key, Async(EAsyncExecution::ThreadPool, [LoadDatabase, Key]()
+                                    {
+                                        TArray<FS__ViewShedBakedObserver> Observers;
+                                        LoadDatabase->LoadChunk(Key, Observers);
+                                        return Observers; }));
+    }
+}
+
+/**
+ * Release chunks far from the streaming center
+ */
+void UCPP_Component__ViewshedBakedVisibility::EvictDistantChunks(const FVector &Center)
+{
+    const float ChunkSize = Database->GetHeader().ChunkSize;
+    const double KeepRadius = double(StreamingRadius) + EvictionMargin;
+    const double KeepRadiusSquared = KeepRadius * KeepRadius;
+
+    for (auto It = LoadedChunks.CreateIterator(); It; ++It)
+    {
+        if (ViewshedBakedVisibility::ChunkDistanceSquared2D(It.Key(), ChunkSize, Center) > KeepRadiusSquared)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    QueuedLoads.RemoveAll([&](const FIntPoint &Key)
+                          { return ViewshedBakedVisibility::ChunkDistanceSquared2D(Key, ChunkSize, Center) > KeepRadiusSquared; });
+}
+
+/**
+ * Visibility of a target from an eye location, blended from the nearest loaded baked observers
+ */
+bool UCPP_Component__ViewshedBakedVisibility::GetBakedVisibility(FVector EyeLocation, FVector TargetLocation, float &OutVisibility) const
+{
+    OutVisibility = 0.0f;
+    if (!Database.IsValid())
+    {
+        return false;
+    }
+
+    TArray<FIntPoint> Keys;
+    GatherChunksInRadius(EyeLocation, InterpolationRadius, Keys);
+
+    // Keep the K nearest observers, sorted by ascending distance
+    struct FCandidate
+    {
+        const FS__ViewShedBakedObserver *Observer;
+        double DistanceSquared;
+    };
+    TArray<FCandidate, TInlineAllocator<8>> Nearest;
+    const int32 MaxCandidates = FMath::Clamp(InterpolationObserverCount, 1, 8);
+    const double RadiusSquared = double(InterpolationRadius) * InterpolationRadius;
+
+    for (const FIntPoint &Key : Keys)
+    {
+        const TArray<FS__ViewShedBakedObserver> *Chunk = LoadedChunks.Find(Key);
+        if (!Chunk)
+        {
+            continue;
+        }
+
+        for (const FS__ViewShedBakedObserver &Observer : *Chunk)
+        {
+            const double DistanceSquared = FVector::DistSquared(Observer.EyeLocation, EyeLocation);
+            if (DistanceSquared > RadiusSquared ||
+                (Nearest.Num() == MaxCandidates && DistanceSquared >= Nearest.Last().DistanceSquared))
+            {
+                continue;
+            }
+
+            int32 InsertAt = Nearest.Num();
+            while (InsertAt > 0 && Nearest[InsertAt - 1].DistanceSquared > DistanceSquared)
+            {
+                --InsertAt;
+            }
+            Nearest.Insert({&Observer, DistanceSquared}, InsertAt);
+            if (Nearest.Num() > MaxCandidates)
+            {
+                Nearest.Pop();
+            }
+        }
+    }
+
+    if (Nearest.IsEmpty())
+    {
+        return false;
+    }
+
+    // Inverse squared distance weights; an observer baked at the eye location decides alone
+    const FS__ViewShedHorizonLattice &Lattice = Database->GetLattice();
+    if (Nearest[0].DistanceSquared <= 1.0)
+    {
+        OutVisibility = Nearest[0].Observer->IsVisible(Lattice, TargetLocation) ? 1.0f : 0.0f;
+        return true;
+    }
+
+    double WeightSum = 0.0;
+    double VisibleWeight = 0.0;
+    for (const FCandidate &Candidate : Nearest)
+    {
+        const double Weight = 1.0 / Candidate.DistanceSquared;
+        WeightSum += Weight;
+        if (Candidate.Observer->IsVisible(Lattice, TargetLocation))
+        {
+            VisibleWeight += Weight;
+        }
+    }
+
+    OutVisibility = float(VisibleWeight / WeightSum);
+    return true;
+}
+
+/**
+ * Whether the blended visibility of a target is at least 0.5
+ */
+bool UCPP_Component__ViewshedBakedVisibility::IsTargetVisibleBaked(FVector EyeLocation, FVector TargetLocation) const
+{
+    float Visibility = 0.0f;
+    return GetBakedVisibility(EyeLocation, TargetLocation, Visibility) && Visibility >= 0.5f;
+}
@@ -0,0 +1,127 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Async/Future.h"
+#include "CPP_Struct__ViewshedBakeDatabase.h"
+#include "CPP_Component__ViewshedBakedVisibility.generated.h"
+
+/**
+ * Runtime access to a baked viewshed database (see UCPP_Commandlet__ViewshedBake)
+ * Streams database chunks around the local player on worker threads and answers visibility queries
+ * by blending the nearest baked observers, so baked positions cost no line traces at runtime
+ */
+UCLASS(ClassGroup = (ViewshedAnalysis), BlueprintType, Blueprintable, meta = (BlueprintSpawnableComponent))
+class P_VIEWSHEDANALYSIS_API UCPP_Component__ViewshedBakedVisibility : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    /** Constructor - enables ticking for chunk streaming */
+    UCPP_Component__ViewshedBakedVisibility();
+
+protected:
+    /** Open the database */
+    virtual void BeginPlay() override;
+
+    /** Drop loaded chunks */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+    /** Stream chunks around the player */
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+    //////////////////////////////////////////////////////////////////////////
+    // PROPERTIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Bake database written by the bake commandlet (relative paths are resolved against the project directory) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Visibility",
+              meta = (DisplayName = "Database File", FilePathFilter = "vsbk"))
+    FFilePath DatabaseFile;
+
+    /** Chunks whose area lies within this distance of the player are kept loaded */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Visibility",
+              meta = (DisplayName = "Streaming Radius", ClampMin = "0.0", UIMax = "100000.0"))
+    float StreamingRadius = 20000.0f;
+
+    /** Extra distance beyond the streaming radius before a loaded chunk is released (avoids load/unload thrashing) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Visibility",
+              meta = (DisplayName = "Eviction Margin", ClampMin = "0.0", UIMax = "50000.0"))
+    float EvictionMargin = 5000.0f;
+
+    /** Maximum chunk loads in flight at once */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Visibility",
+              meta = (DisplayName = "Max Concurrent Loads", ClampMin = "1", UIMax = "16"))
+    int32 MaxConcurrentLoads = 2;
+
+    /** Baked observers farther than this from the queried eye location are not blended */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Visibility",
+              meta = (DisplayName = "Interpolation Radius", ClampMin = "1.0", UIMax = "20000.0"))
+    float InterpolationRadius = 2000.0f;
+
+    /** Number of nearest baked observers blended per query */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Baked Visibility",
+              meta = (DisplayName = "Interpolation Observers", ClampMin = "1", ClampMax = "8"))
+    int32 InterpolationObserverCount = 4;
+
+    //////////////////////////////////////////////////////////////////////////
+    // QUERIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Visibility of a target from an eye location, blended from the nearest loaded baked observers
+     * Each baked observer contributes 1 (visible) or 0 (hidden) weighted by inverse squared distance to EyeLocation
+     * @param EyeLocation - Eye position to evaluate (actor location + observer height for viewshed actors)
+     * @param OutVisibility - Blended visibility in [0, 1]
+     * @return False if no baked observer near EyeLocation is loaded
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Baked")
+    bool GetBakedVisibility(FVector EyeLocation, FVector TargetLocation, float &OutVisibility) const;
+
+    /** Whether the blended visibility of a target is at least 0.5 (false when no baked data is loaded) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Baked")
+    bool IsTargetVisibleBaked(FVector EyeLocation, FVector TargetLocation) const;
+
+    /** Queue every chunk within Radius of Location for loading, independent of the player position */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Analysis|Baked")
+    void RequestChunksAround(FVector Location, float Radius);
+
+    /** Number of chunks currently resident */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Analysis|Baked")
+    int32 GetLoadedChunkCount() const { return LoadedChunks.Num(); }
+
+    /** Open database for native consumers (null until BeginPlay opens it) */
+    TSharedPtr<const FS__ViewShedBakeDatabase> GetDatabase() const { return Database; }
+
+private:
+    /** Location chunks are streamed around: the local player's view point, or the owner if there is none */
+    FVector GetStreamingCenter() const;
+
+    /** Keys of stored chunks whose XY area intersects the circle */
+    void GatherChunksInRadius(const FVector &Location, float Radius, TArray<FIntPoint> &OutKeys) const;
+
+    /** Start queued loads up to the concurrency limit and collect finished ones */
+    void PumpLoads();
+
+    /** Release chunks far from the streaming center */
+    void EvictDistantChunks(const FVector &Center);
+
+    /** Shared so in-flight loads keep it alive past EndPlay */
+    TSharedPtr<FS__ViewShedBakeDatabase> Database;
+
+    /** Resident chunks */
+    TMap<FIntPoint, TArray<FS__ViewShedBakedObserver>> LoadedChunks;
+
+    /** Loads running on worker threads */
+    TMap<FIntPoint, TFuture<TArray<FS__ViewShedBakedObserver>>> PendingLoads;
+
+    /** Chunks waiting for a load slot, nearest first */
+    TArray<FIntPoint> QueuedLoads;
+};
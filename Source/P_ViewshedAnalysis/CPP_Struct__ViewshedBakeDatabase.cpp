@@ -0,0 +1,326 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedBakeDatabase.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/**
+ * Serialized size of one observer record: eye location and rotation as doubles, then one quantized distance per direction
+ */
+static int64 GetBakedObserverRecordSize(int32 DirectionCount)
+{
+    return int64(3 + 4) * sizeof(double) + int64(DirectionCount) * sizeof(uint16);
+}
+
+/**
+ * Whether a chunk entry lies inside the file and its sizes agree with its observer count
+ * Checked before any buffer is sized from the entry, since the values come straight from disk
+ */
+static bool IsBakeChunkEntryValid(const FS__ViewShedBakeChunkEntry &Entry, int32 DirectionCount, int64 FileSize)
+{
+    // zlib cannot expand data by more than about 1032:1, so anything larger is corrupt
+    constexpr uint64 MaxZlibRatio = 1032;
+
+    return Entry.ObserverCount >= 0 && Entry.CompressedSize > 0 &&
+           Entry.Offset <= uint64(FileSize) && uint64(Entry.CompressedSize) <= uint64(FileSize) - Entry.Offset &&
+           int64(Entry.UncompressedSize) == int64(Entry.ObserverCount) * GetBakedObserverRecordSize(DirectionCount) &&
+           uint64(Entry.UncompressedSize) <= uint64(Entry.CompressedSize) * MaxZlibRatio;
+}
+
+/**
+ * Quantize a horizon map for storage
+ */
+void FS__ViewShedBakedObserver::SetHorizon(const FS__ViewShedHorizonMap &Horizon)
+{
+    const int32 DirectionCount = Horizon.IsBuilt() ? Horizon.Lattice.Num() : 0;
+    QuantizedOccluders.SetNumUninitialized(DirectionCount);
+
+    const float MaxDistance = FMath::Max(Horizon.Lattice.MaxDistance, KINDA_SMALL_NUMBER);
+    for (int32 i = 0; i < DirectionCount; ++i)
+    {
+        const float Distance = Horizon.GetOccluderDistance(i);
+        // Anything at or beyond range behaves like a clear ray
+        QuantizedOccluders[i] = Distance >= MaxDistance
+                                    ? QuantizedUnoccluded
+                                    : uint16(FMath::Clamp(FMath::FloorToInt32(Distance / MaxDistance * 65534.0f), 0, 65534));
+    }
+}
+
+/**
+ * Expand the quantized distances back into a horizon map
+ */
+void FS__ViewShedBakedObserver::GetHorizon(const FS__ViewShedHorizonLattice &Lattice, FS__ViewShedHorizonMap &OutHorizon) const
+{
+    OutHorizon.Initialize(Lattice, false, false);
+    if (!OutHorizon.IsBuilt() || QuantizedOccluders.Num() != Lattice.Num())
+    {
+        OutHorizon.Reset();
+        return;
+    }
+
+    for (int32 i = 0; i < QuantizedOccluders.Num(); ++i)
+    {
+        if (QuantizedOccluders[i] != QuantizedUnoccluded)
+        {
+            OutHorizon.SetOccluder(i, float(QuantizedOccluders[i]) / 65534.0f * Lattice.MaxDistance, FVector::ZeroVector);
+        }
+    }
+}
+
+/**
+ * Whether Target is visible from this observer
+ */
+bool FS__ViewShedBakedObserver::IsVisible(const FS__ViewShedHorizonLattice &Lattice, const FVector &Target, float Tolerance) const
+{
+    const FVector ToTarget = Target - EyeLocation;
+    const float Distance = float(ToTarget.Size());
+    if (Distance > Lattice.MaxDistance || QuantizedOccluders.Num() != Lattice.Num())
+    {
+        return false;
+    }
+
+    const int32 DirectionIndex = Lattice.FindDirectionIndex(Rotation.UnrotateVector(ToTarget));
+    if (DirectionIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const uint16 Quantized = QuantizedOccluders[DirectionIndex];
+    if (Quantized == QuantizedUnoccluded)
+    {
+        return true;
+    }
+
+    // Round the stored distance up by one quantization step so quantization never hides a visible target
+    const float OccluderDistance = float(Quantized + 1) / 65534.0f * Lattice.MaxDistance;
+    return Distance <= OccluderDistance + Tolerance;
+}
+
+/**
+ * Read the header and chunk index
+ */
+bool FS__ViewShedBakeDatabase::Open(const FString &InFilePath)
+{
+    Close();
+
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*InFilePath));
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+
+    // Header
+    const int64 FileSize = Handle->Size();
+    FS__ViewShedBakeDatabaseHeader FileHeader;
+    if (FileSize < int64(sizeof(FileHeader)) || !Handle->Read(reinterpret_cast<uint8 *>(&FileHeader), sizeof(FileHeader)))
+    {
+        return false;
+    }
+
+    if (FileHeader.Magic != FS__ViewShedBakeDatabaseHeader::FileMagic ||
+        FileHeader.Version != FS__ViewShedBakeDatabaseHeader::FileVersion ||
+        FileHeader.ChunkCount < 0 || FileHeader.ObserverCount < 0 || FileHeader.ChunkSize <= 0.0f ||
+        !(FileHeader.MaxDistance > 0.0f) || FileHeader.HorizontalSampleCount <= 0 || FileHeader.VerticalSampleCount <= 0 ||
+        int64(FileHeader.HorizontalSampleCount) * int64(FileHeader.VerticalSampleCount) > MAX_int32)
+    {
+        return false;
+    }
+    const int32 DirectionCount = FileHeader.HorizontalSampleCount * FileHeader.VerticalSampleCount;
+
+    // Chunk index; its size is checked against the file before anything is allocated for it
+    const int64 IndexSize = int64(FileHeader.ChunkCount) * int64(sizeof(FS__ViewShedBakeChunkEntry));
+    if (FileHeader.IndexOffset > uint64(FileSize) || IndexSize > FileSize - int64(FileHeader.IndexOffset))
+    {
+        return false;
+    }
+    TArray<FS__ViewShedBakeChunkEntry> Entries;
+    Entries.SetNumUninitialized(FileHeader.ChunkCount);
+    if (!Handle->Seek(int64(FileHeader.IndexOffset)) ||
+        !Handle->Read(reinterpret_cast<uint8 *>(Entries.GetData()), IndexSize))
+    {
+        return false;
+    }
+
+    for (const FS__ViewShedBakeChunkEntry &Entry : Entries)
+    {
+        // Reject entries pointing outside the file or whose sizes disagree with their observer count
+        if (!IsBakeChunkEntryValid(Entry, DirectionCount, FileSize))
+        {
+            ChunkIndex.Empty();
+            return false;
+        }
+        ChunkIndex.Add(Entry.Key, Entry);
+    }
+
+    Header = FileHeader;
+    Lattice.HorizontalSampleCount = Header.HorizontalSampleCount;
+    Lattice.VerticalSampleCount = Header.VerticalSampleCount;
+    Lattice.HalfHorizontalFOV = Header.HalfHorizontalFOV;
+    Lattice.HalfVerticalFOV = Header.HalfVerticalFOV;
+    Lattice.MaxDistance = Header.MaxDistance;
+    FilePath = InFilePath;
+    return true;
+}
+
+/**
+ * Forget the open file
+ */
+void FS__ViewShedBakeDatabase::Close()
+{
+    FilePath.Empty();
+    Header = FS__ViewShedBakeDatabaseHeader();
+    Lattice = FS__ViewShedHorizonLattice();
+    ChunkIndex.Empty();
+}
+
+/**
+ * Chunk coordinate containing a world location
+ */
+FIntPoint FS__ViewShedBakeDatabase::WorldToChunk(const FVector &Location) const
+{
+    const float ChunkSize = FMath::Max(Header.ChunkSize, 1.0f);
+    return FIntPoint(FMath::FloorToInt32(Location.X / ChunkSize), FMath::FloorToInt32(Location.Y / ChunkSize));
+}
+
+/**
+ * Read and decompress one chunk
+ */
+bool FS__ViewShedBakeDatabase::LoadChunk(const FIntPoint &Key, TArray<FS__ViewShedBakedObserver> &OutObservers) const
+{
+    OutObservers.Reset();
+
+    const FS__ViewShedBakeChunkEntry *Entry = ChunkIndex.Find(Key);
+    if (!Entry)
+    {
+        return false;
+    }
+
+    // Each load uses its own handle so chunks can stream on worker threads concurrently
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+
+    // The file may have been replaced since Open, so the entry is checked again before sizing buffers from it
+    const int32 DirectionCount = Lattice.Num();
+    if (!IsBakeChunkEntryValid(*Entry, DirectionCount, Handle->Size()))
+    {
+        return false;
+    }
+
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(Entry->CompressedSize);
+    if (!Handle->Seek(int64(Entry->Offset)) || !Handle->Read(Compressed.GetData(), Compressed.Num()))
+    {
+        return false;
+    }
+
+    TArray<uint8> Uncompressed;
+    Uncompressed.SetNumUninitialized(Entry->UncompressedSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), Uncompressed.Num(), Compressed.GetData(), Compressed.Num()))
+    {
+        return false;
+    }
+
+    // Observer records: eye location, rotation, one quantized distance per lattice direction
+    FMemoryReader Reader(Uncompressed);
+    OutObservers.SetNum(Entry->ObserverCount);
+    for (FS__ViewShedBakedObserver &Observer : OutObservers)
+    {
+        Reader << Observer.EyeLocation;
+        Reader << Observer.Rotation;
+        Observer.QuantizedOccluders.SetNumUninitialized(DirectionCount);
+        Reader.Serialize(Observer.QuantizedOccluders.GetData(), DirectionCount * sizeof(uint16));
+    }
+
+    if (Reader.IsError())
+    {
+        OutObservers.Reset();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Write a database, grouping observers into chunks by eye location
+ */
+bool FS__ViewShedBakeDatabase::Write(const FString &InFilePath, FS__ViewShedBakeDatabaseHeader InHeader, TConstArrayView<FS__ViewShedBakedObserver> Observers)
+{
+    InHeader.Magic = FS__ViewShedBakeDatabaseHeader::FileMagic;
+    InHeader.Version = FS__ViewShedBakeDatabaseHeader::FileVersion;
+    InHeader.ChunkSize = FMath::Max(InHeader.ChunkSize, 1.0f);
+    InHeader.ObserverCount = Observers.Num();
+
+    const int32 DirectionCount = InHeader.HorizontalSampleCount * InHeader.VerticalSampleCount;
+
+    // Group observers by chunk
+    TMap<FIntPoint, TArray<int32>> ChunkObservers;
+    for (int32 i = 0; i < Observers.Num(); ++i)
+    {
+        if (Observers[i].QuantizedOccluders.Num() != DirectionCount)
+        {
+            return false;
+        }
+        const FIntPoint Key(FMath::FloorToInt32(Observers[i].EyeLocation.X / InHeader.ChunkSize),
+                            FMath::FloorToInt32(Observers[i].EyeLocation.Y / InHeader.ChunkSize));
+        ChunkObservers.FindOrAdd(Key).Add(i);
+    }
+
+    TArray<uint8> Buffer;
+    Buffer.AddZeroed(sizeof(FS__ViewShedBakeDatabaseHeader));
+
+    TArray<FS__ViewShedBakeChunkEntry> Entries;
+    Entries.Reserve(ChunkObservers.Num());
+
+    TArray<uint8> Uncompressed;
+    TArray<uint8> Compressed;
+    for (const TPair<FIntPoint, TArray<int32>> &Chunk : ChunkObservers)
+    {
+        // Serialize the chunk's observer records
+        Uncompressed.Reset();
+        FMemoryWriter Writer(Uncompressed);
+        for (const int32 ObserverIndex : Chunk.Value)
+        {
+            const FS__ViewShedBakedObserver &Observer = Observers[ObserverIndex];
+            FVector EyeLocation = Observer.EyeLocation;
+            FQuat Rotation = Observer.Rotation;
+            Writer << EyeLocation;
+            Writer << Rotation;
+            // Saving archives only read from the buffer
+            Writer.Serialize(const_cast<uint16 *>(Observer.QuantizedOccluders.GetData()), DirectionCount * sizeof(uint16));
+        }
+
+        // Compress independently so chunks decompress on their own
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Uncompressed.Num());
+        Compressed.SetNumUninitialized(CompressedSize);
+        if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Uncompressed.GetData(), Uncompressed.Num()))
+        {
+            return false;
+        }
+
+        FS__ViewShedBakeChunkEntry &Entry = Entries.AddDefaulted_GetRef();
+        Entry.Key = Chunk.Key;
+        Entry.ObserverCount = Chunk.Value.Num();
+        Entry.UncompressedSize = uint32(Uncompressed.Num());
+        Entry.CompressedSize = uint32(CompressedSize);
+        Entry.Offset = uint64(Buffer.Num());
+        Buffer.Append(Compressed.GetData(), CompressedSize);
+    }
+
+    // Chunk index at the end so it can be written after the chunk sizes are known
+    InHeader.ChunkCount = Entries.Num();
+    InHeader.IndexOffset = uint64(Buffer.Num());
+    Buffer.Append(reinterpret_cast<const uint8 *>(Entries.GetData()), Entries.Num() * sizeof(FS__ViewShedBakeChunkEntry));
+
+    FMemory::Memcpy(Buffer.GetData(), &InHeader, sizeof(InHeader));
+    return FFileHelper::SaveArrayToFile(Buffer, *InFilePath);
+}
@@ -0,0 +1,153 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPP_Struct__ViewshedHorizonMap.h"
+
+/**
+ * One baked observer: its eye position and orientation plus a quantized horizon map
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedBakedObserver
+{
+    /** Quantized distance of a direction that reached no surface within range */
+    static constexpr uint16 QuantizedUnoccluded = MAX_uint16;
+
+    /** Eye location the rays were traced from (actor location + observer height) */
+    FVector EyeLocation = FVector::ZeroVector;
+
+    /** Observer orientation; lattice directions are relative to it */
+    FQuat Rotation = FQuat::Identity;
+
+    /** First-occluder distance per lattice direction, as a fraction of MaxDistance in [0, 65534] */
+    TArray<uint16> QuantizedOccluders;
+
+    /** Quantize a horizon map for storage */
+    void SetHorizon(const FS__ViewShedHorizonMap &Horizon);
+
+    /** Expand the quantized distances back into a horizon map on Lattice */
+    void GetHorizon(const FS__ViewShedHorizonLattice &Lattice, FS__ViewShedHorizonMap &OutHorizon) const;
+
+    /**
+     * Whether Target is visible from this observer
+     * @param Lattice - Lattice shared by every observer in the database
+     */
+    bool IsVisible(const FS__ViewShedHorizonLattice &Lattice, const FVector &Target, float Tolerance = 5.0f) const;
+};
+
+/**
+ * Fixed-size header of a bake database file
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedBakeDatabaseHeader
+{
+    /** File identifier and current layout version */
+    static constexpr uint32 FileMagic = 0x4B425356; // "VSBK"
+    static constexpr uint32 FileVersion = 1;
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+
+    /** Sampling configuration hash of the observer template (see ACPP_Actor__Viewshed::ComputeConfigHash) */
+    uint64 ConfigHash = 0;
+
+    /** Lattice shared by every baked observer */
+    int32 HorizontalSampleCount = 0;
+    int32 VerticalSampleCount = 0;
+    float HalfHorizontalFOV = 0.0f;
+    float HalfVerticalFOV = 0.0f;
+    float MaxDistance = 0.0f;
+
+    /** World XY size of one streaming chunk */
+    float ChunkSize = 0.0f;
+
+    /** Number of observers and chunks in the file */
+    int32 ObserverCount = 0;
+    int32 ChunkCount = 0;
+
+    /** Byte offset of the chunk index from the start of the file */
+    uint64 IndexOffset = 0;
+};
+static_assert(sizeof(FS__ViewShedBakeDatabaseHeader) == 56, "Bake database header is written as raw bytes and must not contain padding");
+
+/**
+ * Location of one compressed chunk inside a bake database file
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedBakeChunkEntry
+{
+    /** Chunk coordinate (world XY divided by ChunkSize) */
+    FIntPoint Key = FIntPoint::ZeroValue;
+
+    /** Observers stored in the chunk */
+    int32 ObserverCount = 0;
+
+    /** Byte size of the chunk before and after compression */
+    uint32 UncompressedSize = 0;
+    uint32 CompressedSize = 0;
+
+    /** Always zero; spells out the alignment gap before Offset so written entries carry no uninitialized bytes */
+    uint32 Reserved = 0;
+
+    /** Byte offset of the compressed chunk from the start of the file */
+    uint64 Offset = 0;
+};
+static_assert(sizeof(FS__ViewShedBakeChunkEntry) == 32, "Bake chunk entries are written as raw bytes and must not contain padding");
+
+/**
+ * Chunked, compressed database of baked observers
+ * Observers are grouped into square XY chunks that are compressed independently, so a runtime reader
+ * only keeps the header and chunk index resident and decompresses chunks near the player on demand.
+ * LoadChunk opens its own file handle and may be called from worker threads.
+ */
+class P_VIEWSHEDANALYSIS_API FS__ViewShedBakeDatabase
+{
+public:
+    /** Read the header and chunk index; returns false if missing, truncated or of another version */
+    bool Open(const FString &InFilePath);
+
+    /** Forget the open file */
+    void Close();
+
+    /** Whether a valid database is open */
+    bool IsOpen() const { return !FilePath.IsEmpty(); }
+
+    /** Validated file header */
+    const FS__ViewShedBakeDatabaseHeader &GetHeader() const { return Header; }
+
+    /** Lattice shared by every baked observer */
+    const FS__ViewShedHorizonLattice &GetLattice() const { return Lattice; }
+
+    /** Chunk coordinate containing a world location */
+    FIntPoint WorldToChunk(const FVector &Location) const;
+
+    /** Whether the database stores a chunk at Key */
+    bool HasChunk(const FIntPoint &Key) const { return ChunkIndex.Contains(Key); }
+
+    /** Keys of every stored chunk */
+    void GetChunkKeys(TArray<FIntPoint> &OutKeys) const { ChunkIndex.GenerateKeyArray(OutKeys); }
+
+    /** Read and decompress one chunk; thread safe */
+    bool LoadChunk(const FIntPoint &Key, TArray<FS__ViewShedBakedObserver> &OutObservers) const;
+
+    /**
+     * Write a database, grouping observers into chunks by eye location
+     * @param InHeader - Config hash, lattice and chunk size; counts and offsets are filled in
+     */
+    static bool Write(const FString &InFilePath, FS__ViewShedBakeDatabaseHeader InHeader, TConstArrayView<FS__ViewShedBakedObserver> Observers);
+
+private:
+    /** Path of the open file (empty when closed) */
+    FString FilePath;
+
+    /** Header read on Open */
+    FS__ViewShedBakeDatabaseHeader Header;
+
+    /** Lattice built from the header */
+    FS__ViewShedHorizonLattice Lattice;
+
+    /** Chunk locations keyed by chunk coordinate */
+    TMap<FIntPoint, FS__ViewShedBakeChunkEntry> ChunkIndex;
+};
@@ -0,0 +1,586 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedBlanketMesh.h"
+#include "CPP_Actor__Viewshed.h"
+#include "CPP_Struct__ViewshedSamplingPattern.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+
+const FLinearColor FS__ViewShedBlanketMesh::VisibleColor(0.0f, 1.0f, 0.0f, 1.0f);
+const FLinearColor FS__ViewShedBlanketMesh::HiddenColor(1.0f, 0.0f, 0.0f, 1.0f);
+
+/**
+ * Empty every buffer, keeping allocations for the next build
+ */
+void FS__ViewShedBlanketMesh::Reset()
+{
+    Vertices.Reset();
+    Triangles.Reset();
+    Normals.Reset();
+    UVs.Reset();
+    VertexColors.Reset();
+    Tangents.Reset();
+}
+
+/**
+ * Whether a result landed on a surface
+ */
+bool FS__ViewShedBlanketMesh::HasSurface(const FS__ViewShedPoint &Point)
+{
+    return (Point.HitActor != nullptr) || (!Point.HitNormal.IsNearlyZero());
+}
+
+/**
+ * Unit hit normal with fallbacks
+ */
+FVector FS__ViewShedBlanketMesh::GetSurfaceNormal(const FS__ViewShedPoint &Point, const FVector &ObserverLocation)
+{
+    // Choose surface normal from hit; fallback points back to observer
+    FVector SurfaceNormal = Point.HitNormal;
+    if (!SurfaceNormal.Normalize())
+    {
+        SurfaceNormal = (ObserverLocation - Point.HitLocation).GetSafeNormal();
+        if (!SurfaceNormal.Normalize())
+        {
+            SurfaceNormal = FVector::UpVector;
+        }
+    }
+    return SurfaceNormal;
+}
+
+/**
+ * Append one vertex with all its attributes
+ */
+void FS__ViewShedBlanketMesh::AddVertex(const FVector &Position, const FVector &Normal, const FVector2D &UV, const FLinearColor &Color, const FVector &TangentX)
+{
+    Vertices.Add(Position);
+    Normals.Add(Normal);
+    UVs.Add(UV);
+    VertexColors.Add(Color);
+    Tangents.Add(FProcMeshTangent(TangentX, false));
+}
+
+/**
+ * Size every vertex buffer without initializing it
+ */
+void FS__ViewShedBlanketMesh::SetVertexCount(int32 VertexCount)
+{
+    Vertices.SetNumUninitialized(VertexCount);
+    Normals.SetNumUninitialized(VertexCount);
+    UVs.SetNumUninitialized(VertexCount);
+    VertexColors.SetNumUninitialized(VertexCount);
+    Tangents.SetNumUninitialized(VertexCount);
+}
+
+/**
+ * Overwrite every attribute of an allocated vertex
+ */
+void FS__ViewShedBlanketMesh::WriteVertex(int32 Index, const FVector &Position, const FVector &Normal, const FVector2D &UV, const FLinearColor &Color, const FVector &TangentX)
+{
+    Vertices[Index] = Position;
+    Normals[Index] = Normal;
+    UVs[Index] = UV;
+    VertexColors[Index] = Color;
+    Tangents[Index] = FProcMeshTangent(TangentX, false);
+}
+
+/**
+ * Hash of the index buffer and vertex count
+ */
+uint64 FS__ViewShedBlanketMesh::ComputeTopologyHash() const
+{
+    return CityHash64WithSeed(reinterpret_cast<const char *>(Triangles.GetData()), Triangles.Num() * sizeof(int32), uint64(Vertices.Num()));
+}
+
+/**
+ * Append a single-sided quad oriented along Normal
+ */
+void FS__ViewShedBlanketMesh::AddQuad(const FVector (&Corners)[4], const FVector &Normal, const FLinearColor &Color)
+{
+    const FVector2D QuadUVs[4] = {
+        FVector2D(0.0f, 0.0f),
+        FVector2D(1.0f, 0.0f),
+        FVector2D(1.0f, 1.0f),
+        FVector2D(0.0f, 1.0f)};
+
+    FVector TangentDir = (Corners[1] - Corners[0]).GetSafeNormal();
+    if (TangentDir.IsNearlyZero())
+    {
+        TangentDir = FVector::ForwardVector;
+    }
+
+    const int32 BaseIndex = Vertices.Num();
+    for (int32 CornerIdx = 0; CornerIdx < 4; ++CornerIdx)
+    {
+        AddVertex(Corners[CornerIdx], Normal, QuadUVs[CornerIdx], Color, TangentDir);
+    }
+    AddOrientedTriangle(BaseIndex + 0, BaseIndex + 1, BaseIndex + 2);
+    AddOrientedTriangle(BaseIndex + 0, BaseIndex + 2, BaseIndex + 3);
+}
+
+/**
+ * Append a triangle facing along its vertices' normals
+ */
+void FS__ViewShedBlanketMesh::AddOrientedTriangle(int32 A, int32 B, int32 C)
+{
+    // Front faces are wound clockwise, so their edge cross product points away from the surface normal
+    const FVector EdgeCross = (Vertices[B] - Vertices[A]) ^ (Vertices[C] - Vertices[A]);
+    const FVector AverageNormal = Normals[A] + Normals[B] + Normals[C];
+    if ((EdgeCross | AverageNormal) > 0.0)
+    {
+        Swap(B, C);
+    }
+
+    Triangles.Add(A);
+    Triangles.Add(B);
+    Triangles.Add(C);
+}
+
+/**
+ * One double-sided quad per surface hit
+ */
+void FS__ViewShedBlanketMesh::BuildQuads(TConstArrayView<FS__ViewShedPoint> Points, const FVector &ObserverLocation, const FTransform &WorldToComponent,
+                                         float SurfaceOffset, float QuadHalfSize)
+{
+    Reset();
+
+    // Number the surface hits so every point knows where its 8 vertices and 12 indices go
+    PointSlots.SetNumUninitialized(Points.Num());
+    int32 QuadCount = 0;
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        PointSlots[i] = HasSurface(Points[i]) ? QuadCount++ : INDEX_NONE;
+    }
+
+    SetVertexCount(QuadCount * 8);
+    Triangles.SetNumUninitialized(QuadCount * 12);
+
+    const FVector2D QuadUVs[4] = {
+        FVector2D(1.0f, 1.0f),
+        FVector2D(0.0f, 1.0f),
+        FVector2D(0.0f, 0.0f),
+        FVector2D(1.0f, 0.0f)};
+
+    // Quads are independent, so each point fills its own slice of the buffers
+    ParallelFor(Points.Num(), [&](int32 PointIndex)
+                {
+        const int32 QuadIndex = PointSlots[PointIndex];
+        if (QuadIndex == INDEX_NONE)
+        {
+            return;
+        }
+        const FS__ViewShedPoint &Point = Points[PointIndex];
+
+        const FVector SurfaceNormal = GetSurfaceNormal(Point, ObserverLocation);
+
+        // Lift slightly off the surface along the surface normal
+        const FVector BaseWorldPosition = Point.HitLocation + SurfaceNormal * SurfaceOffset;
+
+        // Build a tangent frame on the surface
+        FVector TangentX, TangentY;
+        SurfaceNormal.FindBestAxisVectors(TangentX, TangentY);
+        const FVector TangentDir = TangentX.GetSafeNormal();
+        TangentX = TangentX.GetSafeNormal() * QuadHalfSize;
+        TangentY = TangentY.GetSafeNormal() * QuadHalfSize;
+
+        FVector LocalNormal = WorldToComponent.TransformVectorNoScale(SurfaceNormal).GetSafeNormal();
+        if (LocalNormal.IsNearlyZero())
+        {
+            LocalNormal = FVector::UpVector;
+        }
+
+        FVector LocalTangentDir = WorldToComponent.TransformVectorNoScale(TangentDir).GetSafeNormal();
+        if (LocalTangentDir.IsNearlyZero())
+        {
+            LocalTangentDir = FVector::ForwardVector;
+        }
+
+        const FVector OffsetCorners[4] = {
+            TangentX + TangentY,
+            -TangentX + TangentY,
+            -TangentX - TangentY,
+            TangentX - TangentY};
+
+        const FLinearColor &Color = Point.bIsVisible ? VisibleColor : HiddenColor;
+
+        const int32 FrontBaseIndex = QuadIndex * 8;
+        const int32 BackBaseIndex = FrontBaseIndex + 4;
+        for (int32 CornerIdx = 0; CornerIdx < 4; ++CornerIdx)
+        {
+            const FVector LocalPosition = WorldToComponent.TransformPosition(BaseWorldPosition + OffsetCorners[CornerIdx]);
+            WriteVertex(FrontBaseIndex + CornerIdx, LocalPosition, LocalNormal, QuadUVs[CornerIdx], Color, LocalTangentDir);
+            WriteVertex(BackBaseIndex + CornerIdx, LocalPosition, -LocalNormal, QuadUVs[CornerIdx], Color, -LocalTangentDir);
+        }
+
+        // Front face, then back face with reversed winding
+        const int32 QuadIndices[12] = {
+            FrontBaseIndex + 0, FrontBaseIndex + 1, FrontBaseIndex + 2,
+            FrontBaseIndex + 0, FrontBaseIndex + 2, FrontBaseIndex + 3,
+            BackBaseIndex + 0, BackBaseIndex + 2, BackBaseIndex + 1,
+            BackBaseIndex + 0, BackBaseIndex + 3, BackBaseIndex + 2};
+        FMemory::Memcpy(&Triangles[QuadIndex * 12], QuadIndices, sizeof(QuadIndices)); });
+}
+
+/**
+ * One vertex per surface hit, triangulated across each band's sample lattice
+ */
+void FS__ViewShedBlanketMesh::BuildGrid(TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays, const FVector &ObserverLocation,
+                                        const FTransform &WorldToComponent, float SurfaceOffset, float ContinuityTolerance)
+{
+    Reset();
+
+    if (Points.Num() != Rays.Num() || Rays.IsEmpty())
+    {
+        return;
+    }
+
+    const int32 HorizontalCount = Rays.HorizontalSampleCount;
+    const int32 VerticalCount = Rays.VerticalSampleCount;
+
+    // Band sub-lattice slot -> vertex index, numbered serially so the attribute pass below can run in parallel
+    TArray<int32> SlotVertices;
+    SlotVertices.Init(INDEX_NONE, Rays.Num());
+    PointSlots.SetNumUninitialized(Points.Num());
+    int32 VertexCount = 0;
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        PointSlots[i] = INDEX_NONE;
+        if (!HasSurface(Points[i]))
+        {
+            continue;
+        }
+
+        const int32 Slot = Rays.GetBandSlot(i);
+        if (SlotVertices[Slot] == INDEX_NONE)
+        {
+            SlotVertices[Slot] = VertexCount;
+            PointSlots[i] = VertexCount++;
+        }
+    }
+
+    SetVertexCount(VertexCount);
+    // Each vertex's hit distance for the continuity test
+    TArray<float> VertexDistances;
+    VertexDistances.SetNumUninitialized(VertexCount);
+
+    const float HorizontalUVScale = HorizontalCount > 1 ? 1.0f / float(HorizontalCount - 1) : 0.0f;
+    const float VerticalUVScale = VerticalCount > 1 ? 1.0f / float(VerticalCount - 1) : 0.0f;
+
+    ParallelFor(Points.Num(), [&](int32 PointIndex)
+                {
+        const int32 VertexIndex = PointSlots[PointIndex];
+        if (VertexIndex == INDEX_NONE)
+        {
+            return;
+        }
+        const FS__ViewShedPoint &Point = Points[PointIndex];
+        int32 BandIndex = 0;
+        int32 HorizontalIndex = 0;
+        int32 VerticalIndex = 0;
+        Rays.GetRayCoordinates(PointIndex, BandIndex, HorizontalIndex, VerticalIndex);
+
+        const FVector SurfaceNormal = GetSurfaceNormal(Point, ObserverLocation);
+        FVector TangentX, TangentY;
+        SurfaceNormal.FindBestAxisVectors(TangentX, TangentY);
+
+        FVector LocalNormal = WorldToComponent.TransformVectorNoScale(SurfaceNormal).GetSafeNormal();
+        if (LocalNormal.IsNearlyZero())
+        {
+            LocalNormal = FVector::UpVector;
+        }
+
+        FVector LocalTangentDir = WorldToComponent.TransformVectorNoScale(TangentX).GetSafeNormal();
+        if (LocalTangentDir.IsNearlyZero())
+        {
+            LocalTangentDir = FVector::ForwardVector;
+        }
+
+        // Pattern samples are spread over the field of view like the grid's, just not on rows and columns
+        const FVector2D UV = Rays.Pattern ? Rays.Pattern->GetNormalizedPosition(HorizontalIndex) : FVector2D(HorizontalIndex * HorizontalUVScale, VerticalIndex * VerticalUVScale);
+
+        VertexDistances[VertexIndex] = float(FVector::Dist(ObserverLocation, Point.HitLocation));
+        WriteVertex(VertexIndex, WorldToComponent.TransformPosition(Point.HitLocation + SurfaceNormal * SurfaceOffset), LocalNormal, UV,
+                    Point.bIsVisible ? VisibleColor : HiddenColor, LocalTangentDir); });
+
+    // A triangle bridges only samples on the same surface: their hit distances must stay within the tolerance
+    const float Tolerance = FMath::Max(0.0f, ContinuityTolerance);
+    const auto IsContinuous = [&VertexDistances, Tolerance](int32 A, int32 B, int32 C)
+    {
+        if (A == INDEX_NONE || B == INDEX_NONE || C == INDEX_NONE)
+        {
+            return false;
+        }
+        const float Nearest = FMath::Min3(VertexDistances[A], VertexDistances[B], VertexDistances[C]);
+        const float Farthest = FMath::Max3(VertexDistances[A], VertexDistances[B], VertexDistances[C]);
+        return Farthest - Nearest <= Nearest * Tolerance;
+    };
+
+    // A pattern's own triangulation is reused in every band; each band is one row of the pattern's samples
+    if (Rays.Pattern)
+    {
+        Triangles.Reserve(Rays.Pattern->Triangles.Num() * Rays.Bands.Num() * 3);
+        for (const FS__ViewShedRayBand &Band : Rays.Bands)
+        {
+            for (const FIntVector &Triangle : Rays.Pattern->Triangles)
+            {
+                const int32 A = SlotVertices[Band.FirstRay + Triangle.X];
+                const int32 B = SlotVertices[Band.FirstRay + Triangle.Y];
+                const int32 C = SlotVertices[Band.FirstRay + Triangle.Z];
+                if (IsContinuous(A, B, C))
+                {
+                    AddOrientedTriangle(A, B, C);
+                }
+            }
+        }
+        return;
+    }
+
+    // Neighbours are taken within each band's own sub-lattice, so bands sampled at a coarser stride still triangulate
+    Triangles.Reserve(Vertices.Num() * 6);
+    for (const FS__ViewShedRayBand &Band : Rays.Bands)
+    {
+        const int32 ColumnCount = Band.ColumnCount;
+        for (int32 V = 0; V + 1 < Band.RowCount; ++V)
+        {
+            const int32 RowStart = Band.FirstRay + V * ColumnCount;
+            for (int32 H = 0; H + 1 < ColumnCount; ++H)
+            {
+                const int32 V00 = SlotVertices[RowStart + H];
+                const int32 V10 = SlotVertices[RowStart + H + 1];
+                const int32 V01 = SlotVertices[RowStart + ColumnCount + H];
+                const int32 V11 = SlotVertices[RowStart + ColumnCount + H + 1];
+
+                // Split along whichever diagonal has both ends, so a cell missing one corner still gets a triangle
+                if (V00 != INDEX_NONE && V11 != INDEX_NONE)
+                {
+                    if (IsContinuous(V00, V10, V11))
+                    {
+                        AddOrientedTriangle(V00, V10, V11);
+                    }
+                    if (IsContinuous(V00, V11, V01))
+                    {
+                        AddOrientedTriangle(V00, V11, V01);
+                    }
+                }
+                else
+                {
+                    if (IsContinuous(V00, V10, V01))
+                    {
+                        AddOrientedTriangle(V00, V10, V01);
+                    }
+                    if (IsContinuous(V10, V11, V01))
+                    {
+                        AddOrientedTriangle(V10, V11, V01);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Greedy merge of uniform, near-coplanar lattice rectangles into single quads
+ */
+void FS__ViewShedBlanketMesh::BuildMerged(TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays, const FS__ViewShedHorizonLattice &Lattice,
+                                          const FVector &ObserverLocation, const FQuat &ObserverRotation, const FTransform &WorldToComponent, float SurfaceOffset,
+                                          float QuadHalfSize, float BaseToleranceDegrees, float BandToleranceGrowth)
+{
+    Reset();
+
+    const int32 BandCount = Rays.BandCount;
+    const int32 HorizontalCount = Rays.HorizontalSampleCount;
+    const int32 VerticalCount = Rays.VerticalSampleCount;
+    if (Points.Num() != Rays.Num() || Rays.IsEmpty() ||
+        HorizontalCount != Lattice.HorizontalSampleCount || VerticalCount != Lattice.VerticalSampleCount)
+    {
+        return;
+    }
+
+    // Band sub-lattice slot -> point index of every surface hit, and that hit's unit normal
+    TArray<int32> SlotPoints;
+    SlotPoints.Init(INDEX_NONE, Rays.Num());
+    TArray<FVector> SurfaceNormals;
+    SurfaceNormals.SetNumUninitialized(Points.Num());
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        if (!HasSurface(Points[i]))
+        {
+            continue;
+        }
+        const int32 Slot = Rays.GetBandSlot(i);
+        if (SlotPoints[Slot] == INDEX_NONE)
+        {
+            SlotPoints[Slot] = i;
+            SurfaceNormals[i] = GetSurfaceNormal(Points[i], ObserverLocation);
+        }
+    }
+
+    TBitArray<> Consumed(false, SlotPoints.Num());
+
+    for (int32 Band = 0; Band < BandCount; ++Band)
+    {
+        // Far bands cover more ground per sample, so they tolerate more deviation before a rectangle is split
+        const float ToleranceDegrees = FMath::Clamp(BaseToleranceDegrees * (1.0f + FMath::Max(0.0f, BandToleranceGrowth) * Band), 0.0f, 45.0f);
+        const float CosTolerance = FMath::Cos(FMath::DegreesToRadians(ToleranceDegrees));
+        const float SinTolerance = FMath::Sin(FMath::DegreesToRadians(ToleranceDegrees));
+        const FS__ViewShedRayBand &RayBand = Rays.Bands[Band];
+        const int32 BandStart = RayBand.FirstRay;
+        const int32 ColumnCount = RayBand.ColumnCount;
+        const int32 RowCount = RayBand.RowCount;
+
+        // Sub-lattice cell edges as lattice positions: halfway between neighbouring samples, half a sample beyond the outer ones
+        const auto ColumnEdge = [&](int32 Column)
+        {
+            return Column <= 0 ? -0.5f : Column >= ColumnCount ? float(HorizontalCount) - 0.5f : 0.5f * float(Rays.GetLatticeColumn(Band, Column - 1) + Rays.GetLatticeColumn(Band, Column));
+        };
+        const auto RowEdge = [&](int32 Row)
+        {
+            return Row <= 0 ? -0.5f : Row >= RowCount ? float(VerticalCount) - 0.5f : 0.5f * float(Rays.GetLatticeRow(Band, Row - 1) + Rays.GetLatticeRow(Band, Row));
+        };
+
+        for (int32 V0 = 0; V0 < RowCount; ++V0)
+        {
+            for (int32 H0 = 0; H0 < ColumnCount; ++H0)
+            {
+                const int32 SeedSlot = BandStart + V0 * ColumnCount + H0;
+                const int32 SeedIndex = SlotPoints[SeedSlot];
+                if (SeedIndex == INDEX_NONE || Consumed[SeedSlot])
+                {
+                    continue;
+                }
+
+                const FS__ViewShedPoint &Seed = Points[SeedIndex];
+                const FVector &SeedNormal = SurfaceNormals[SeedIndex];
+
+                // Same state, normals within tolerance and the sample no further off the seed plane than the tolerance angle
+                const auto CanMerge = [&](int32 H, int32 V)
+                {
+                    const int32 Slot = BandStart + V * ColumnCount + H;
+                    const int32 Index = SlotPoints[Slot];
+                    if (Index == INDEX_NONE || Consumed[Slot] || Points[Index].bIsVisible != Seed.bIsVisible)
+                    {
+                        return false;
+                    }
+                    if ((SurfaceNormals[Index] | SeedNormal) < CosTolerance)
+                    {
+                        return false;
+                    }
+                    const FVector Offset = Points[Index].HitLocation - Seed.HitLocation;
+                    return FMath::Abs(Offset | SeedNormal) <= Offset.Size() * SinTolerance;
+                };
+
+                // Grow along the row first, then add whole rows while every cell qualifies
+                int32 H1 = H0;
+                while (H1 + 1 < ColumnCount && CanMerge(H1 + 1, V0))
+                {
+                    ++H1;
+                }
+                int32 V1 = V0;
+                while (V1 + 1 < RowCount)
+                {
+                    bool bRowMerges = true;
+                    for (int32 H = H0; H <= H1 && bRowMerges; ++H)
+                    {
+                        bRowMerges = CanMerge(H, V1 + 1);
+                    }
+                    if (!bRowMerges)
+                    {
+                        break;
+                    }
+                    ++V1;
+                }
+                for (int32 V = V0; V <= V1; ++V)
+                {
+                    Consumed.SetRange(BandStart + V * ColumnCount + H0, H1 - H0 + 1, true);
+                }
+
+                // Cast the rectangle's outer sample edges onto the seed's lifted surface plane
+                const FVector PlanePoint = Seed.HitLocation + SeedNormal * SurfaceOffset;
+                const float CornerPositions[4][2] = {
+                    {ColumnEdge(H0), RowEdge(V0)},
+                    {ColumnEdge(H1 + 1), RowEdge(V0)},
+                    {ColumnEdge(H1 + 1), RowEdge(V1 + 1)},
+                    {ColumnEdge(H0), RowEdge(V1 + 1)}};
+                const float SeedDistance = float(FVector::Dist(ObserverLocation, PlanePoint));
+                FVector Corners[4];
+                bool bCornersValid = true;
+                for (int32 CornerIdx = 0; CornerIdx < 4 && bCornersValid; ++CornerIdx)
+                {
+                    const FVector Direction = ObserverRotation.RotateVector(Lattice.GetLocalDirectionAt(CornerPositions[CornerIdx][0], CornerPositions[CornerIdx][1]));
+                    const float Facing = float(Direction | SeedNormal);
+                    const float RayDistance = FMath::Abs(Facing) > 0.05f ? float((PlanePoint - ObserverLocation) | SeedNormal) / Facing : -1.0f;
+                    // Edge-on planes would throw corners towards infinity
+                    bCornersValid = RayDistance > 0.0f && RayDistance < SeedDistance * 4.0f;
+                    Corners[CornerIdx] = WorldToComponent.TransformPosition(ObserverLocation + Direction * RayDistance);
+                }
+
+                const FLinearColor &Color = Seed.bIsVisible ? VisibleColor : HiddenColor;
+                FVector LocalNormal = WorldToComponent.TransformVectorNoScale(SeedNormal).GetSafeNormal();
+                if (LocalNormal.IsNearlyZero())
+                {
+                    LocalNormal = FVector::UpVector;
+                }
+
+                if (bCornersValid)
+                {
+                    AddQuad(Corners, LocalNormal, Color);
+                    continue;
+                }
+
+                // Seen edge-on: fall back to a tangent-plane quad per sample of the rectangle
+                for (int32 V = V0; V <= V1; ++V)
+                {
+                    for (int32 H = H0; H <= H1; ++H)
+                    {
+                        const int32 Index = SlotPoints[BandStart + V * ColumnCount + H];
+                        const FVector &Normal = SurfaceNormals[Index];
+                        FVector TangentX, TangentY;
+                        Normal.FindBestAxisVectors(TangentX, TangentY);
+                        TangentX *= QuadHalfSize;
+                        TangentY *= QuadHalfSize;
+                        const FVector Base = Points[Index].HitLocation + Normal * SurfaceOffset;
+                        const FVector SampleCorners[4] = {
+                            WorldToComponent.TransformPosition(Base + TangentX + TangentY),
+                            WorldToComponent.TransformPosition(Base - TangentX + TangentY),
+                            WorldToComponent.TransformPosition(Base - TangentX - TangentY),
+                            WorldToComponent.TransformPosition(Base + TangentX - TangentY)};
+                        AddQuad(SampleCorners, WorldToComponent.TransformVectorNoScale(Normal).GetSafeNormal(), Color);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Release the input copies and output buffers
+ */
+FS__ViewShedBlanketBuild::~FS__ViewShedBlanketBuild() = default;
+
+/**
+ * Build the mesh for the captured inputs
+ */
+void FS__ViewShedBlanketBuild::Execute()
+{
+    // Grid and merged meshes need each result's lattice indices; results without matching rays fall back to quads.
+    // Pattern samples have no rectangles to merge, so merged mode triangulates them like the grid mode
+    const bool bHasLattice = !Rays.IsEmpty() && Rays.Num() == Points.Num();
+    if (bHasLattice && (Mode == E__ViewShedBlanketMode::Grid || (Mode == E__ViewShedBlanketMode::Merged && Rays.Pattern)))
+    {
+        Mesh.BuildGrid(Points, Rays, ObserverLocation, WorldToComponent, SurfaceOffset, GridContinuity);
+    }
+    else if (Mode == E__ViewShedBlanketMode::Merged && bHasLattice)
+    {
+        Mesh.BuildMerged(Points, Rays, Lattice, ObserverLocation, ObserverRotation, WorldToComponent, SurfaceOffset,
+                         QuadHalfSize, MergeToleranceDegrees, MergeBandGrowth);
+    }
+    else
+    {
+        Mesh.BuildQuads(Points, ObserverLocation, WorldToComponent, SurfaceOffset, QuadHalfSize);
+    }
+    TopologyHash = Mesh.ComputeTopologyHash();
+}
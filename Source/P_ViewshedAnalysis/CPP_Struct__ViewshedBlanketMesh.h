@@ -0,0 +1,140 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "CPP_Struct__ViewshedHorizonMap.h"
+#include "CPP_Struct__ViewshedRayStore.h"
+
+struct FS__ViewShedPoint;
+enum class E__ViewShedBlanketMode : uint8;
+
+/**
+ * Section buffers of the visible blanket, laid out for UProceduralMeshComponent
+ * Built purely from analysis results (no UObject access), in component space
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedBlanketMesh
+{
+    /** Vertex colors of visible and hidden surface hits */
+    static const FLinearColor VisibleColor;
+    static const FLinearColor HiddenColor;
+
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    TArray<FVector> Normals;
+    TArray<FVector2D> UVs;
+    TArray<FLinearColor> VertexColors;
+    TArray<FProcMeshTangent> Tangents;
+
+    /** Empty every buffer, keeping allocations for the next build */
+    void Reset();
+
+    /** Whether there is anything to upload */
+    bool IsEmpty() const { return Triangles.IsEmpty() || Vertices.IsEmpty(); }
+
+    /** Hash of the index buffer and vertex count; equal hashes mean a section can be updated in place */
+    uint64 ComputeTopologyHash() const;
+
+    /**
+     * One double-sided quad per surface hit: 8 vertices and 4 triangles, nothing shared between neighbours
+     * @param SurfaceOffset - Lift along the surface normal
+     * @param QuadHalfSize - Half edge length of every quad
+     */
+    void BuildQuads(TConstArrayView<FS__ViewShedPoint> Points, const FVector &ObserverLocation, const FTransform &WorldToComponent,
+                    float SurfaceOffset, float QuadHalfSize);
+
+    /**
+     * One vertex per surface hit, triangulated between neighbouring samples of the same band's (sub-)lattice
+     * Triangles are only emitted where the corner hit distances are continuous, so silhouettes stay open.
+     * Faces are single-sided and wound towards their surface normal; use a two-sided material to see both sides.
+     * @param Rays - Rays of the points (same length and order as Points), providing each point's lattice indices
+     * @param ContinuityTolerance - Largest hit distance spread across a triangle, as a fraction of its nearest corner
+     */
+    void BuildGrid(TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays, const FVector &ObserverLocation,
+                   const FTransform &WorldToComponent, float SurfaceOffset, float ContinuityTolerance);
+
+    /**
+     * Greedy merge of each band's lattice into rectangles of samples sharing a visibility state and a near-coplanar
+     * surface, one single-sided quad per rectangle. Quad corners are the rays through the rectangle's outer sample
+     * edges, intersected with the seed sample's lifted surface plane, so neighbouring quads tile without gaps.
+     * @param Lattice - Angular lattice the samples were generated on
+     * @param ObserverRotation - Rotation taking lattice-local directions to world space
+     * @param QuadHalfSize - Half edge length of the fallback quad used where the plane is seen edge-on
+     * @param BaseToleranceDegrees - Largest normal and plane deviation merged in the nearest band
+     * @param BandToleranceGrowth - Fractional tolerance increase per distance band
+     */
+    void BuildMerged(TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays, const FS__ViewShedHorizonLattice &Lattice,
+                     const FVector &ObserverLocation, const FQuat &ObserverRotation, const FTransform &WorldToComponent, float SurfaceOffset,
+                     float QuadHalfSize, float BaseToleranceDegrees, float BandToleranceGrowth);
+
+    /** Size every vertex buffer without initializing it */
+    void SetVertexCount(int32 VertexCount);
+
+    /** Overwrite every attribute of an allocated vertex; safe from parallel workers writing distinct indices */
+    void WriteVertex(int32 Index, const FVector &Position, const FVector &Normal, const FVector2D &UV, const FLinearColor &Color, const FVector &TangentX);
+
+    /** Whether a result landed on a surface (visible or occluded) and should carry geometry */
+    static bool HasSurface(const FS__ViewShedPoint &Point);
+
+    /** Unit hit normal, falling back to the direction back to the observer */
+    static FVector GetSurfaceNormal(const FS__ViewShedPoint &Point, const FVector &ObserverLocation);
+
+private:
+    /** Append a single-sided quad from four corners in winding order and orient it along Normal */
+    void AddQuad(const FVector (&Corners)[4], const FVector &Normal, const FLinearColor &Color);
+
+    /** Append one vertex with all its attributes */
+    void AddVertex(const FVector &Position, const FVector &Normal, const FVector2D &UV, const FLinearColor &Color, const FVector &TangentX);
+
+    /** Append a triangle, flipping it if needed so it faces along its vertices' normals */
+    void AddOrientedTriangle(int32 A, int32 B, int32 C);
+
+    /** Per-point output slot (quad or vertex index), reused between builds */
+    TArray<int32> PointSlots;
+};
+
+/**
+ * One off-game-thread blanket build: a snapshot of the inputs and the resulting buffers
+ * The owner keeps a single instance alive across rebuilds so every input and output allocation is reused,
+ * and must not touch it while Execute runs on a worker.
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedBlanketBuild
+{
+    ~FS__ViewShedBlanketBuild();
+
+    /** Geometry to build */
+    E__ViewShedBlanketMode Mode{};
+
+    /** Results and their rays (rays may be empty for Quads) */
+    TArray<FS__ViewShedPoint> Points;
+    FS__ViewShedRayStore Rays;
+
+    /** Observer frame and sampling lattice */
+    FS__ViewShedHorizonLattice Lattice;
+    FVector ObserverLocation = FVector::ZeroVector;
+    FQuat ObserverRotation = FQuat::Identity;
+
+    /** Inverse transform of the target component at snapshot time */
+    FTransform WorldToComponent = FTransform::Identity;
+
+    /** Blanket settings (see the matching ACPP_Actor__Viewshed properties) */
+    float SurfaceOffset = 0.0f;
+    float QuadHalfSize = 1.0f;
+    float GridContinuity = 0.0f;
+    float MergeToleranceDegrees = 0.0f;
+    float MergeBandGrowth = 0.0f;
+
+    /** Output buffers */
+    FS__ViewShedBlanketMesh Mesh;
+
+    /** Topology hash of Mesh after Execute */
+    uint64 TopologyHash = 0;
+
+    /** Build Mesh from the captured inputs (worker thread) */
+    void Execute();
+};
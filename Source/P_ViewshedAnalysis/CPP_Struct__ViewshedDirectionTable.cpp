@@ -0,0 +1,141 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedDirectionTable.h"
+#include "Misc/ScopeLock.h"
+
+namespace ViewshedDirectionTable
+{
+    /** Lattice key: sample counts and half FOVs */
+    using FKey = TTuple<int32, int32, float, float>;
+
+    /** Live tables; entries expire with their last holder */
+    static TMap<FKey, TWeakPtr<const FS__ViewShedDirectionTable>> Tables;
+    static FCriticalSection TablesLock;
+}
+
+/**
+ * Shared table for a lattice
+ */
+TSharedRef<const FS__ViewShedDirectionTable> FS__ViewShedDirectionTable::Find(int32 InHorizontalSampleCount, int32 InVerticalSampleCount, float InHalfHorizontalFOV, float InHalfVerticalFOV)
+{
+    using namespace ViewshedDirectionTable;
+    const FKey Key(FMath::Max(0, InHorizontalSampleCount), FMath::Max(0, InVerticalSampleCount), InHalfHorizontalFOV, InHalfVerticalFOV);
+
+    FScopeLock Lock(&TablesLock);
+    if (const TWeakPtr<const FS__ViewShedDirectionTable> *Existing = Tables.Find(Key))
+    {
+        if (TSharedPtr<const FS__ViewShedDirectionTable> Table = Existing->Pin())
+        {
+            return Table.ToSharedRef();
+        }
+    }
+
+    // Drop expired entries while the lock is held anyway, so the map stays as small as the set of live configs
+    for (auto It = Tables.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TSharedRef<FS__ViewShedDirectionTable> Table = MakeShared<FS__ViewShedDirectionTable>();
+    Table->HorizontalSampleCount = Key.Get<0>();
+    Table->VerticalSampleCount = Key.Get<1>();
+    Table->HalfHorizontalFOV = InHalfHorizontalFOV;
+    Table->HalfVerticalFOV = InHalfVerticalFOV;
+    Table->Build();
+    Tables.Add(Key, Table);
+    return Table;
+}
+
+/**
+ * Fill the components for the lattice fields
+ */
+void FS__ViewShedDirectionTable::Build()
+{
+    const int32 PaddedNum = Align(Num(), 4);
+    X.SetNumZeroed(PaddedNum);
+    Y.SetNumZeroed(PaddedNum);
+    Z.SetNumZeroed(PaddedNum);
+
+    // Angles are spread exactly as in FS__ViewShedHorizonLattice::GetLocalDirectionAt (a single sample sits mid-FOV)
+    const auto SampleAngle = [](int32 Index, int32 Count, float HalfFOV)
+    {
+        const float Alpha = Count <= 1 ? 0.5f : float(Index) / float(Count - 1);
+        return FMath::Lerp(-HalfFOV, HalfFOV, Alpha);
+    };
+
+    // Yaw and pitch are separable, so each sine/cosine is evaluated once per column or row
+    TArray<float> CosHorizontal, SinHorizontal;
+    CosHorizontal.SetNumUninitialized(HorizontalSampleCount);
+    SinHorizontal.SetNumUninitialized(HorizontalSampleCount);
+    for (int32 HorizontalIndex = 0; HorizontalIndex < HorizontalSampleCount; ++HorizontalIndex)
+    {
+        FMath::SinCos(&SinHorizontal[HorizontalIndex], &CosHorizontal[HorizontalIndex], SampleAngle(HorizontalIndex, HorizontalSampleCount, HalfHorizontalFOV));
+    }
+
+    for (int32 VerticalIndex = 0; VerticalIndex < VerticalSampleCount; ++VerticalIndex)
+    {
+        float SinVertical = 0.0f;
+        float CosVertical = 1.0f;
+        FMath::SinCos(&SinVertical, &CosVertical, SampleAngle(VerticalIndex, VerticalSampleCount, HalfVerticalFOV));
+
+        // A positive pitch points down
+        const int32 RowStart = VerticalIndex * HorizontalSampleCount;
+        for (int32 HorizontalIndex = 0; HorizontalIndex < HorizontalSampleCount; ++HorizontalIndex)
+        {
+            X[RowStart + HorizontalIndex] = CosVertical * CosHorizontal[HorizontalIndex];
+            Y[RowStart + HorizontalIndex] = CosVertical * SinHorizontal[HorizontalIndex];
+            Z[RowStart + HorizontalIndex] = -SinVertical;
+        }
+    }
+}
+
+/**
+ * Rotate every direction into a world frame
+ */
+void FS__ViewShedDirectionTable::Transform(const FVector &Forward, const FVector &Right, const FVector &Up, TArray<FVector> &OutDirections) const
+{
+    OutDirections.SetNumUninitialized(Num());
+
+    // World = Forward * x + Right * y + Up * z, one matrix column per broadcast register
+    const VectorRegister4Float ForwardX = VectorSetFloat1(float(Forward.X));
+    const VectorRegister4Float ForwardY = VectorSetFloat1(float(Forward.Y));
+    const VectorRegister4Float ForwardZ = VectorSetFloat1(float(Forward.Z));
+    const VectorRegister4Float RightX = VectorSetFloat1(float(Right.X));
+    const VectorRegister4Float RightY = VectorSetFloat1(float(Right.Y));
+    const VectorRegister4Float RightZ = VectorSetFloat1(float(Right.Z));
+    const VectorRegister4Float UpX = VectorSetFloat1(float(Up.X));
+    const VectorRegister4Float UpY = VectorSetFloat1(float(Up.Y));
+    const VectorRegister4Float UpZ = VectorSetFloat1(float(Up.Z));
+
+    for (int32 Base = 0; Base < Num(); Base += 4)
+    {
+        const VectorRegister4Float LocalX = VectorLoad(X.GetData() + Base);
+        const VectorRegister4Float LocalY = VectorLoad(Y.GetData() + Base);
+        const VectorRegister4Float LocalZ = VectorLoad(Z.GetData() + Base);
+
+        const VectorRegister4Float WorldX = VectorMultiplyAdd(UpX, LocalZ, VectorMultiplyAdd(RightX, LocalY, VectorMultiply(ForwardX, LocalX)));
+        const VectorRegister4Float WorldY = VectorMultiplyAdd(UpY, LocalZ, VectorMultiplyAdd(RightY, LocalY, VectorMultiply(ForwardY, LocalX)));
+        const VectorRegister4Float WorldZ = VectorMultiplyAdd(UpZ, LocalZ, VectorMultiplyAdd(RightZ, LocalY, VectorMultiply(ForwardZ, LocalX)));
+
+        alignas(16) float OutX[4];
+        alignas(16) float OutY[4];
+        alignas(16) float OutZ[4];
+        VectorStoreAligned(WorldX, OutX);
+        VectorStoreAligned(WorldY, OutY);
+        VectorStoreAligned(WorldZ, OutZ);
+
+        // Padding lanes past Num() are computed but never written out
+        const int32 LaneCount = FMath::Min(4, Num() - Base);
+        for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+        {
+            OutDirections[Base + Lane] = FVector(OutX[Lane], OutY[Lane], OutZ[Lane]);
+        }
+    }
+}
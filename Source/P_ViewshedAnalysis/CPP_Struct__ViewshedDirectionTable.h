@@ -0,0 +1,47 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Unit observer-local direction (X forward, Y right, Z up) of every lattice sample, row major, as structure of arrays
+ * Directions depend only on the FOV and sample counts, so one immutable table is shared by every observer with
+ * the same lattice; each analysis only rotates it into its own frame (see FS__ViewShedHorizonLattice::GetLocalDirection)
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedDirectionTable
+{
+    /** Lattice the table was built for */
+    int32 HorizontalSampleCount = 0;
+    int32 VerticalSampleCount = 0;
+    float HalfHorizontalFOV = 0.0f;
+    float HalfVerticalFOV = 0.0f;
+
+    /** Direction components, padded with zeros to a multiple of four so every SIMD load stays in bounds */
+    TArray<float> X;
+    TArray<float> Y;
+    TArray<float> Z;
+
+    /** Number of directions (excluding padding) */
+    int32 Num() const { return HorizontalSampleCount * VerticalSampleCount; }
+
+    /**
+     * Shared table for a lattice: built on first request, released when the last holder lets go
+     * Safe to call from any thread
+     */
+    static TSharedRef<const FS__ViewShedDirectionTable> Find(int32 InHorizontalSampleCount, int32 InVerticalSampleCount, float InHalfHorizontalFOV, float InHalfVerticalFOV);
+
+    /**
+     * Rotate every direction into the frame spanned by Forward, Right and Up (a 3x3 multiply, four directions per SIMD op)
+     * @param OutDirections - Receives Num() world directions in table order
+     */
+    void Transform(const FVector &Forward, const FVector &Right, const FVector &Up, TArray<FVector> &OutDirections) const;
+
+private:
+    /** Fill the components for the lattice fields */
+    void Build();
+};
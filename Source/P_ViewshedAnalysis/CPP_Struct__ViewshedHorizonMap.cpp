@@ -0,0 +1,354 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedHorizonMap.h"
+#include "CPP_Actor__Viewshed.h"
+#include "CPP_Struct__ViewshedResultFile.h"
+#include "CPP_Struct__ViewshedSamplingPattern.h"
+#include "Engine/Texture2D.h"
+
+/**
+ * Observer-local direction of a lattice sample
+ */
+FVector FS__ViewShedHorizonLattice::GetLocalDirection(int32 HorizontalIndex, int32 VerticalIndex) const
+{
+    return GetLocalDirectionAt(float(HorizontalIndex), float(VerticalIndex));
+}
+
+/**
+ * Observer-local direction at a fractional lattice position
+ */
+FVector FS__ViewShedHorizonLattice::GetLocalDirectionAt(float HorizontalPosition, float VerticalPosition) const
+{
+    // Pattern samples have no in-between positions
+    if (Pattern)
+    {
+        return Pattern->GetLocalDirection(FMath::Clamp(FMath::RoundToInt32(HorizontalPosition), 0, Pattern->Num() - 1));
+    }
+
+    // A single sample sits in the middle of the field of view and spans all of it
+    const float HorizontalAlpha = HorizontalSampleCount <= 1 ? 0.5f + HorizontalPosition : HorizontalPosition / float(HorizontalSampleCount - 1);
+    const float VerticalAlpha = VerticalSampleCount <= 1 ? 0.5f + VerticalPosition : VerticalPosition / float(VerticalSampleCount - 1);
+    const float HorizontalAngle = FMath::Lerp(-HalfHorizontalFOV, HalfHorizontalFOV, HorizontalAlpha);
+    const float VerticalAngle = FMath::Lerp(-HalfVerticalFOV, HalfVerticalFOV, VerticalAlpha);
+
+    // Same yaw-then-pitch construction as the trace generator, expressed in the local basis
+    const float CosVertical = FMath::Cos(VerticalAngle);
+    return FVector(CosVertical * FMath::Cos(HorizontalAngle), CosVertical * FMath::Sin(HorizontalAngle), -FMath::Sin(VerticalAngle));
+}
+
+/**
+ * Nearest lattice direction to an observer-local direction
+ */
+int32 FS__ViewShedHorizonLattice::FindDirectionIndex(const FVector &LocalDirection) const
+{
+    if (!IsValid())
+    {
+        return INDEX_NONE;
+    }
+    if (Pattern)
+    {
+        return Pattern->FindNearest(LocalDirection);
+    }
+
+    float HorizontalPosition = 0.0f;
+    float VerticalPosition = 0.0f;
+    if (!FindLatticePosition(LocalDirection, HorizontalPosition, VerticalPosition))
+    {
+        return INDEX_NONE;
+    }
+
+    // Allow half a step of slack at the edges
+    const int32 HorizontalIndex = FMath::RoundToInt32(HorizontalPosition);
+    const int32 VerticalIndex = FMath::RoundToInt32(VerticalPosition);
+    if (HorizontalIndex < 0 || HorizontalIndex >= HorizontalSampleCount || VerticalIndex < 0 || VerticalIndex >= VerticalSampleCount)
+    {
+        return INDEX_NONE;
+    }
+
+    return ToIndex(HorizontalIndex, VerticalIndex);
+}
+
+/**
+ * Fractional lattice position of an observer-local direction
+ */
+bool FS__ViewShedHorizonLattice::FindLatticePosition(const FVector &LocalDirection, float &OutHorizontalPosition, float &OutVerticalPosition) const
+{
+    const FVector Direction = LocalDirection.GetSafeNormal();
+    if (Direction.IsZero())
+    {
+        return false;
+    }
+
+    // A pattern sample's position is its index in the single row
+    if (Pattern)
+    {
+        const int32 Index = Pattern->FindNearest(Direction);
+        OutHorizontalPosition = float(Index);
+        OutVerticalPosition = 0.0f;
+        return Index != INDEX_NONE;
+    }
+
+    // Invert the yaw/pitch construction
+    const float HorizontalAngle = FMath::Atan2(Direction.Y, Direction.X);
+    const float VerticalAngle = -FMath::Asin(FMath::Clamp(Direction.Z, -1.0, 1.0));
+
+    // Map angles to fractional sample positions
+    OutHorizontalPosition = HorizontalSampleCount <= 1 ? 0.0f : (HorizontalAngle + HalfHorizontalFOV) / (2.0f * HalfHorizontalFOV) * float(HorizontalSampleCount - 1);
+    OutVerticalPosition = VerticalSampleCount <= 1 ? 0.0f : (VerticalAngle + HalfVerticalFOV) / (2.0f * HalfVerticalFOV) * float(VerticalSampleCount - 1);
+    return true;
+}
+
+/**
+ * Texture coordinate of an observer-local direction
+ */
+FVector2D FS__ViewShedHorizonLattice::GetTextureUV(const FVector &LocalDirection) const
+{
+    float HorizontalPosition = 0.0f;
+    float VerticalPosition = 0.0f;
+    if (!IsValid() || !FindLatticePosition(LocalDirection, HorizontalPosition, VerticalPosition))
+    {
+        return FVector2D(0.5f, 0.5f);
+    }
+    // Sample i covers texel i, whose centre is at (i + 0.5) / Count
+    return FVector2D((HorizontalPosition + 0.5f) / float(HorizontalSampleCount), (VerticalPosition + 0.5f) / float(VerticalSampleCount));
+}
+
+/**
+ * Allocate storage for a lattice with every direction unoccluded
+ */
+void FS__ViewShedHorizonMap::Initialize(const FS__ViewShedHorizonLattice &InLattice, bool bHalfPrecision, bool bStoreNormals)
+{
+    Reset();
+
+    if (!InLattice.IsValid())
+    {
+        return;
+    }
+
+    Lattice = InLattice;
+    // Occluders beyond the largest finite half could only be recorded nearer than they are, so such ranges stay float32
+    if (bHalfPrecision && Lattice.MaxDistance <= MaxHalfDistance)
+    {
+        // +Inf marks a clear direction; finite half values top out at 65504
+        FFloat16 Clear;
+        Clear.Encoded = 0x7C00;
+        HalfOccluderDistances.Init(Clear, Lattice.Num());
+    }
+    else
+    {
+        OccluderDistances.Init(Unoccluded, Lattice.Num());
+    }
+
+    if (bStoreNormals)
+    {
+        PackedNormals.SetNumZeroed(Lattice.Num());
+    }
+}
+
+/**
+ * Collapse per-band results into per-direction first-occluder distances
+ */
+void FS__ViewShedHorizonMap::Build(const FS__ViewShedHorizonLattice &InLattice, TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays,
+                                   bool bHalfPrecision, bool bStoreNormals)
+{
+    Initialize(InLattice, bHalfPrecision, bStoreNormals);
+
+    if (!IsBuilt() || Points.Num() != Rays.Num() || Rays.GetDirectionCount() != Lattice.Num())
+    {
+        Reset();
+        return;
+    }
+
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        const FS__ViewShedPoint &Point = Points[i];
+
+        // Occluded samples always carry their blocker; visible samples only when they landed on a surface
+        if (Point.bIsVisible && !FS__ViewShedWorldRaster::ShouldSplat(Point, true))
+        {
+            continue;
+        }
+
+        const int32 DirectionIndex = Rays.GetDirectionIndex(i);
+
+        // Every band traces the same ray, so the nearest surface along it is the first occluder
+        const float HitDistance = float(FVector::Dist(Rays.Origin, Point.HitLocation));
+        if (HitDistance < GetOccluderDistance(DirectionIndex))
+        {
+            SetOccluder(DirectionIndex, HitDistance, Point.HitNormal);
+        }
+    }
+}
+
+/**
+ * Release all storage
+ */
+void FS__ViewShedHorizonMap::Reset()
+{
+    Lattice = FS__ViewShedHorizonLattice();
+    OccluderDistances.Empty();
+    HalfOccluderDistances.Empty();
+    PackedNormals.Empty();
+}
+
+/**
+ * First-occluder distance of a direction
+ */
+float FS__ViewShedHorizonMap::GetOccluderDistance(int32 DirectionIndex) const
+{
+    if (IsHalfPrecision())
+    {
+        const FFloat16 Half = HalfOccluderDistances[DirectionIndex];
+        return Half.Encoded == 0x7C00 ? Unoccluded : Half.GetFloat();
+    }
+    return OccluderDistances[DirectionIndex];
+}
+
+/**
+ * Hit normal of a direction's first occluder
+ */
+FVector FS__ViewShedHorizonMap::GetOccluderNormal(int32 DirectionIndex) const
+{
+    return HasNormals() ? FS__ViewShedResultFileView::DecodeNormal(PackedNormals[DirectionIndex]) : FVector::ZeroVector;
+}
+
+/**
+ * Record the first occluder of a direction
+ */
+void FS__ViewShedHorizonMap::SetOccluder(int32 DirectionIndex, float Distance, const FVector &Normal)
+{
+    if (IsHalfPrecision())
+    {
+        // Round down so a quantized occluder never sits behind the real surface
+        FFloat16 Half(FMath::Min(Distance, MaxHalfDistance));
+        if (Half.GetFloat() > Distance && Half.Encoded > 0)
+        {
+            --Half.Encoded;
+        }
+        HalfOccluderDistances[DirectionIndex] = Half;
+    }
+    else
+    {
+        OccluderDistances[DirectionIndex] = Distance;
+    }
+
+    if (HasNormals())
+    {
+        PackedNormals[DirectionIndex] = FS__ViewShedResultFileView::EncodeNormal(Normal);
+    }
+}
+
+/**
+ * One float32 first-occluder distance per direction
+ */
+void FS__ViewShedHorizonMap::PackOccluderTexels(TArray<float> &OutTexels) const
+{
+    OutTexels.Reset();
+    if (!IsBuilt())
+    {
+        return;
+    }
+
+    // Half-precision +Inf and MAX_flt both read back as Unoccluded; clamp so texture filtering never sees infinities
+    const float ClearDistance = GetClearTexelDistance();
+    OutTexels.SetNumUninitialized(Lattice.Num());
+    for (int32 DirectionIndex = 0; DirectionIndex < Lattice.Num(); ++DirectionIndex)
+    {
+        OutTexels[DirectionIndex] = FMath::Min(GetOccluderDistance(DirectionIndex), ClearDistance);
+    }
+}
+
+/**
+ * Upload the packed distances into a float texture
+ */
+void FS__ViewShedHorizonMap::FillOccluderTexture(UTexture2D *Texture) const
+{
+    if (!Texture || !IsBuilt() || Texture->GetSizeX() != Lattice.HorizontalSampleCount || Texture->GetSizeY() != Lattice.VerticalSampleCount)
+    {
+        return;
+    }
+
+    TArray<float> Texels;
+    PackOccluderTexels(Texels);
+
+    // The render thread frees the copy once the upload is done
+    const int32 TexelBytes = Texels.Num() * sizeof(float);
+    float *Pixels = static_cast<float *>(FMemory::Malloc(TexelBytes));
+    FMemory::Memcpy(Pixels, Texels.GetData(), TexelBytes);
+
+    FUpdateTextureRegion2D *Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Lattice.HorizontalSampleCount, Lattice.VerticalSampleCount);
+    Texture->UpdateTextureRegions(
+        0,
+        1,
+        Region,
+        Lattice.HorizontalSampleCount * sizeof(float),
+        sizeof(float),
+        reinterpret_cast<uint8 *>(Pixels),
+        [](uint8 *SrcData, const FUpdateTextureRegion2D *Regions)
+        {
+            FMemory::Free(SrcData);
+            delete Regions;
+        });
+}
+
+/**
+ * Visibility of a point relative to the first occluder along its direction
+ */
+float FS__ViewShedHorizonMap::ComputeOcclusionMask(float Distance, float OccluderDistance, float Tolerance, float Feather)
+{
+    return FMath::Clamp(1.0f - (Distance - (OccluderDistance + Tolerance)) / FMath::Max(Feather, 1e-3f), 0.0f, 1.0f);
+}
+
+/**
+ * Whether a point at Distance along an observer-local direction is visible
+ */
+bool FS__ViewShedHorizonMap::IsVisible(const FVector &LocalDirection, float Distance, float Tolerance) const
+{
+    if (!IsBuilt() || Distance > Lattice.MaxDistance)
+    {
+        return false;
+    }
+
+    const int32 DirectionIndex = Lattice.FindDirectionIndex(LocalDirection);
+    if (DirectionIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    return Distance <= GetOccluderDistance(DirectionIndex) + Tolerance;
+}
+
+/**
+ * Reconstruct the band result a line trace along TracePoint would have produced
+ */
+void FS__ViewShedHorizonMap::DeriveBandPoint(const FS__ViewShedTracePoint &TracePoint, FS__ViewShedPoint &OutPoint, float Tolerance) const
+{
+    const FVector TraceVector = TracePoint.TraceEnd - TracePoint.TraceStart;
+    const float TraceLength = float(TraceVector.Size());
+
+    OutPoint.WorldPosition = TracePoint.TraceEnd;
+    OutPoint.Distance = TraceLength;
+    OutPoint.HitActor = nullptr;
+
+    const int32 DirectionIndex = Lattice.ToIndex(TracePoint.HorizontalSampleIndex, TracePoint.VerticalSampleIndex);
+    const float OccluderDistance = IsBuilt() && DirectionIndex >= 0 && DirectionIndex < Lattice.Num() ? GetOccluderDistance(DirectionIndex) : Unoccluded;
+
+    // The band trace stops at its endpoint, so occluders beyond it are never reached
+    if (OccluderDistance > TraceLength || TraceLength <= KINDA_SMALL_NUMBER)
+    {
+        OutPoint.bIsVisible = true;
+        OutPoint.HitLocation = TracePoint.TraceEnd;
+        OutPoint.HitNormal = TracePoint.GroundNormal;
+        return;
+    }
+
+    // Surface within the band: visible if it is (nearly) the endpoint itself, occluded otherwise
+    const FVector RayDirection = TraceVector / TraceLength;
+    OutPoint.bIsVisible = FMath::IsNearlyEqual(OccluderDistance, TraceLength, Tolerance);
+    OutPoint.HitLocation = TracePoint.TraceStart + RayDirection * OccluderDistance;
+    OutPoint.HitNormal = HasNormals() ? GetOccluderNormal(DirectionIndex) : -RayDirection;
+}
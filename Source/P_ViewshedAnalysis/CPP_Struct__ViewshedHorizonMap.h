@@ -0,0 +1,165 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Float16.h"
+
+struct FS__ViewShedPoint;
+struct FS__ViewShedTracePoint;
+struct FS__ViewShedRayStore;
+struct FS__ViewShedSamplingPattern;
+class UTexture2D;
+
+/**
+ * Angular sample lattice shared by every distance band of an observer
+ * Direction (H, V) is the observer forward axis yawed by the H angle and pitched by the V angle, with both
+ * angles spread evenly across the field of view; a positive pitch points down (see GenerateTraceEndpoints).
+ * With a sampling pattern the lattice is a single row of the pattern's samples instead.
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedHorizonLattice
+{
+    /** Directions across the horizontal field of view */
+    int32 HorizontalSampleCount = 0;
+
+    /** Directions across the vertical field of view */
+    int32 VerticalSampleCount = 0;
+
+    /** Half of the horizontal field of view, in radians */
+    float HalfHorizontalFOV = 0.0f;
+
+    /** Half of the vertical field of view, in radians */
+    float HalfVerticalFOV = 0.0f;
+
+    /** Analysis range; targets beyond it are never visible */
+    float MaxDistance = 0.0f;
+
+    /** Non-grid sampling pattern the directions come from, or null for the yaw/pitch grid */
+    TSharedPtr<const FS__ViewShedSamplingPattern> Pattern;
+
+    /** Number of directions */
+    int32 Num() const { return HorizontalSampleCount * VerticalSampleCount; }
+
+    /** Whether the lattice describes at least one direction */
+    bool IsValid() const { return HorizontalSampleCount > 0 && VerticalSampleCount > 0 && MaxDistance > 0.0f; }
+
+    /** Row-major direction index */
+    int32 ToIndex(int32 HorizontalIndex, int32 VerticalIndex) const { return VerticalIndex * HorizontalSampleCount + HorizontalIndex; }
+
+    /** Observer-local direction (X forward, Y right, Z up) of a lattice sample */
+    FVector GetLocalDirection(int32 HorizontalIndex, int32 VerticalIndex) const;
+
+    /** Observer-local direction at a fractional lattice position; half-integer positions are the edges between samples */
+    FVector GetLocalDirectionAt(float HorizontalPosition, float VerticalPosition) const;
+
+    /** Nearest lattice direction to an observer-local direction, or INDEX_NONE outside the field of view */
+    int32 FindDirectionIndex(const FVector &LocalDirection) const;
+
+    /** Fractional lattice position of an observer-local direction (unclamped); false for a zero direction */
+    bool FindLatticePosition(const FVector &LocalDirection, float &OutHorizontalPosition, float &OutVerticalPosition) const;
+
+    /**
+     * Texture coordinate of an observer-local direction in a Horizontal x Vertical texture, sample centres at texel
+     * centres; mirrors OccluderTextureUV in ViewshedCommon.ush
+     */
+    FVector2D GetTextureUV(const FVector &LocalDirection) const;
+};
+
+/**
+ * First-occluder distance per lattice direction
+ * Every band sample along a direction traces the same ray, so a single distance determines the visibility
+ * of every point along it: a point is visible when it lies before the first surface the ray reaches.
+ * Distances are stored as float32 or float16 and hit normals optionally as 16:16 octahedral words, so the
+ * whole map is a texture-shaped (Horizontal x Vertical) buffer.
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedHorizonMap
+{
+    /** Distance value of a direction whose ray reached no surface within range */
+    static constexpr float Unoccluded = MAX_flt;
+
+    /** Largest finite float16 value; longer ranges are stored in float32 whatever precision was requested */
+    static constexpr float MaxHalfDistance = 65504.0f;
+
+    /** Angular lattice the distances are laid out on */
+    FS__ViewShedHorizonLattice Lattice;
+
+    /** First-occluder distance per direction, row major (Unoccluded when clear); empty in half precision */
+    TArray<float> OccluderDistances;
+
+    /** Half-precision distances used instead of OccluderDistances (+Inf when clear) */
+    TArray<FFloat16> HalfOccluderDistances;
+
+    /** Octahedron-encoded hit normal per direction (0 = none); empty unless normals are stored */
+    TArray<uint32> PackedNormals;
+
+    /**
+     * Allocate storage for a lattice with every direction unoccluded
+     * @param bHalfPrecision - Store distances as float16 (about 3 significant digits); ignored beyond MaxHalfDistance
+     * @param bStoreNormals - Keep the normal of each first occluder
+     */
+    void Initialize(const FS__ViewShedHorizonLattice &InLattice, bool bHalfPrecision, bool bStoreNormals);
+
+    /**
+     * Collapse per-band results into per-direction first-occluder distances
+     * @param Points - Results, one per ray
+     * @param Rays - Rays matching Points (provides the origin and lattice indices)
+     */
+    void Build(const FS__ViewShedHorizonLattice &InLattice, TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays,
+               bool bHalfPrecision = false, bool bStoreNormals = false);
+
+    /** Release all storage */
+    void Reset();
+
+    /** Whether storage matches the lattice */
+    bool IsBuilt() const { return Lattice.IsValid() && (OccluderDistances.Num() == Lattice.Num() || HalfOccluderDistances.Num() == Lattice.Num()); }
+
+    /** Whether distances are stored as float16 */
+    bool IsHalfPrecision() const { return !HalfOccluderDistances.IsEmpty(); }
+
+    /** Whether hit normals are stored */
+    bool HasNormals() const { return !PackedNormals.IsEmpty(); }
+
+    /** First-occluder distance of a direction (Unoccluded when clear) */
+    float GetOccluderDistance(int32 DirectionIndex) const;
+
+    /** Hit normal of a direction's first occluder (ZeroVector when clear or not stored) */
+    FVector GetOccluderNormal(int32 DirectionIndex) const;
+
+    /** Record the first occluder of a direction */
+    void SetOccluder(int32 DirectionIndex, float Distance, const FVector &Normal);
+
+    /** Bytes held by the distance and normal buffers */
+    SIZE_T GetAllocatedSize() const { return OccluderDistances.GetAllocatedSize() + HalfOccluderDistances.GetAllocatedSize() + PackedNormals.GetAllocatedSize(); }
+
+    /** Texel value of a clear direction in the packed occluder texture: beyond anything within range */
+    float GetClearTexelDistance() const { return Lattice.MaxDistance * 2.0f; }
+
+    /** One float32 first-occluder distance per direction, row major; clear directions hold GetClearTexelDistance */
+    void PackOccluderTexels(TArray<float> &OutTexels) const;
+
+    /** Upload the packed distances into a PF_R32_FLOAT texture sized Horizontal x Vertical */
+    void FillOccluderTexture(UTexture2D *Texture) const;
+
+    /**
+     * Visibility of a point at Distance in front of an occluder at OccluderDistance: 1 up to OccluderDistance + Tolerance,
+     * fading to 0 over Feather behind it; mirrors OcclusionMask in ViewshedCommon.ush
+     */
+    static float ComputeOcclusionMask(float Distance, float OccluderDistance, float Tolerance, float Feather);
+
+    /**
+     * Whether a point at Distance along an observer-local direction is visible
+     * @param Tolerance - Slack before the occluder, matching the trace reach tolerance
+     */
+    bool IsVisible(const FVector &LocalDirection, float Distance, float Tolerance = 5.0f) const;
+
+    /**
+     * Reconstruct the band result a line trace along TracePoint would have produced
+     * Hit actors are not stored; without stored normals, surface hits face back along the ray
+     * @param Tolerance - Reach tolerance of the trace (see ProcessSingleTrace)
+     */
+    void DeriveBandPoint(const FS__ViewShedTracePoint &TracePoint, FS__ViewShedPoint &OutPoint, float Tolerance = 5.0f) const;
+};
@@ -0,0 +1,194 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedRayStore.h"
+#include "CPP_Actor__Viewshed.h"
+#include "Algo/BinarySearch.h"
+
+/**
+ * Describe a new analysis; Directions is sized but left for the caller to fill
+ */
+void FS__ViewShedRayStore::Initialize(const FVector &InOrigin, float InMaxDistance, int32 InBandCount, int32 InHorizontalSampleCount, int32 InVerticalSampleCount,
+                                      TConstArrayView<FIntPoint> BandStrides)
+{
+    Origin = InOrigin;
+    MaxDistance = InMaxDistance;
+    BandCount = FMath::Max(0, InBandCount);
+    HorizontalSampleCount = FMath::Max(0, InHorizontalSampleCount);
+    VerticalSampleCount = FMath::Max(0, InVerticalSampleCount);
+    Directions.SetNumUninitialized(GetDirectionCount());
+
+    // Every stride-th column and row plus the last one, so the sub-lattice still spans the whole field of view
+    const auto SubLatticeCount = [](int32 SampleCount, int32 Stride)
+    {
+        return SampleCount <= 1 ? SampleCount : FMath::DivideAndRoundUp(SampleCount - 1, Stride) + 1;
+    };
+
+    Bands.SetNum(BandCount);
+    RayCount = 0;
+    for (int32 BandIndex = 0; BandIndex < BandCount; ++BandIndex)
+    {
+        FS__ViewShedRayBand &Band = Bands[BandIndex];
+        const FIntPoint Stride = BandStrides.IsValidIndex(BandIndex) ? BandStrides[BandIndex] : FIntPoint(1, 1);
+        Band.FirstRay = RayCount;
+        Band.HorizontalStride = FMath::Max(1, Stride.X);
+        Band.VerticalStride = FMath::Max(1, Stride.Y);
+        Band.ColumnCount = SubLatticeCount(HorizontalSampleCount, Band.HorizontalStride);
+        Band.RowCount = SubLatticeCount(VerticalSampleCount, Band.VerticalStride);
+        RayCount += Band.Num();
+    }
+}
+
+/**
+ * Forget every ray, keeping the direction allocation
+ */
+void FS__ViewShedRayStore::Reset()
+{
+    Origin = FVector::ZeroVector;
+    MaxDistance = 0.0f;
+    BandCount = 0;
+    HorizontalSampleCount = 0;
+    VerticalSampleCount = 0;
+    RayCount = 0;
+    Directions.Reset();
+    Bands.Reset();
+    Pattern.Reset();
+}
+
+/**
+ * Band of a ray
+ */
+int32 FS__ViewShedRayStore::GetBandIndex(int32 RayIndex) const
+{
+    if (IsUniform())
+    {
+        return RayIndex / FMath::Max(1, GetDirectionCount());
+    }
+    return Algo::UpperBoundBy(Bands, RayIndex, &FS__ViewShedRayBand::FirstRay) - 1;
+}
+
+/**
+ * Band and sub-lattice column and row of a ray
+ */
+void FS__ViewShedRayStore::GetBandCoordinates(int32 RayIndex, int32 &OutBandIndex, int32 &OutColumn, int32 &OutRow) const
+{
+    OutBandIndex = GetBandIndex(RayIndex);
+    const FS__ViewShedRayBand &Band = Bands[OutBandIndex];
+    const int32 BandOffset = RayIndex - Band.FirstRay;
+    const int32 RowSlot = BandOffset / FMath::Max(1, Band.ColumnCount);
+    OutColumn = BandOffset - RowSlot * Band.ColumnCount;
+
+    // Slot 0 is the central row; the rows below it shift up by one to make room, the rows above it keep their index
+    const int32 CentralRow = Band.RowCount / 2;
+    OutRow = RowSlot == 0 ? CentralRow : (RowSlot <= CentralRow ? RowSlot - 1 : RowSlot);
+}
+
+/**
+ * Band and full-lattice indices of a ray
+ */
+void FS__ViewShedRayStore::GetRayCoordinates(int32 RayIndex, int32 &OutBandIndex, int32 &OutHorizontalIndex, int32 &OutVerticalIndex) const
+{
+    int32 Column = 0;
+    int32 Row = 0;
+    GetBandCoordinates(RayIndex, OutBandIndex, Column, Row);
+    OutHorizontalIndex = GetLatticeColumn(OutBandIndex, Column);
+    OutVerticalIndex = GetLatticeRow(OutBandIndex, Row);
+}
+
+/**
+ * Row-major position of a ray in its band's sub-lattice, offset by the band's first ray
+ */
+int32 FS__ViewShedRayStore::GetBandSlot(int32 RayIndex) const
+{
+    int32 BandIndex = 0;
+    int32 Column = 0;
+    int32 Row = 0;
+    GetBandCoordinates(RayIndex, BandIndex, Column, Row);
+    const FS__ViewShedRayBand &Band = Bands[BandIndex];
+    return Band.FirstRay + Row * Band.ColumnCount + Column;
+}
+
+/**
+ * Queue index of the ray at a band's sub-lattice column and row
+ */
+int32 FS__ViewShedRayStore::GetRayIndex(int32 BandIndex, int32 Column, int32 Row) const
+{
+    const FS__ViewShedRayBand &Band = Bands[BandIndex];
+    const int32 CentralRow = Band.RowCount / 2;
+    const int32 RowSlot = Row == CentralRow ? 0 : (Row < CentralRow ? Row + 1 : Row);
+    return Band.FirstRay + RowSlot * Band.ColumnCount + Column;
+}
+
+/**
+ * Row-major lattice direction index of a ray
+ */
+int32 FS__ViewShedRayStore::GetDirectionIndex(int32 RayIndex) const
+{
+    int32 BandIndex = 0;
+    int32 HorizontalIndex = 0;
+    int32 VerticalIndex = 0;
+    GetRayCoordinates(RayIndex, BandIndex, HorizontalIndex, VerticalIndex);
+    return VerticalIndex * HorizontalSampleCount + HorizontalIndex;
+}
+
+/**
+ * World endpoint of a ray
+ */
+FVector FS__ViewShedRayStore::GetTraceEnd(int32 RayIndex) const
+{
+    int32 BandIndex = 0;
+    int32 HorizontalIndex = 0;
+    int32 VerticalIndex = 0;
+    GetRayCoordinates(RayIndex, BandIndex, HorizontalIndex, VerticalIndex);
+    return Origin + Directions[VerticalIndex * HorizontalSampleCount + HorizontalIndex] * GetBandDistance(BandIndex);
+}
+
+/**
+ * Regenerate the start/end points and lattice indices of a ray
+ */
+void FS__ViewShedRayStore::GetTracePoint(int32 RayIndex, FS__ViewShedTracePoint &OutTracePoint) const
+{
+    int32 BandIndex = 0;
+    int32 HorizontalIndex = 0;
+    int32 VerticalIndex = 0;
+    GetRayCoordinates(RayIndex, BandIndex, HorizontalIndex, VerticalIndex);
+
+    OutTracePoint.TraceStart = Origin;
+    OutTracePoint.TraceEnd = Origin + Directions[VerticalIndex * HorizontalSampleCount + HorizontalIndex] * GetBandDistance(BandIndex);
+    OutTracePoint.DistanceBandIndex = BandIndex;
+    OutTracePoint.HorizontalSampleIndex = HorizontalIndex;
+    OutTracePoint.VerticalSampleIndex = VerticalIndex;
+    OutTracePoint.bHasGroundSupport = true;
+    OutTracePoint.GroundNormal = FVector::ZeroVector;
+}
+
+/**
+ * Rays of a distance band
+ */
+FS__ViewShedRayRange FS__ViewShedRayStore::GetBandRange(int32 BandIndex) const
+{
+    FS__ViewShedRayRange Range;
+    if (Bands.IsValidIndex(BandIndex))
+    {
+        Range.First = Bands[BandIndex].FirstRay;
+        Range.Num = Bands[BandIndex].Num();
+    }
+    return Range;
+}
+
+/**
+ * Rays of one sub-lattice row within a distance band
+ */
+FS__ViewShedRayRange FS__ViewShedRayStore::GetRowRange(int32 BandIndex, int32 Row) const
+{
+    FS__ViewShedRayRange Range;
+    if (Bands.IsValidIndex(BandIndex) && Row >= 0 && Row < Bands[BandIndex].RowCount)
+    {
+        Range.First = GetRayIndex(BandIndex, 0, Row);
+        Range.Num = Bands[BandIndex].ColumnCount;
+    }
+    return Range;
+}
@@ -0,0 +1,158 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FS__ViewShedTracePoint;
+struct FS__ViewShedSamplingPattern;
+
+/**
+ * Contiguous run of rays in a ray store (a distance band, or one lattice row of a band)
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedRayRange
+{
+    /** Queue index of the first ray */
+    int32 First = 0;
+
+    /** Number of rays */
+    int32 Num = 0;
+
+    /** One past the last queue index */
+    int32 End() const { return First + Num; }
+};
+
+/**
+ * Sub-lattice sampled by one distance band
+ * A band keeps every Stride-th column and row of the full lattice plus the last one, so its samples are a subset
+ * of the full lattice and keep their lattice indices; strides are powers of two, so nearer bands nest in farther ones
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedRayBand
+{
+    /** Queue index of the band's first ray */
+    int32 FirstRay = 0;
+
+    /** Lattice step between neighbouring columns and rows (1 = every lattice sample) */
+    int32 HorizontalStride = 1;
+    int32 VerticalStride = 1;
+
+    /** Columns and rows of the sub-lattice */
+    int32 ColumnCount = 0;
+    int32 RowCount = 0;
+
+    /** Rays in the band */
+    int32 Num() const { return ColumnCount * RowCount; }
+};
+
+/**
+ * Every ray of one analysis, implicitly indexed by (band, horizontal, vertical)
+ * Rays share a single origin and every band reuses the same lattice directions, so the store holds one world
+ * direction per lattice sample plus a small descriptor per band, and regenerates trace points on demand.
+ * Queue order is band major (nearest first); within a band the central row of its sub-lattice comes first,
+ * then the remaining rows bottom to top, each row left to right.
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedRayStore
+{
+    /** Shared trace start of every ray */
+    FVector Origin = FVector::ZeroVector;
+
+    /** Reach of the farthest band */
+    float MaxDistance = 0.0f;
+
+    /** Number of distance bands */
+    int32 BandCount = 0;
+
+    /** Full lattice extents */
+    int32 HorizontalSampleCount = 0;
+    int32 VerticalSampleCount = 0;
+
+    /** World direction per lattice sample, row major (see FS__ViewShedDirectionTable::Transform) */
+    TArray<FVector> Directions;
+
+    /** Sub-lattice of every band, nearest first */
+    TArray<FS__ViewShedRayBand> Bands;
+
+    /** Non-grid sampling pattern the directions come from (a single lattice row of its samples), or null for the grid */
+    TSharedPtr<const FS__ViewShedSamplingPattern> Pattern;
+
+    /**
+     * Describe a new analysis; Directions is sized but left for the caller to fill
+     * @param BandStrides - Horizontal (X) and vertical (Y) lattice stride per band; empty samples every band at full density
+     */
+    void Initialize(const FVector &InOrigin, float InMaxDistance, int32 InBandCount, int32 InHorizontalSampleCount, int32 InVerticalSampleCount,
+                    TConstArrayView<FIntPoint> BandStrides = TConstArrayView<FIntPoint>());
+
+    /** Forget every ray, keeping the direction allocation */
+    void Reset();
+
+    /** Number of rays across every band */
+    int32 Num() const { return RayCount; }
+
+    /** Whether there are no rays */
+    bool IsEmpty() const { return RayCount == 0; }
+
+    /** Whether RayIndex addresses a ray */
+    bool IsValidIndex(int32 RayIndex) const { return RayIndex >= 0 && RayIndex < RayCount; }
+
+    /** Number of lattice directions */
+    int32 GetDirectionCount() const { return HorizontalSampleCount * VerticalSampleCount; }
+
+    /** Whether every band samples the full lattice */
+    bool IsUniform() const { return RayCount == BandCount * GetDirectionCount(); }
+
+    /** Endpoint distance of a band */
+    float GetBandDistance(int32 BandIndex) const { return MaxDistance * (float(BandIndex + 1) / float(FMath::Max(1, BandCount))); }
+
+    /** Band of a ray */
+    int32 GetBandIndex(int32 RayIndex) const;
+
+    /** Lattice column of a band's sub-lattice column */
+    int32 GetLatticeColumn(int32 BandIndex, int32 Column) const { return FMath::Min(Column * Bands[BandIndex].HorizontalStride, HorizontalSampleCount - 1); }
+
+    /** Lattice row of a band's sub-lattice row */
+    int32 GetLatticeRow(int32 BandIndex, int32 Row) const { return FMath::Min(Row * Bands[BandIndex].VerticalStride, VerticalSampleCount - 1); }
+
+    /** Band and sub-lattice column and row of a ray */
+    void GetBandCoordinates(int32 RayIndex, int32 &OutBandIndex, int32 &OutColumn, int32 &OutRow) const;
+
+    /** Band and full-lattice indices of a ray */
+    void GetRayCoordinates(int32 RayIndex, int32 &OutBandIndex, int32 &OutHorizontalIndex, int32 &OutVerticalIndex) const;
+
+    /**
+     * Row-major position of a ray in its band's sub-lattice, offset by the band's first ray
+     * Unique per ray and below Num(), so per-band grids can share one array indexed by it
+     */
+    int32 GetBandSlot(int32 RayIndex) const;
+
+    /** Queue index of the ray at a band's sub-lattice column and row */
+    int32 GetRayIndex(int32 BandIndex, int32 Column, int32 Row) const;
+
+    /** Row-major lattice direction index of a ray */
+    int32 GetDirectionIndex(int32 RayIndex) const;
+
+    /** World direction of a ray */
+    const FVector &GetDirection(int32 RayIndex) const { return Directions[GetDirectionIndex(RayIndex)]; }
+
+    /** World endpoint of a ray */
+    FVector GetTraceEnd(int32 RayIndex) const;
+
+    /** Regenerate the start/end points and lattice indices of a ray */
+    void GetTracePoint(int32 RayIndex, FS__ViewShedTracePoint &OutTracePoint) const;
+
+    /** Rays of a distance band */
+    FS__ViewShedRayRange GetBandRange(int32 BandIndex) const;
+
+    /** Rays of one sub-lattice row within a distance band */
+    FS__ViewShedRayRange GetRowRange(int32 BandIndex, int32 Row) const;
+
+    /** Bytes held by the direction and band buffers */
+    SIZE_T GetAllocatedSize() const { return Directions.GetAllocatedSize() + Bands.GetAllocatedSize(); }
+
+private:
+    /** Total rays across every band */
+    int32 RayCount = 0;
+};
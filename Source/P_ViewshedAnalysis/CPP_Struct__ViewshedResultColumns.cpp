@@ -0,0 +1,234 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedResultColumns.h"
+#include "CPP_Actor__Viewshed.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Rebuild all columns from the analysis results and their matching rays
+ */
+void FS__ViewShedResultColumns::Build(TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays)
+{
+    Reset();
+
+    NumResults = Points.Num();
+    const int32 PaddedCount = NumMaskWords() * 32;
+
+    VisibilityBits.SetNumZeroed(NumMaskWords());
+    Distances.SetNumZeroed(PaddedCount);
+    BandIndices.SetNumZeroed(PaddedCount);
+
+    for (int32 i = 0; i < NumResults; ++i)
+    {
+        const FS__ViewShedPoint &Point = Points[i];
+        VisibilityBits[i >> 5] |= uint32(Point.bIsVisible) << (i & 31);
+        Distances[i] = Point.Distance;
+        // Bands are capped well below 256 by the DistanceSteps clamp
+        BandIndices[i] = Rays.IsValidIndex(i) ? uint8(FMath::Clamp(Rays.GetBandIndex(i), 0, 255)) : 0;
+    }
+}
+
+/**
+ * Rebuild all columns straight from a horizon map
+ */
+void FS__ViewShedResultColumns::Build(const FS__ViewShedHorizonMap &Horizon, const FS__ViewShedRayStore &Rays)
+{
+    Reset();
+
+    NumResults = Rays.Num();
+    const int32 PaddedCount = NumMaskWords() * 32;
+
+    VisibilityBits.SetNumZeroed(NumMaskWords());
+    Distances.SetNumZeroed(PaddedCount);
+    BandIndices.SetNumZeroed(PaddedCount);
+
+    // One mask word per task, so no two workers write the same visibility word
+    ParallelFor(NumMaskWords(), [&](int32 WordIndex)
+                {
+        FS__ViewShedTracePoint TracePoint;
+        FS__ViewShedPoint Point;
+        const int32 End = FMath::Min(NumResults, (WordIndex + 1) * 32);
+        uint32 Word = 0;
+        for (int32 i = WordIndex * 32; i < End; ++i)
+        {
+            Rays.GetTracePoint(i, TracePoint);
+            Horizon.DeriveBandPoint(TracePoint, Point);
+            Word |= uint32(Point.bIsVisible) << (i & 31);
+            Distances[i] = Point.Distance;
+            BandIndices[i] = uint8(FMath::Clamp(TracePoint.DistanceBandIndex, 0, 255));
+        }
+        VisibilityBits[WordIndex] = Word; });
+}
+
+/**
+ * Release all column storage
+ */
+void FS__ViewShedResultColumns::Reset()
+{
+    NumResults = 0;
+    VisibilityBits.Empty();
+    Distances.Empty();
+    BandIndices.Empty();
+}
+
+/**
+ * Evaluate a fused predicate into a bitmask
+ * Each mask word covers 32 results: distance range tests run four lanes at a time and collapse to
+ * bits with VectorMaskBits, band and visibility tests are folded into the same word before it is stored
+ */
+void FS__ViewShedResultColumns::FilterToMask(const FS__ViewShedFilterPredicate &Predicate, TArray<uint32> &OutMask) const
+{
+    const int32 WordCount = NumMaskWords();
+    OutMask.SetNumUninitialized(WordCount);
+
+    const bool bTestDistance = Predicate.bFilterByDistance;
+    const bool bTestBand = Predicate.BandIndex >= 0;
+    const uint8 Band = uint8(FMath::Clamp(Predicate.BandIndex, 0, 255));
+
+    const VectorRegister4Float MinDistance = VectorSetFloat1(Predicate.MinDistance);
+    const VectorRegister4Float MaxDistance = VectorSetFloat1(Predicate.MaxDistance);
+
+    const float *DistanceData = Distances.GetData();
+    const uint8 *BandData = BandIndices.GetData();
+
+    for (int32 WordIndex = 0; WordIndex < WordCount; ++WordIndex)
+    {
+        // Visibility column is already bit-packed, so it seeds the word directly
+        uint32 Word = ~0u;
+        if (Predicate.Visibility == E__ViewShedPointFilter::Visible)
+        {
+            Word = VisibilityBits[WordIndex];
+        }
+        else if (Predicate.Visibility == E__ViewShedPointFilter::Hidden)
+        {
+            Word = ~VisibilityBits[WordIndex];
+        }
+
+        const int32 Base = WordIndex * 32;
+
+        if (bTestDistance && Word != 0)
+        {
+            uint32 DistanceWord = 0;
+            for (int32 Lane = 0; Lane < 32; Lane += 4)
+            {
+                const VectorRegister4Float Values = VectorLoad(DistanceData + Base + Lane);
+                const VectorRegister4Float InRange = VectorBitwiseAnd(VectorCompareGE(Values, MinDistance), VectorCompareLE(Values, MaxDistance));
+                DistanceWord |= uint32(VectorMaskBits(InRange)) << Lane;
+            }
+            Word &= DistanceWord;
+        }
+
+        if (bTestBand && Word != 0)
+        {
+            uint32 BandWord = 0;
+            for (int32 Lane = 0; Lane < 32; ++Lane)
+            {
+                BandWord |= uint32(BandData[Base + Lane] == Band) << Lane;
+            }
+            Word &= BandWord;
+        }
+
+        OutMask[WordIndex] = Word;
+    }
+
+    // Clear padding bits past the last valid result
+    const int32 TailBits = NumResults & 31;
+    if (WordCount > 0 && TailBits != 0)
+    {
+        OutMask[WordCount - 1] &= (1u << TailBits) - 1u;
+    }
+}
+
+/**
+ * Count the set bits in a mask
+ */
+int32 FS__ViewShedResultColumns::CountMask(TConstArrayView<uint32> Mask)
+{
+    int32 Count = 0;
+    for (const uint32 Word : Mask)
+    {
+        Count += int32(FPlatformMath::CountBits(Word));
+    }
+    return Count;
+}
+
+/**
+ * Expand a mask into ascending result indices, reserving the exact output size up front
+ */
+void FS__ViewShedResultColumns::MaskToIndices(TConstArrayView<uint32> Mask, TArray<int32> &OutIndices)
+{
+    OutIndices.Reset(CountMask(Mask));
+    for (int32 WordIndex = 0; WordIndex < Mask.Num(); ++WordIndex)
+    {
+        uint32 Word = Mask[WordIndex];
+        while (Word != 0)
+        {
+            // Pop the lowest set bit each iteration
+            OutIndices.Add(WordIndex * 32 + int32(FMath::CountTrailingZeros(Word)));
+            Word &= Word - 1u;
+        }
+    }
+}
+
+/**
+ * In-place AND of two masks of equal length
+ */
+void FS__ViewShedResultColumns::AndMask(TArray<uint32> &InOutMask, TConstArrayView<uint32> Other)
+{
+    check(InOutMask.Num() == Other.Num());
+    for (int32 WordIndex = 0; WordIndex < InOutMask.Num(); ++WordIndex)
+    {
+        InOutMask[WordIndex] &= Other[WordIndex];
+    }
+}
+
+/**
+ * In-place OR of two masks of equal length
+ */
+void FS__ViewShedResultColumns::OrMask(TArray<uint32> &InOutMask, TConstArrayView<uint32> Other)
+{
+    check(InOutMask.Num() == Other.Num());
+    for (int32 WordIndex = 0; WordIndex < InOutMask.Num(); ++WordIndex)
+    {
+        InOutMask[WordIndex] |= Other[WordIndex];
+    }
+}
+
+/**
+ * In-place NOT of a mask covering NumBits results
+ */
+void FS__ViewShedResultColumns::NotMask(TArray<uint32> &InOutMask, int32 NumBits)
+{
+    for (uint32 &Word : InOutMask)
+    {
+        Word = ~Word;
+    }
+
+    // Keep padding bits cleared so counts stay exact
+    const int32 TailBits = NumBits & 31;
+    if (InOutMask.Num() > 0 && TailBits != 0)
+    {
+        InOutMask.Last() &= (1u << TailBits) - 1u;
+    }
+}
+
+/**
+ * Copy the selected results into a new, exactly sized array
+ */
+TArray<FS__ViewShedPoint> FS__ViewShedResultColumns::Materialize(TConstArrayView<FS__ViewShedPoint> Points, TConstArrayView<int32> Indices)
+{
+    TArray<FS__ViewShedPoint> Selected;
+    Selected.Reserve(Indices.Num());
+    for (const int32 Index : Indices)
+    {
+        if (Points.IsValidIndex(Index))
+        {
+            Selected.Add(Points[Index]);
+        }
+    }
+    return Selected;
+}
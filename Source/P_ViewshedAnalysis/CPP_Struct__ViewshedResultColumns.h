@@ -0,0 +1,71 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FS__ViewShedPoint;
+struct FS__ViewShedRayStore;
+struct FS__ViewShedHorizonMap;
+struct FS__ViewShedFilterPredicate;
+
+/**
+ * Packed per-result columns built once per analysis
+ * The filter kernels evaluate 32 results per mask word, so predicates produce bitmasks that can be
+ * combined with AND/OR/NOT before being expanded into index lists or materialized into points
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedResultColumns
+{
+    /** Rebuild all columns from the analysis results and their matching rays */
+    void Build(TConstArrayView<FS__ViewShedPoint> Points, const FS__ViewShedRayStore &Rays);
+
+    /** Rebuild all columns straight from a horizon map, one entry per ray, without expanding the band points */
+    void Build(const FS__ViewShedHorizonMap &Horizon, const FS__ViewShedRayStore &Rays);
+
+    /** Release all column storage */
+    void Reset();
+
+    /** Number of results described by the columns */
+    int32 Num() const { return NumResults; }
+
+    /** Number of 32-bit words in every mask over these columns */
+    int32 NumMaskWords() const { return (NumResults + 31) / 32; }
+
+    /** Evaluate a fused predicate into a bitmask (one bit per result) */
+    void FilterToMask(const FS__ViewShedFilterPredicate &Predicate, TArray<uint32> &OutMask) const;
+
+    /** Count the set bits in a mask */
+    static int32 CountMask(TConstArrayView<uint32> Mask);
+
+    /** Expand a mask into ascending result indices */
+    static void MaskToIndices(TConstArrayView<uint32> Mask, TArray<int32> &OutIndices);
+
+    /** In-place AND of two masks of equal length */
+    static void AndMask(TArray<uint32> &InOutMask, TConstArrayView<uint32> Other);
+
+    /** In-place OR of two masks of equal length */
+    static void OrMask(TArray<uint32> &InOutMask, TConstArrayView<uint32> Other);
+
+    /** In-place NOT of a mask covering NumBits results */
+    static void NotMask(TArray<uint32> &InOutMask, int32 NumBits);
+
+    /** Copy the selected results into a new array; the only step that touches the full point structs */
+    static TArray<FS__ViewShedPoint> Materialize(TConstArrayView<FS__ViewShedPoint> Points, TConstArrayView<int32> Indices);
+
+    /** One visibility bit per result */
+    TArray<uint32> VisibilityBits;
+
+    /** Sample distance per result, zero padded to a multiple of 32 for the SIMD kernel */
+    TArray<float> Distances;
+
+    /** Distance band per result, zero padded like Distances */
+    TArray<uint8> BandIndices;
+
+private:
+    /** Number of valid results; columns may be padded beyond this */
+    int32 NumResults = 0;
+};
@@ -0,0 +1,327 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedResultFile.h"
+#include "CPP_Actor__Viewshed.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace ViewshedResultFile
+{
+    /** Every section starts on this boundary so mapped arrays are naturally aligned */
+    static constexpr uint64 SectionAlignment = 16;
+
+    /** Append zero bytes until Buffer is aligned and return the aligned offset */
+    static uint64 AlignBuffer(TArray<uint8> &Buffer)
+    {
+        const uint64 Aligned = Align(uint64(Buffer.Num()), SectionAlignment);
+        Buffer.AddZeroed(int32(Aligned - uint64(Buffer.Num())));
+        return Aligned;
+    }
+
+    /** Append a raw array as a new aligned section and return its offset */
+    template <typename T>
+    static uint64 AppendSection(TArray<uint8> &Buffer, const TArray<T> &Section)
+    {
+        const uint64 Offset = AlignBuffer(Buffer);
+        Buffer.Append(reinterpret_cast<const uint8 *>(Section.GetData()), Section.Num() * sizeof(T));
+        return Offset;
+    }
+}
+
+FS__ViewShedResultFileView::FS__ViewShedResultFileView() = default;
+
+FS__ViewShedResultFileView::~FS__ViewShedResultFileView()
+{
+    Close();
+}
+
+/**
+ * Open and validate a result file, preferring a memory mapping
+ */
+bool FS__ViewShedResultFileView::Open(const FString &FilePath)
+{
+    Close();
+
+    IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+    if (MappedHandle.IsValid() && MappedHandle->GetFileSize() > 0)
+    {
+        MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+    }
+
+    if (MappedRegion.IsValid())
+    {
+        Data = MappedRegion->GetMappedPtr();
+        DataSize = uint64(MappedRegion->GetMappedSize());
+    }
+    else
+    {
+        // Platform (or pak) without mapping support: fall back to a single read
+        MappedHandle.Reset();
+        if (!FFileHelper::LoadFileToArray(OwnedBuffer, *FilePath))
+        {
+            return false;
+        }
+        Data = OwnedBuffer.GetData();
+        DataSize = uint64(OwnedBuffer.Num());
+    }
+
+    // Validate the header and every section before handing out views
+    const bool bHeaderValid = Data && DataSize >= sizeof(FS__ViewShedResultFileHeader) &&
+                              GetHeader().Magic == FS__ViewShedResultFileHeader::FileMagic &&
+                              GetHeader().Version == FS__ViewShedResultFileHeader::FileVersion &&
+                              GetHeader().ResultCount >= 0;
+    if (!bHeaderValid)
+    {
+        Close();
+        return false;
+    }
+
+    const FS__ViewShedResultFileHeader &Header = GetHeader();
+    const uint64 Count = uint64(Header.ResultCount);
+    bool bSectionsValid = GetSection(Header.HitDistancesOffset, Count * sizeof(float)) != nullptr &&
+                          GetSection(Header.VisibilityOffset, ((Count + 31) / 32) * sizeof(uint32)) != nullptr;
+    if (Header.Flags & FS__ViewShedResultFileHeader::Flag_Normals)
+    {
+        bSectionsValid &= GetSection(Header.NormalsOffset, Count * sizeof(uint32)) != nullptr;
+    }
+    if (Header.Flags & FS__ViewShedResultFileHeader::Flag_ActorTable)
+    {
+        bSectionsValid &= GetSection(Header.ActorIndicesOffset, Count * sizeof(uint16)) != nullptr &&
+                          GetSection(Header.ActorTableOffset, Header.ActorTableSize) != nullptr;
+    }
+    if (!bSectionsValid)
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Release the mapping or buffer
+ */
+void FS__ViewShedResultFileView::Close()
+{
+    // Region must be released before its handle
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+    OwnedBuffer.Empty();
+    Data = nullptr;
+    DataSize = 0;
+}
+
+/**
+ * Bounds-checked pointer to a section
+ */
+const uint8 *FS__ViewShedResultFileView::GetSection(uint64 Offset, uint64 Size) const
+{
+    if (!Data || Offset == 0 || Offset % ViewshedResultFile::SectionAlignment != 0 || Offset > DataSize || Size > DataSize - Offset)
+    {
+        return nullptr;
+    }
+    return Data + Offset;
+}
+
+TConstArrayView<float> FS__ViewShedResultFileView::GetHitDistances() const
+{
+    if (!IsOpen())
+    {
+        return {};
+    }
+    return TConstArrayView<float>(reinterpret_cast<const float *>(Data + GetHeader().HitDistancesOffset), GetHeader().ResultCount);
+}
+
+TConstArrayView<uint32> FS__ViewShedResultFileView::GetVisibilityBits() const
+{
+    if (!IsOpen())
+    {
+        return {};
+    }
+    return TConstArrayView<uint32>(reinterpret_cast<const uint32 *>(Data + GetHeader().VisibilityOffset), (GetHeader().ResultCount + 31) / 32);
+}
+
+TConstArrayView<uint32> FS__ViewShedResultFileView::GetPackedNormals() const
+{
+    if (!IsOpen() || !(GetHeader().Flags & FS__ViewShedResultFileHeader::Flag_Normals))
+    {
+        return {};
+    }
+    return TConstArrayView<uint32>(reinterpret_cast<const uint32 *>(Data + GetHeader().NormalsOffset), GetHeader().ResultCount);
+}
+
+TConstArrayView<uint16> FS__ViewShedResultFileView::GetActorIndices() const
+{
+    if (!IsOpen() || !(GetHeader().Flags & FS__ViewShedResultFileHeader::Flag_ActorTable))
+    {
+        return {};
+    }
+    return TConstArrayView<uint16>(reinterpret_cast<const uint16 *>(Data + GetHeader().ActorIndicesOffset), GetHeader().ResultCount);
+}
+
+/**
+ * Decode the actor table
+ */
+TArray<FString> FS__ViewShedResultFileView::ReadActorTable() const
+{
+    TArray<FString> ActorPaths;
+    if (!IsOpen() || !(GetHeader().Flags & FS__ViewShedResultFileHeader::Flag_ActorTable))
+    {
+        return ActorPaths;
+    }
+
+    FMemoryReaderView Reader(TArrayView<const uint8>(Data + GetHeader().ActorTableOffset, int32(GetHeader().ActorTableSize)));
+    Reader << ActorPaths;
+    if (Reader.IsError())
+    {
+        ActorPaths.Empty();
+    }
+    return ActorPaths;
+}
+
+/**
+ * Write a result file
+ */
+bool FS__ViewShedResultFileView::Write(const FString &FilePath, FS__ViewShedResultFileHeader Header, TConstArrayView<FS__ViewShedPoint> Points,
+                                       const FVector &RayOrigin, bool bIncludeNormals, bool bIncludeActorTable)
+{
+    const int32 Count = Points.Num();
+    Header.Magic = FS__ViewShedResultFileHeader::FileMagic;
+    Header.Version = FS__ViewShedResultFileHeader::FileVersion;
+    Header.ResultCount = Count;
+    Header.Flags = (bIncludeNormals ? FS__ViewShedResultFileHeader::Flag_Normals : 0u) |
+                   (bIncludeActorTable ? FS__ViewShedResultFileHeader::Flag_ActorTable : 0u);
+
+    // Pack per-ray columns
+    TArray<float> HitDistances;
+    TArray<uint32> VisibilityBits;
+    TArray<uint32> PackedNormals;
+    TArray<uint16> ActorIndices;
+    TArray<FString> ActorPaths;
+    TMap<const AActor *, uint16> ActorLookup;
+
+    HitDistances.SetNumUninitialized(Count);
+    VisibilityBits.SetNumZeroed((Count + 31) / 32);
+    if (bIncludeNormals)
+    {
+        PackedNormals.SetNumUninitialized(Count);
+    }
+    if (bIncludeActorTable)
+    {
+        ActorIndices.SetNumUninitialized(Count);
+    }
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const FS__ViewShedPoint &Point = Points[i];
+        HitDistances[i] = float(FVector::Dist(RayOrigin, Point.HitLocation));
+        VisibilityBits[i >> 5] |= uint32(Point.bIsVisible) << (i & 31);
+
+        if (bIncludeNormals)
+        {
+            PackedNormals[i] = EncodeNormal(Point.HitNormal);
+        }
+
+        if (bIncludeActorTable)
+        {
+            uint16 ActorIndex = MAX_uint16;
+            if (IsValid(Point.HitActor))
+            {
+                if (const uint16 *Existing = ActorLookup.Find(Point.HitActor))
+                {
+                    ActorIndex = *Existing;
+                }
+                else if (ActorPaths.Num() < MAX_uint16)
+                {
+                    ActorIndex = uint16(ActorPaths.Add(Point.HitActor->GetPathName()));
+                    ActorLookup.Add(Point.HitActor, ActorIndex);
+                }
+            }
+            ActorIndices[i] = ActorIndex;
+        }
+    }
+
+    // Lay out the file: header, then each section on an aligned boundary
+    TArray<uint8> Buffer;
+    Buffer.AddZeroed(sizeof(FS__ViewShedResultFileHeader));
+    Header.HitDistancesOffset = ViewshedResultFile::AppendSection(Buffer, HitDistances);
+    Header.VisibilityOffset = ViewshedResultFile::AppendSection(Buffer, VisibilityBits);
+    if (bIncludeNormals)
+    {
+        Header.NormalsOffset = ViewshedResultFile::AppendSection(Buffer, PackedNormals);
+    }
+    if (bIncludeActorTable)
+    {
+        Header.ActorIndicesOffset = ViewshedResultFile::AppendSection(Buffer, ActorIndices);
+
+        TArray<uint8> TableBytes;
+        FMemoryWriter Writer(TableBytes);
+        Writer << ActorPaths;
+        Header.ActorTableOffset = ViewshedResultFile::AppendSection(Buffer, TableBytes);
+        Header.ActorTableSize = uint64(TableBytes.Num());
+    }
+
+    FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(Header));
+    return FFileHelper::SaveArrayToFile(Buffer, *FilePath);
+}
+
+/**
+ * Encode a unit normal into 16:16 octahedral form
+ */
+uint32 FS__ViewShedResultFileView::EncodeNormal(const FVector &Normal)
+{
+    FVector N = Normal;
+    if (!N.Normalize())
+    {
+        return 0u;
+    }
+
+    // Project onto the octahedron and fold the lower hemisphere
+    const double L1 = FMath::Abs(N.X) + FMath::Abs(N.Y) + FMath::Abs(N.Z);
+    double U = N.X / L1;
+    double V = N.Y / L1;
+    if (N.Z < 0.0)
+    {
+        const double FoldedU = (1.0 - FMath::Abs(V)) * (U >= 0.0 ? 1.0 : -1.0);
+        const double FoldedV = (1.0 - FMath::Abs(U)) * (V >= 0.0 ? 1.0 : -1.0);
+        U = FoldedU;
+        V = FoldedV;
+    }
+
+    // Quantize [-1, 1] into [1, 65535] so 0 stays reserved for "no normal"
+    const uint32 QU = uint32(FMath::Clamp(FMath::RoundToInt((U * 0.5 + 0.5) * 65534.0) + 1, 1, 65535));
+    const uint32 QV = uint32(FMath::Clamp(FMath::RoundToInt((V * 0.5 + 0.5) * 65534.0) + 1, 1, 65535));
+    return QU | (QV << 16);
+}
+
+/**
+ * Decode a 16:16 octahedral normal
+ */
+FVector FS__ViewShedResultFileView::DecodeNormal(uint32 Packed)
+{
+    if (Packed == 0u)
+    {
+        return FVector::ZeroVector;
+    }
+
+    const double U = (double((Packed & 0xFFFFu) - 1u) / 65534.0) * 2.0 - 1.0;
+    const double V = (double((Packed >> 16) - 1u) / 65534.0) * 2.0 - 1.0;
+    FVector N(U, V, 1.0 - FMath::Abs(U) - FMath::Abs(V));
+    if (N.Z < 0.0)
+    {
+        const double UnfoldedX = (1.0 - FMath::Abs(N.Y)) * (N.X >= 0.0 ? 1.0 : -1.0);
+        const double UnfoldedY = (1.0 - FMath::Abs(N.X)) * (N.Y >= 0.0 ? 1.0 : -1.0);
+        N.X = UnfoldedX;
+        N.Y = UnfoldedY;
+    }
+    return N.GetSafeNormal();
+}
@@ -0,0 +1,133 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FS__ViewShedPoint;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Fixed-size header at the start of a viewshed result file
+ * Every section offset is 16-byte aligned, so a memory-mapped file can be read in place
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedResultFileHeader
+{
+    /** File identifier and current layout version */
+    static constexpr uint32 FileMagic = 0x52485356; // "VSHR"
+    static constexpr uint32 FileVersion = 1;
+
+    /** Section flags */
+    static constexpr uint32 Flag_Normals = 1u << 0;
+    static constexpr uint32 Flag_ActorTable = 1u << 1;
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+
+    /** Hash of the sampling configuration that produced the rays (see ACPP_Actor__Viewshed::ComputeConfigHash) */
+    uint64 ConfigHash = 0;
+
+    /** Observer location and rotation at analysis time */
+    double ObserverLocation[3] = {0.0, 0.0, 0.0};
+    double ObserverRotation[4] = {0.0, 0.0, 0.0, 1.0};
+
+    /** Ray lattice dimensions */
+    int32 DistanceBandCount = 0;
+    int32 HorizontalSampleCount = 0;
+    int32 VerticalSampleCount = 0;
+
+    /** Number of rays / results */
+    int32 ResultCount = 0;
+
+    /** Combination of Flag_* values */
+    uint32 Flags = 0;
+    uint32 Padding = 0;
+
+    /** Byte offsets of each section from the start of the file (0 when absent) */
+    uint64 HitDistancesOffset = 0;
+    uint64 VisibilityOffset = 0;
+    uint64 NormalsOffset = 0;
+    uint64 ActorIndicesOffset = 0;
+    uint64 ActorTableOffset = 0;
+    uint64 ActorTableSize = 0;
+};
+
+/**
+ * Read-only view over a viewshed result file
+ * Opens through memory mapping when the platform supports it, so the per-ray sections are used in place
+ * without copies; otherwise the file is read into an owned buffer and the same views are returned
+ */
+class P_VIEWSHEDANALYSIS_API FS__ViewShedResultFileView
+{
+public:
+    FS__ViewShedResultFileView();
+    ~FS__ViewShedResultFileView();
+
+    /** Open and validate a result file; returns false if missing, truncated or of another version */
+    bool Open(const FString &FilePath);
+
+    /** Release the mapping or buffer */
+    void Close();
+
+    /** Whether a valid file is open */
+    bool IsOpen() const { return Data != nullptr; }
+
+    /** Whether the file is being read through a memory mapping */
+    bool IsMemoryMapped() const { return MappedRegion != nullptr; }
+
+    /** Validated file header */
+    const FS__ViewShedResultFileHeader &GetHeader() const { return *reinterpret_cast<const FS__ViewShedResultFileHeader *>(Data); }
+
+    /** Distance from the observer to each ray's hit (or end) location */
+    TConstArrayView<float> GetHitDistances() const;
+
+    /** One visibility bit per ray */
+    TConstArrayView<uint32> GetVisibilityBits() const;
+
+    /** Octahedron-encoded hit normal per ray (empty if not stored) */
+    TConstArrayView<uint32> GetPackedNormals() const;
+
+    /** Index into the actor table per ray, MAX_uint16 for no actor (empty if not stored) */
+    TConstArrayView<uint16> GetActorIndices() const;
+
+    /** Decode the actor table (object paths of hit actors) */
+    TArray<FString> ReadActorTable() const;
+
+    /** Whether ray Index is visible */
+    bool IsVisible(int32 Index) const { return (GetVisibilityBits()[Index >> 5] >> (Index & 31)) & 1u; }
+
+    /**
+     * Write a result file
+     * @param Header - Configuration hash, observer transform and lattice dimensions; offsets and counts are filled in
+     * @param Points - Results, one per ray
+     * @param RayOrigin - Trace start shared by every ray, used to convert hit locations into distances
+     */
+    static bool Write(const FString &FilePath, FS__ViewShedResultFileHeader Header, TConstArrayView<FS__ViewShedPoint> Points,
+                      const FVector &RayOrigin, bool bIncludeNormals, bool bIncludeActorTable);
+
+    /** Encode a unit normal into 16:16 octahedral form (zero vector encodes to 0) */
+    static uint32 EncodeNormal(const FVector &Normal);
+
+    /** Decode a 16:16 octahedral normal */
+    static FVector DecodeNormal(uint32 Packed);
+
+private:
+    /** Bounds-checked pointer to a section */
+    const uint8 *GetSection(uint64 Offset, uint64 Size) const;
+
+    /** Memory mapping (when used) */
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** Fallback storage when mapping is unavailable */
+    TArray<uint8> OwnedBuffer;
+
+    /** Start and size of the file contents */
+    const uint8 *Data = nullptr;
+    uint64 DataSize = 0;
+};
@@ -0,0 +1,367 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedSamplingPattern.h"
+#include "CPP_Actor__Viewshed.h"
+#include "CompGeom/Delaunay2.h"
+#include "Math/RandomStream.h"
+#include "Misc/ScopeLock.h"
+
+namespace ViewshedSamplingPattern
+{
+    /**
+     * Samples a near-hexagonal pattern needs per square-grid sample for the same covering radius
+     * (hexagonal covering density 2*Pi/(3*sqrt(3)) over the square lattice's Pi/2)
+     */
+    static constexpr float HexagonalCoverageRatio = 0.7698f;
+
+    /** Fraction of its cell a blue-noise sample may be jittered across; below 1 so neighbours never coincide */
+    static constexpr float JitterAmount = 0.7f;
+
+    /** Fixed jitter seed, so a configuration always regenerates the same rays */
+    static constexpr int32 JitterSeed = 0x56534E42;
+
+    /** Upper bound on lookup cells per axis */
+    static constexpr int32 MaxLookupCells = 1024;
+
+    /** Pattern key: pattern, sample count and half FOVs */
+    using FKey = TTuple<uint8, int32, float, float>;
+
+    /** Live patterns; entries expire with their last holder */
+    static TMap<FKey, TWeakPtr<const FS__ViewShedSamplingPattern>> Patterns;
+    static FCriticalSection PatternsLock;
+
+    /** Solid angle of a field of view, in steradians */
+    static float GetSolidAngle(float HalfHorizontalFOV, float HalfVerticalFOV)
+    {
+        return 4.0f * HalfHorizontalFOV * FMath::Sin(FMath::Min(HalfVerticalFOV, HALF_PI));
+    }
+}
+
+/**
+ * Direction count matching the angular coverage of a grid over the same field of view
+ */
+int32 FS__ViewShedSamplingPattern::ComputeTargetCount(E__ViewShedSamplingPattern InPattern, int32 GridHorizontalCount, int32 GridVerticalCount, float InHalfHorizontalFOV, float InHalfVerticalFOV)
+{
+    using namespace ViewshedSamplingPattern;
+    const float YawStep = GridHorizontalCount > 1 ? 2.0f * InHalfHorizontalFOV / float(GridHorizontalCount - 1) : 2.0f * InHalfHorizontalFOV;
+    const float PitchStep = GridVerticalCount > 1 ? 2.0f * InHalfVerticalFOV / float(GridVerticalCount - 1) : 2.0f * InHalfVerticalFOV;
+    const float CellSolidAngle = FMath::Max(YawStep * PitchStep, UE_KINDA_SMALL_NUMBER);
+
+    // Jittered samples do not pack hexagonally, so blue noise keeps the grid's density and only saves the polar excess
+    const float PackingRatio = InPattern == E__ViewShedSamplingPattern::BlueNoise ? 1.0f : HexagonalCoverageRatio;
+    const float Count = GetSolidAngle(InHalfHorizontalFOV, InHalfVerticalFOV) / CellSolidAngle * PackingRatio;
+    return FMath::Clamp(FMath::CeilToInt32(Count), 3, GridHorizontalCount * GridVerticalCount);
+}
+
+/**
+ * Shared pattern for a configuration
+ */
+TSharedRef<const FS__ViewShedSamplingPattern> FS__ViewShedSamplingPattern::Find(E__ViewShedSamplingPattern InPattern, int32 InTargetCount, float InHalfHorizontalFOV, float InHalfVerticalFOV)
+{
+    using namespace ViewshedSamplingPattern;
+    const FKey Key(uint8(InPattern), FMath::Max(1, InTargetCount), InHalfHorizontalFOV, InHalfVerticalFOV);
+
+    FScopeLock Lock(&PatternsLock);
+    if (const TWeakPtr<const FS__ViewShedSamplingPattern> *Existing = Patterns.Find(Key))
+    {
+        if (TSharedPtr<const FS__ViewShedSamplingPattern> Pattern = Existing->Pin())
+        {
+            return Pattern.ToSharedRef();
+        }
+    }
+
+    // Drop expired entries while the lock is held anyway, so the map stays as small as the set of live configs
+    for (auto It = Patterns.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TSharedRef<FS__ViewShedSamplingPattern> Pattern = MakeShared<FS__ViewShedSamplingPattern>();
+    Pattern->Pattern = InPattern;
+    Pattern->TargetCount = Key.Get<1>();
+    Pattern->HalfHorizontalFOV = InHalfHorizontalFOV;
+    Pattern->HalfVerticalFOV = InHalfVerticalFOV;
+    if (InPattern == E__ViewShedSamplingPattern::Fibonacci)
+    {
+        Pattern->GenerateFibonacci();
+    }
+    else
+    {
+        Pattern->GenerateRings(InPattern == E__ViewShedSamplingPattern::BlueNoise);
+    }
+    Pattern->BuildTopology();
+    Patterns.Add(Key, Pattern);
+    return Pattern;
+}
+
+/**
+ * Spherical Fibonacci lattice restricted to the field of view
+ * Point i of an M-point sphere sits at height 1 - (2i + 1) / M and turns by the golden angle per point; the heights
+ * inside the vertical FOV are one contiguous index range, and M is chosen so about TargetCount points fall in the FOV
+ */
+void FS__ViewShedSamplingPattern::GenerateFibonacci()
+{
+    using namespace ViewshedSamplingPattern;
+    const double SinHalfVertical = FMath::Sin(FMath::Min(double(HalfVerticalFOV), double(HALF_PI)));
+    const double CoveredFraction = FMath::Max(double(GetSolidAngle(HalfHorizontalFOV, HalfVerticalFOV)) / (4.0 * UE_DOUBLE_PI), UE_DOUBLE_KINDA_SMALL_NUMBER);
+    const int64 SphereCount = FMath::Max<int64>(TargetCount, int64(FMath::CeilToDouble(double(TargetCount) / CoveredFraction)));
+
+    const int64 FirstIndex = FMath::Max<int64>(0, int64(FMath::CeilToDouble((double(SphereCount) * (1.0 - SinHalfVertical) - 1.0) * 0.5)));
+    const int64 LastIndex = FMath::Min<int64>(SphereCount - 1, int64(FMath::FloorToDouble((double(SphereCount) * (1.0 + SinHalfVertical) - 1.0) * 0.5)));
+    const double InverseGoldenRatio = 0.5 * (FMath::Sqrt(5.0) - 1.0);
+
+    Angles.Reset();
+    Angles.Reserve(TargetCount + TargetCount / 8);
+    for (int64 Index = FirstIndex; Index <= LastIndex; ++Index)
+    {
+        const double Turn = FMath::Frac(double(Index) * InverseGoldenRatio);
+        const double Yaw = (Turn > 0.5 ? Turn - 1.0 : Turn) * UE_DOUBLE_TWO_PI;
+        if (FMath::Abs(Yaw) > HalfHorizontalFOV)
+        {
+            continue;
+        }
+        const double Height = 1.0 - (2.0 * double(Index) + 1.0) / double(SphereCount);
+        // A positive pitch points down
+        Angles.Emplace(float(Yaw), float(-FMath::Asin(FMath::Clamp(Height, -1.0, 1.0))));
+    }
+}
+
+/**
+ * Iso-latitude rings of equal-area cells (HEALPix-style), optionally jittered within each cell
+ * Ring spacing is sqrt(3)/2 of the in-ring spacing and alternate rings are offset by half a cell, so the samples pack
+ * hexagonally; each ring's sample count follows its circumference, which keeps every cell's solid angle equal
+ */
+void FS__ViewShedSamplingPattern::GenerateRings(bool bJitter)
+{
+    using namespace ViewshedSamplingPattern;
+    const float CellSolidAngle = GetSolidAngle(HalfHorizontalFOV, HalfVerticalFOV) / float(TargetCount);
+    const float Spacing = FMath::Sqrt(2.0f * CellSolidAngle / UE_SQRT_3);
+    const int32 RingCount = FMath::Max(1, FMath::RoundToInt32(2.0f * HalfVerticalFOV / (Spacing * UE_HALF_SQRT_3)) + 1);
+    const float RingStep = RingCount > 1 ? 2.0f * HalfVerticalFOV / float(RingCount - 1) : 0.0f;
+
+    FRandomStream Random(JitterSeed);
+    Angles.Reset();
+    Angles.Reserve(TargetCount + TargetCount / 8);
+    for (int32 Ring = 0; Ring < RingCount; ++Ring)
+    {
+        const float Pitch = RingCount > 1 ? -HalfVerticalFOV + float(Ring) * RingStep : 0.0f;
+        const int32 EdgeCount = FMath::Max(1, FMath::RoundToInt32(2.0f * HalfHorizontalFOV * FMath::Cos(Pitch) / Spacing) + 1);
+        const float YawStep = EdgeCount > 1 ? 2.0f * HalfHorizontalFOV / float(EdgeCount - 1) : 0.0f;
+
+        // Even rings reach both FOV edges; odd rings sit between them
+        const bool bOffset = (Ring & 1) != 0 && EdgeCount > 1;
+        const int32 SampleCount = bOffset ? EdgeCount - 1 : EdgeCount;
+        for (int32 Sample = 0; Sample < SampleCount; ++Sample)
+        {
+            float Yaw = EdgeCount > 1 ? -HalfHorizontalFOV + (float(Sample) + (bOffset ? 0.5f : 0.0f)) * YawStep : 0.0f;
+            float SamplePitch = Pitch;
+            if (bJitter)
+            {
+                Yaw = FMath::Clamp(Yaw + (Random.GetFraction() - 0.5f) * JitterAmount * YawStep, -HalfHorizontalFOV, HalfHorizontalFOV);
+                SamplePitch = FMath::Clamp(Pitch + (Random.GetFraction() - 0.5f) * JitterAmount * RingStep, -HalfVerticalFOV, HalfVerticalFOV);
+            }
+            Angles.Emplace(Yaw, SamplePitch);
+        }
+    }
+}
+
+/**
+ * Fill Directions, Triangles, the neighbour lists and the lookup grid from Angles
+ */
+void FS__ViewShedSamplingPattern::BuildTopology()
+{
+    using namespace ViewshedSamplingPattern;
+    // A field of view narrower than the spacing still gets its central ray
+    if (Angles.IsEmpty())
+    {
+        Angles.Emplace(0.0f, 0.0f);
+    }
+    const int32 Count = Angles.Num();
+
+    // Single-row direction table, padded like the lattice tables
+    Directions.HorizontalSampleCount = Count;
+    Directions.VerticalSampleCount = 1;
+    Directions.HalfHorizontalFOV = HalfHorizontalFOV;
+    Directions.HalfVerticalFOV = HalfVerticalFOV;
+    const int32 PaddedNum = Align(Count, 4);
+    Directions.X.SetNumZeroed(PaddedNum);
+    Directions.Y.SetNumZeroed(PaddedNum);
+    Directions.Z.SetNumZeroed(PaddedNum);
+    TArray<FVector2d> Projected;
+    Projected.SetNumUninitialized(Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const FVector2f &Angle = Angles[i];
+        const float CosPitch = FMath::Cos(Angle.Y);
+        Directions.X[i] = CosPitch * FMath::Cos(Angle.X);
+        Directions.Y[i] = CosPitch * FMath::Sin(Angle.X);
+        Directions.Z[i] = -FMath::Sin(Angle.Y);
+        Projected[i] = Project(Angle);
+    }
+
+    // Delaunay triangulation in the projection, every triangle wound the same way
+    Triangles.Reset();
+    UE::Geometry::FDelaunay2 Delaunay;
+    if (Count >= 3 && Delaunay.Triangulate(Projected))
+    {
+        for (const UE::Geometry::FIndex3i &Triangle : Delaunay.GetTriangles())
+        {
+            const FVector2d AB = Projected[Triangle.B] - Projected[Triangle.A];
+            const FVector2d AC = Projected[Triangle.C] - Projected[Triangle.A];
+            const bool bClockwise = AB.X * AC.Y - AB.Y * AC.X < 0.0;
+            Triangles.Emplace(Triangle.A, bClockwise ? Triangle.C : Triangle.B, bClockwise ? Triangle.B : Triangle.C);
+        }
+    }
+
+    // Neighbour lists from the triangle edges, deduplicated by sorting both directions of every edge
+    TArray<FIntPoint> Edges;
+    Edges.Reserve(Triangles.Num() * 6);
+    for (const FIntVector &Triangle : Triangles)
+    {
+        Edges.Emplace(Triangle.X, Triangle.Y);
+        Edges.Emplace(Triangle.Y, Triangle.X);
+        Edges.Emplace(Triangle.Y, Triangle.Z);
+        Edges.Emplace(Triangle.Z, Triangle.Y);
+        Edges.Emplace(Triangle.Z, Triangle.X);
+        Edges.Emplace(Triangle.X, Triangle.Z);
+    }
+    Edges.Sort([](const FIntPoint &A, const FIntPoint &B)
+               { return A.X != B.X ? A.X < B.X : A.Y < B.Y; });
+
+    NeighborOffsets.Init(0, Count + 1);
+    Neighbors.Reset(Edges.Num() / 2);
+    double SpacingSum = 0.0;
+    for (int32 i = 0; i < Edges.Num(); ++i)
+    {
+        if (i > 0 && Edges[i] == Edges[i - 1])
+        {
+            continue;
+        }
+        Neighbors.Add(Edges[i].Y);
+        ++NeighborOffsets[Edges[i].X + 1];
+        SpacingSum += FMath::Acos(FMath::Clamp(GetLocalDirection(Edges[i].X) | GetLocalDirection(Edges[i].Y), -1.0, 1.0));
+    }
+    for (int32 i = 0; i < Count; ++i)
+    {
+        NeighborOffsets[i + 1] += NeighborOffsets[i];
+    }
+    SampleSpacing = Neighbors.IsEmpty() ? 2.0f * FMath::Max(HalfHorizontalFOV, HalfVerticalFOV) : float(SpacingSum / double(Neighbors.Num()));
+
+    // Lookup cells about two spacings wide: one seed per cell, empty cells borrow the previous seed in scan order
+    const float CellSize = FMath::Max(2.0f * SampleSpacing, UE_KINDA_SMALL_NUMBER);
+    LookupColumns = FMath::Clamp(FMath::CeilToInt32(2.0f * HalfHorizontalFOV / CellSize), 1, MaxLookupCells);
+    LookupRows = FMath::Clamp(FMath::CeilToInt32(2.0f * HalfVerticalFOV / CellSize), 1, MaxLookupCells);
+    LookupSeeds.Init(INDEX_NONE, LookupColumns * LookupRows);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        int32 &Seed = LookupSeeds[GetLookupCell(Projected[i])];
+        if (Seed == INDEX_NONE)
+        {
+            Seed = i;
+        }
+    }
+    int32 LastSeed = Count > 0 ? 0 : INDEX_NONE;
+    for (int32 &Seed : LookupSeeds)
+    {
+        Seed = Seed == INDEX_NONE ? LastSeed : Seed;
+        LastSeed = Seed;
+    }
+}
+
+/**
+ * Lookup cell of a projected position
+ */
+int32 FS__ViewShedSamplingPattern::GetLookupCell(const FVector2D &Projected) const
+{
+    const float U = HalfHorizontalFOV > 0.0f ? float(Projected.X + HalfHorizontalFOV) / (2.0f * HalfHorizontalFOV) : 0.5f;
+    const float V = HalfVerticalFOV > 0.0f ? float(Projected.Y + HalfVerticalFOV) / (2.0f * HalfVerticalFOV) : 0.5f;
+    const int32 Column = FMath::Clamp(FMath::FloorToInt32(U * float(LookupColumns)), 0, LookupColumns - 1);
+    const int32 Row = FMath::Clamp(FMath::FloorToInt32(V * float(LookupRows)), 0, LookupRows - 1);
+    return Row * LookupColumns + Column;
+}
+
+/**
+ * Observer-local direction of a sample
+ */
+FVector FS__ViewShedSamplingPattern::GetLocalDirection(int32 Index) const
+{
+    return FVector(Directions.X[Index], Directions.Y[Index], Directions.Z[Index]);
+}
+
+/**
+ * Samples sharing a triangle edge with Index
+ */
+TConstArrayView<int32> FS__ViewShedSamplingPattern::GetNeighbors(int32 Index) const
+{
+    if (!NeighborOffsets.IsValidIndex(Index + 1))
+    {
+        return TConstArrayView<int32>();
+    }
+    return TConstArrayView<int32>(Neighbors.GetData() + NeighborOffsets[Index], NeighborOffsets[Index + 1] - NeighborOffsets[Index]);
+}
+
+/**
+ * Nearest sample to an observer-local direction
+ * Starts at the lookup cell's seed and walks the neighbour graph towards the direction; on a Delaunay graph the
+ * walk only stops at the nearest sample
+ */
+int32 FS__ViewShedSamplingPattern::FindNearest(const FVector &LocalDirection) const
+{
+    const FVector Direction = LocalDirection.GetSafeNormal();
+    if (Direction.IsZero() || LookupSeeds.IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+
+    const FVector2f Angle(float(FMath::Atan2(Direction.Y, Direction.X)), float(-FMath::Asin(FMath::Clamp(Direction.Z, -1.0, 1.0))));
+    // Samples span the full yaw range on every ring, so the angular slack widens in yaw by 1 / cos(pitch)
+    const float Slack = 0.5f * SampleSpacing;
+    if (FMath::Abs(Angle.Y) > HalfVerticalFOV + Slack ||
+        FMath::Abs(Angle.X) > HalfHorizontalFOV + Slack / FMath::Max(FMath::Cos(Angle.Y), KINDA_SMALL_NUMBER))
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Current = LookupSeeds[GetLookupCell(Project(Angle))];
+    if (Current == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+    double BestDot = GetLocalDirection(Current) | Direction;
+    for (int32 Step = 0; Step < Num(); ++Step)
+    {
+        int32 Next = INDEX_NONE;
+        for (const int32 Neighbor : GetNeighbors(Current))
+        {
+            const double Dot = GetLocalDirection(Neighbor) | Direction;
+            if (Dot > BestDot)
+            {
+                BestDot = Dot;
+                Next = Neighbor;
+            }
+        }
+        if (Next == INDEX_NONE)
+        {
+            break;
+        }
+        Current = Next;
+    }
+    return Current;
+}
+
+/**
+ * Position of a sample across the field of view
+ */
+FVector2D FS__ViewShedSamplingPattern::GetNormalizedPosition(int32 Index) const
+{
+    const FVector2f &Angle = Angles[Index];
+    return FVector2D(HalfHorizontalFOV > 0.0f ? (Angle.X + HalfHorizontalFOV) / (2.0f * HalfHorizontalFOV) : 0.5f,
+                     HalfVerticalFOV > 0.0f ? (Angle.Y + HalfVerticalFOV) / (2.0f * HalfVerticalFOV) : 0.5f);
+}
@@ -0,0 +1,90 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPP_Struct__ViewshedDirectionTable.h"
+
+enum class E__ViewShedSamplingPattern : uint8;
+
+/**
+ * Unstructured set of ray directions covering an observer's field of view, with its neighbour graph
+ * Directions are spread by solid angle instead of by yaw/pitch step, so no rays are spent crowding the top and bottom
+ * of the frustum. Samples are triangulated once in the sinusoidal (equal-area) projection; the triangles drive meshing
+ * and the neighbour lists drive nearest-direction lookups. Like the direction table, one immutable instance is shared
+ * by every observer with the same configuration.
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedSamplingPattern
+{
+    /** Configuration the pattern was built for */
+    E__ViewShedSamplingPattern Pattern{};
+    int32 TargetCount = 0;
+    float HalfHorizontalFOV = 0.0f;
+    float HalfVerticalFOV = 0.0f;
+
+    /** Yaw (X) and pitch (Y, positive down) of every sample, in radians; same convention as the lattice */
+    TArray<FVector2f> Angles;
+
+    /** Observer-local unit directions as a single-row table, so the shared SIMD rotation applies unchanged */
+    FS__ViewShedDirectionTable Directions;
+
+    /** Delaunay triangles over the samples, wound counter-clockwise in (yaw, pitch) */
+    TArray<FIntVector> Triangles;
+
+    /** Neighbour list of sample i is Neighbors[NeighborOffsets[i] .. NeighborOffsets[i + 1]) */
+    TArray<int32> NeighborOffsets;
+    TArray<int32> Neighbors;
+
+    /** Mean angular distance between neighbouring samples, in radians */
+    float SampleSpacing = 0.0f;
+
+    /** Number of samples */
+    int32 Num() const { return Angles.Num(); }
+
+    /**
+     * Direction count matching the angular coverage of a Horizontal x Vertical grid over the same field of view
+     * The grid's widest cell sits at zero pitch; the pattern spends that cell's solid angle everywhere instead
+     */
+    static int32 ComputeTargetCount(E__ViewShedSamplingPattern InPattern, int32 GridHorizontalCount, int32 GridVerticalCount, float InHalfHorizontalFOV, float InHalfVerticalFOV);
+
+    /**
+     * Shared pattern for a configuration: built on first request, released when the last holder lets go
+     * Safe to call from any thread
+     */
+    static TSharedRef<const FS__ViewShedSamplingPattern> Find(E__ViewShedSamplingPattern InPattern, int32 InTargetCount, float InHalfHorizontalFOV, float InHalfVerticalFOV);
+
+    /** Observer-local direction (X forward, Y right, Z up) of a sample */
+    FVector GetLocalDirection(int32 Index) const;
+
+    /** Samples sharing a triangle edge with Index */
+    TConstArrayView<int32> GetNeighbors(int32 Index) const;
+
+    /** Nearest sample to an observer-local direction, or INDEX_NONE outside the field of view (with half a spacing of slack) */
+    int32 FindNearest(const FVector &LocalDirection) const;
+
+    /** Position of a sample across the field of view, (0,0) at the top-left corner and (1,1) at the bottom-right */
+    FVector2D GetNormalizedPosition(int32 Index) const;
+
+private:
+    /** Fill Angles for the configuration */
+    void GenerateFibonacci();
+    void GenerateRings(bool bJitter);
+
+    /** Fill Directions, Triangles, the neighbour lists and the lookup grid from Angles */
+    void BuildTopology();
+
+    /** Sinusoidal projection of a yaw/pitch pair; distances in it approximate angular distances around the sample */
+    static FVector2D Project(const FVector2f &Angle) { return FVector2D(Angle.X * FMath::Cos(Angle.Y), Angle.Y); }
+
+    /** Lookup grid over the projection: one nearby sample per cell, where nearest-sample walks start */
+    int32 LookupColumns = 0;
+    int32 LookupRows = 0;
+    TArray<int32> LookupSeeds;
+
+    /** Lookup cell of a projected position */
+    int32 GetLookupCell(const FVector2D &Projected) const;
+};
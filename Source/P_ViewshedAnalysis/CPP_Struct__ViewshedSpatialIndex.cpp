@@ -0,0 +1,434 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedSpatialIndex.h"
+#include "CPP_Actor__Viewshed.h"
+
+/**
+ * Build the grid over a subset of analysis points
+ */
+void FS__ViewShedPointGrid::Build(TConstArrayView<FS__ViewShedPoint> Points, TConstArrayView<int32> PointIndices, int32 TargetPointsPerCell)
+{
+    BuildSorted(PointIndices, [Points, PointIndices](int32 i)
+                { return Points[PointIndices[i]].HitLocation; }, TargetPointsPerCell);
+}
+
+/**
+ * Build the grid over explicit locations
+ */
+void FS__ViewShedPointGrid::Build(TConstArrayView<FVector> Locations, TConstArrayView<int32> ResultIndices, int32 TargetPointsPerCell)
+{
+    check(Locations.Num() == ResultIndices.Num());
+    BuildSorted(ResultIndices, [Locations](int32 i)
+                { return Locations[i]; }, TargetPointsPerCell);
+}
+
+/**
+ * Counting-sort the entries into cells; GetLocation(i) is the location of ResultIndices[i]
+ * Cell size is derived from the two largest bounds extents because hit locations lie on surfaces,
+ * which keeps the average cell occupancy close to TargetPointsPerCell
+ */
+void FS__ViewShedPointGrid::BuildSorted(TConstArrayView<int32> ResultIndices, TFunctionRef<FVector(int32)> GetLocation, int32 TargetPointsPerCell)
+{
+    Reset();
+
+    if (ResultIndices.IsEmpty())
+    {
+        return;
+    }
+
+    // Compute bounds of the hit locations
+    FBox Bounds(ForceInit);
+    for (int32 i = 0; i < ResultIndices.Num(); ++i)
+    {
+        Bounds += GetLocation(i);
+    }
+
+    // Sort extents so the cell size follows the dominant surface area
+    const FVector Size = Bounds.GetSize();
+    double Extents[3] = {Size.X, Size.Y, Size.Z};
+    if (Extents[0] < Extents[1])
+        Swap(Extents[0], Extents[1]);
+    if (Extents[1] < Extents[2])
+        Swap(Extents[1], Extents[2]);
+    if (Extents[0] < Extents[1])
+        Swap(Extents[0], Extents[1]);
+
+    const int32 PointCount = ResultIndices.Num();
+    const double SafeTarget = double(FMath::Max(1, TargetPointsPerCell));
+    const double SurfaceArea = FMath::Max(Extents[0], 1.0) * FMath::Max(Extents[1], 1.0);
+    CellSize = FMath::Max(1.0, FMath::Sqrt(SurfaceArea * SafeTarget / double(PointCount)));
+
+    // Grow cells until the dense grid stays proportional to the point count
+    const int64 MaxCellCount = FMath::Max<int64>(64, int64(PointCount) * 4);
+    for (;;)
+    {
+        Dims.X = FMath::Max(1, FMath::CeilToInt(Size.X / CellSize) + 1);
+        Dims.Y = FMath::Max(1, FMath::CeilToInt(Size.Y / CellSize) + 1);
+        Dims.Z = FMath::Max(1, FMath::CeilToInt(Size.Z / CellSize) + 1);
+        if (int64(Dims.X) * int64(Dims.Y) * int64(Dims.Z) <= MaxCellCount)
+        {
+            break;
+        }
+        CellSize *= 1.5;
+    }
+    BoundsMin = Bounds.Min;
+
+    const int32 CellCount = Dims.X * Dims.Y * Dims.Z;
+
+    // Counting sort: first pass counts points per cell
+    TArray<int32> PointCells;
+    PointCells.SetNumUninitialized(PointCount);
+    CellStarts.SetNumZeroed(CellCount + 1);
+    for (int32 i = 0; i < PointCount; ++i)
+    {
+        const FIntVector Cell = GetClampedCell(GetLocation(i));
+        const int32 CellIndex = GetCellIndex(Cell.X, Cell.Y, Cell.Z);
+        PointCells[i] = CellIndex;
+        CellStarts[CellIndex + 1]++;
+    }
+
+    // Prefix sum turns counts into start offsets
+    for (int32 CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+    {
+        CellStarts[CellIndex + 1] += CellStarts[CellIndex];
+    }
+
+    // Second pass scatters indices and locations into their cells
+    TArray<int32> WriteCursor(CellStarts.GetData(), CellCount);
+    SortedIndices.SetNumUninitialized(PointCount);
+    SortedLocations.SetNumUninitialized(PointCount);
+    for (int32 i = 0; i < PointCount; ++i)
+    {
+        const int32 Slot = WriteCursor[PointCells[i]]++;
+        SortedIndices[Slot] = ResultIndices[i];
+        SortedLocations[Slot] = GetLocation(i);
+    }
+}
+
+/**
+ * Release all grid storage
+ */
+void FS__ViewShedPointGrid::Reset()
+{
+    BoundsMin = FVector::ZeroVector;
+    CellSize = 1.0;
+    Dims = FIntVector::ZeroValue;
+    CellStarts.Empty();
+    SortedIndices.Empty();
+    SortedLocations.Empty();
+}
+
+/**
+ * Cell coordinate containing Location, clamped to the grid
+ */
+FIntVector FS__ViewShedPointGrid::GetClampedCell(const FVector &Location) const
+{
+    const FVector Local = (Location - BoundsMin) / CellSize;
+    return FIntVector(
+        FMath::Clamp(FMath::FloorToInt(Local.X), 0, Dims.X - 1),
+        FMath::Clamp(FMath::FloorToInt(Local.Y), 0, Dims.Y - 1),
+        FMath::Clamp(FMath::FloorToInt(Local.Z), 0, Dims.Z - 1));
+}
+
+/**
+ * Find the closest point by visiting cell shells of increasing Chebyshev radius around the query cell
+ * A shell at radius R cannot contain anything closer than (R - 1) * CellSize, which bounds the search
+ */
+int32 FS__ViewShedPointGrid::FindNearest(const FVector &Location, float MaxDistance, double &InOutBestDistanceSquared) const
+{
+    if (IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+
+    if (MaxDistance > 0.0f)
+    {
+        InOutBestDistanceSquared = FMath::Min(InOutBestDistanceSquared, double(MaxDistance) * double(MaxDistance));
+    }
+
+    const FIntVector Center = GetClampedCell(Location);
+    const int32 MaxRing = FMath::Max3(Dims.X, Dims.Y, Dims.Z);
+    int32 BestIndex = INDEX_NONE;
+
+    for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+    {
+        // Stop once the nearest possible point in this shell is farther than the current best
+        const double RingMinDistance = FMath::Max(0, Ring - 1) * CellSize;
+        if (RingMinDistance * RingMinDistance > InOutBestDistanceSquared)
+        {
+            break;
+        }
+
+        const int32 MinX = FMath::Max(0, Center.X - Ring), MaxX = FMath::Min(Dims.X - 1, Center.X + Ring);
+        const int32 MinY = FMath::Max(0, Center.Y - Ring), MaxY = FMath::Min(Dims.Y - 1, Center.Y + Ring);
+        const int32 MinZ = FMath::Max(0, Center.Z - Ring), MaxZ = FMath::Min(Dims.Z - 1, Center.Z + Ring);
+
+        for (int32 Z = MinZ; Z <= MaxZ; ++Z)
+        {
+            for (int32 Y = MinY; Y <= MaxY; ++Y)
+            {
+                for (int32 X = MinX; X <= MaxX; ++X)
+                {
+                    // Only visit cells on the shell; inner cells were handled by earlier rings
+                    const int32 Chebyshev = FMath::Max3(FMath::Abs(X - Center.X), FMath::Abs(Y - Center.Y), FMath::Abs(Z - Center.Z));
+                    if (Chebyshev != Ring)
+                    {
+                        continue;
+                    }
+
+                    const int32 CellIndex = GetCellIndex(X, Y, Z);
+                    for (int32 Slot = CellStarts[CellIndex]; Slot < CellStarts[CellIndex + 1]; ++Slot)
+                    {
+                        const double DistanceSquared = FVector::DistSquared(SortedLocations[Slot], Location);
+                        if (DistanceSquared < InOutBestDistanceSquared)
+                        {
+                            InOutBestDistanceSquared = DistanceSquared;
+                            BestIndex = SortedIndices[Slot];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return BestIndex;
+}
+
+/**
+ * Merge the K closest points into a sorted candidate list using the same shell expansion as FindNearest
+ */
+void FS__ViewShedPointGrid::FindKNearest(const FVector &Location, int32 K, float MaxDistance, TArray<TPair<double, int32>> &InOutSortedCandidates) const
+{
+    if (IsEmpty() || K <= 0)
+    {
+        return;
+    }
+
+    const double MaxDistanceSquared = MaxDistance > 0.0f ? double(MaxDistance) * double(MaxDistance) : TNumericLimits<double>::Max();
+
+    // Current acceptance threshold: distance of the K-th candidate once the list is full
+    auto GetWorstAccepted = [&]() -> double
+    {
+        return InOutSortedCandidates.Num() >= K ? InOutSortedCandidates.Last().Key : MaxDistanceSquared;
+    };
+
+    const FIntVector Center = GetClampedCell(Location);
+    const int32 MaxRing = FMath::Max3(Dims.X, Dims.Y, Dims.Z);
+
+    for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+    {
+        const double RingMinDistance = FMath::Max(0, Ring - 1) * CellSize;
+        if (RingMinDistance * RingMinDistance > GetWorstAccepted())
+        {
+            break;
+        }
+
+        const int32 MinX = FMath::Max(0, Center.X - Ring), MaxX = FMath::Min(Dims.X - 1, Center.X + Ring);
+        const int32 MinY = FMath::Max(0, Center.Y - Ring), MaxY = FMath::Min(Dims.Y - 1, Center.Y + Ring);
+        const int32 MinZ = FMath::Max(0, Center.Z - Ring), MaxZ = FMath::Min(Dims.Z - 1, Center.Z + Ring);
+
+        for (int32 Z = MinZ; Z <= MaxZ; ++Z)
+        {
+            for (int32 Y = MinY; Y <= MaxY; ++Y)
+            {
+                for (int32 X = MinX; X <= MaxX; ++X)
+                {
+                    const int32 Chebyshev = FMath::Max3(FMath::Abs(X - Center.X), FMath::Abs(Y - Center.Y), FMath::Abs(Z - Center.Z));
+                    if (Chebyshev != Ring)
+                    {
+                        continue;
+                    }
+
+                    const int32 CellIndex = GetCellIndex(X, Y, Z);
+                    for (int32 Slot = CellStarts[CellIndex]; Slot < CellStarts[CellIndex + 1]; ++Slot)
+                    {
+                        const double DistanceSquared = FVector::DistSquared(SortedLocations[Slot], Location);
+                        if (DistanceSquared > GetWorstAccepted())
+                        {
+                            continue;
+                        }
+
+                        // Insertion keeps the small candidate list sorted; K is expected to be small
+                        int32 InsertAt = InOutSortedCandidates.Num();
+                        while (InsertAt > 0 && InOutSortedCandidates[InsertAt - 1].Key > DistanceSquared)
+                        {
+                            --InsertAt;
+                        }
+                        InOutSortedCandidates.Insert(TPair<double, int32>(DistanceSquared, SortedIndices[Slot]), InsertAt);
+                        if (InOutSortedCandidates.Num() > K)
+                        {
+                            InOutSortedCandidates.RemoveAt(InOutSortedCandidates.Num() - 1);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Append the indices of all points within Radius of Location
+ */
+void FS__ViewShedPointGrid::FindInRadius(const FVector &Location, float Radius, TArray<int32> &OutIndices) const
+{
+    if (IsEmpty() || Radius < 0.0f)
+    {
+        return;
+    }
+
+    const double RadiusSquared = double(Radius) * double(Radius);
+    const FIntVector MinCell = GetClampedCell(Location - FVector(Radius));
+    const FIntVector MaxCell = GetClampedCell(Location + FVector(Radius));
+
+    for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+            {
+                const int32 CellIndex = GetCellIndex(X, Y, Z);
+                for (int32 Slot = CellStarts[CellIndex]; Slot < CellStarts[CellIndex + 1]; ++Slot)
+                {
+                    if (FVector::DistSquared(SortedLocations[Slot], Location) <= RadiusSquared)
+                    {
+                        OutIndices.Add(SortedIndices[Slot]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Append the indices of all points inside Box
+ */
+void FS__ViewShedPointGrid::FindInBox(const FBox &Box, TArray<int32> &OutIndices) const
+{
+    if (IsEmpty() || !Box.IsValid)
+    {
+        return;
+    }
+
+    const FIntVector MinCell = GetClampedCell(Box.Min);
+    const FIntVector MaxCell = GetClampedCell(Box.Max);
+
+    for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+            {
+                const int32 CellIndex = GetCellIndex(X, Y, Z);
+                for (int32 Slot = CellStarts[CellIndex]; Slot < CellStarts[CellIndex + 1]; ++Slot)
+                {
+                    if (Box.IsInsideOrOn(SortedLocations[Slot]))
+                    {
+                        OutIndices.Add(SortedIndices[Slot]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Rebuild both grids from a full analysis result set
+ */
+void FS__ViewShedSpatialIndex::Build(TConstArrayView<FS__ViewShedPoint> Points, int32 TargetPointsPerCell)
+{
+    // Partition result indices by visibility so each grid only holds its own state
+    TArray<int32> VisibleIndices;
+    TArray<int32> HiddenIndices;
+    VisibleIndices.Reserve(Points.Num());
+    HiddenIndices.Reserve(Points.Num());
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        if (Points[i].bIsVisible)
+        {
+            VisibleIndices.Add(i);
+        }
+        else
+        {
+            HiddenIndices.Add(i);
+        }
+    }
+
+    VisibleGrid.Build(Points, VisibleIndices, TargetPointsPerCell);
+    HiddenGrid.Build(Points, HiddenIndices, TargetPointsPerCell);
+}
+
+/**
+ * Rebuild both grids with one visible and one hidden entry per lattice direction of a horizon map
+ * Bands are queued nearest first, so the last visible sample seen along a direction is its farthest one; every
+ * hidden sample along a direction lands on the same occluder, so the first one stands for all of them
+ */
+void FS__ViewShedSpatialIndex::Build(const FS__ViewShedHorizonMap &Horizon, const FS__ViewShedRayStore &Rays, int32 TargetPointsPerCell)
+{
+    const int32 DirectionCount = Horizon.Lattice.Num();
+    TArray<int32> VisibleIndices;
+    TArray<int32> HiddenIndices;
+    TArray<FVector> VisibleLocations;
+    TArray<FVector> HiddenLocations;
+    VisibleIndices.Init(INDEX_NONE, DirectionCount);
+    HiddenIndices.Init(INDEX_NONE, DirectionCount);
+    VisibleLocations.SetNumUninitialized(DirectionCount);
+    HiddenLocations.SetNumUninitialized(DirectionCount);
+
+    FS__ViewShedTracePoint TracePoint;
+    FS__ViewShedPoint Point;
+    for (int32 RayIndex = 0; RayIndex < Rays.Num(); ++RayIndex)
+    {
+        Rays.GetTracePoint(RayIndex, TracePoint);
+        const int32 DirectionIndex = Horizon.Lattice.ToIndex(TracePoint.HorizontalSampleIndex, TracePoint.VerticalSampleIndex);
+        if (DirectionIndex < 0 || DirectionIndex >= DirectionCount)
+        {
+            continue;
+        }
+        Horizon.DeriveBandPoint(TracePoint, Point);
+        if (Point.bIsVisible)
+        {
+            VisibleIndices[DirectionIndex] = RayIndex;
+            VisibleLocations[DirectionIndex] = Point.HitLocation;
+        }
+        else if (HiddenIndices[DirectionIndex] == INDEX_NONE)
+        {
+            HiddenIndices[DirectionIndex] = RayIndex;
+            HiddenLocations[DirectionIndex] = Point.HitLocation;
+        }
+    }
+
+    // Drop directions without an entry, keeping the index and location arrays parallel
+    const auto Compact = [](TArray<int32> &Indices, TArray<FVector> &Locations)
+    {
+        int32 Count = 0;
+        for (int32 i = 0; i < Indices.Num(); ++i)
+        {
+            if (Indices[i] != INDEX_NONE)
+            {
+                Indices[Count] = Indices[i];
+                Locations[Count] = Locations[i];
+                ++Count;
+            }
+        }
+        Indices.SetNum(Count, false);
+        Locations.SetNum(Count, false);
+    };
+    Compact(VisibleIndices, VisibleLocations);
+    Compact(HiddenIndices, HiddenLocations);
+
+    VisibleGrid.Build(VisibleLocations, VisibleIndices, TargetPointsPerCell);
+    HiddenGrid.Build(HiddenLocations, HiddenIndices, TargetPointsPerCell);
+}
+
+/**
+ * Release all index storage
+ */
+void FS__ViewShedSpatialIndex::Reset()
+{
+    VisibleGrid.Reset();
+    HiddenGrid.Reset();
+}
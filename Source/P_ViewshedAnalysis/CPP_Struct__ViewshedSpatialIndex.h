@@ -0,0 +1,112 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FS__ViewShedPoint;
+struct FS__ViewShedHorizonMap;
+struct FS__ViewShedRayStore;
+
+/**
+ * Uniform grid over a subset of analysis hit locations
+ * Cells are stored in compressed form: one start offset per cell into a single index array sorted by cell,
+ * so a query only touches the cells it overlaps instead of every analysis point
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedPointGrid
+{
+    /** Build the grid over Points[PointIndices[...]] using their hit locations */
+    void Build(TConstArrayView<FS__ViewShedPoint> Points, TConstArrayView<int32> PointIndices, int32 TargetPointsPerCell);
+
+    /** Build the grid over explicit locations, Locations[i] belonging to result ResultIndices[i] */
+    void Build(TConstArrayView<FVector> Locations, TConstArrayView<int32> ResultIndices, int32 TargetPointsPerCell);
+
+    /** Release all grid storage */
+    void Reset();
+
+    /** Whether the grid contains no points */
+    bool IsEmpty() const { return SortedIndices.IsEmpty(); }
+
+    /** Number of points stored in the grid */
+    int32 Num() const { return SortedIndices.Num(); }
+
+    /**
+     * Find the closest point to Location
+     * @param MaxDistance - Search radius limit (<= 0 means unlimited)
+     * @param InOutBestDistanceSquared - Best squared distance found so far; only closer points are accepted
+     * @return Index of the closest point (into the original results), or INDEX_NONE if none beat the current best
+     */
+    int32 FindNearest(const FVector &Location, float MaxDistance, double &InOutBestDistanceSquared) const;
+
+    /**
+     * Merge the K closest points to Location into a list sorted by ascending squared distance
+     * The list may already contain candidates from another grid, which allows merged visible/hidden queries
+     */
+    void FindKNearest(const FVector &Location, int32 K, float MaxDistance, TArray<TPair<double, int32>> &InOutSortedCandidates) const;
+
+    /** Append the indices of all points within Radius of Location */
+    void FindInRadius(const FVector &Location, float Radius, TArray<int32> &OutIndices) const;
+
+    /** Append the indices of all points inside Box */
+    void FindInBox(const FBox &Box, TArray<int32> &OutIndices) const;
+
+private:
+    /** Counting-sort the entries into cells; GetLocation(i) is the location of ResultIndices[i] */
+    void BuildSorted(TConstArrayView<int32> ResultIndices, TFunctionRef<FVector(int32)> GetLocation, int32 TargetPointsPerCell);
+
+    /** Cell coordinate containing Location, clamped to the grid */
+    FIntVector GetClampedCell(const FVector &Location) const;
+
+    /** Flattened cell index for an in-range cell coordinate */
+    int32 GetCellIndex(int32 X, int32 Y, int32 Z) const { return (Z * Dims.Y + Y) * Dims.X + X; }
+
+    /** Minimum corner of the grid in world space */
+    FVector BoundsMin = FVector::ZeroVector;
+
+    /** Edge length of each cubic cell */
+    double CellSize = 1.0;
+
+    /** Number of cells along each axis */
+    FIntVector Dims = FIntVector::ZeroValue;
+
+    /** Start offset of each cell into SortedIndices (NumCells + 1 entries) */
+    TArray<int32> CellStarts;
+
+    /** Result indices sorted by cell */
+    TArray<int32> SortedIndices;
+
+    /** Hit locations in the same order as SortedIndices, kept adjacent for cache friendly distance tests */
+    TArray<FVector> SortedLocations;
+};
+
+/**
+ * Spatial index built as a post-pass of each analysis
+ * Keeps separate grids for visible and hidden hit locations so filtered queries never visit the other set
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedSpatialIndex
+{
+    /** Rebuild both grids from a full analysis result set */
+    void Build(TConstArrayView<FS__ViewShedPoint> Points, int32 TargetPointsPerCell = 4);
+
+    /**
+     * Rebuild both grids from a horizon map without expanding its band points
+     * Holds one entry per lattice direction and state: the farthest visible band sample and the first occluded one
+     */
+    void Build(const FS__ViewShedHorizonMap &Horizon, const FS__ViewShedRayStore &Rays, int32 TargetPointsPerCell = 4);
+
+    /** Release all index storage */
+    void Reset();
+
+    /** Whether the index has been built over a non-empty result set */
+    bool IsBuilt() const { return !VisibleGrid.IsEmpty() || !HiddenGrid.IsEmpty(); }
+
+    /** Grid over visible hit locations */
+    FS__ViewShedPointGrid VisibleGrid;
+
+    /** Grid over hidden (occluded) hit locations */
+    FS__ViewShedPointGrid HiddenGrid;
+};
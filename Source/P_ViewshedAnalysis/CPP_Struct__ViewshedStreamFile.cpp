@@ -0,0 +1,472 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedStreamFile.h"
+#include "CPP_Actor__Viewshed.h"
+#include "CPP_Struct__ViewshedResultFile.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+
+namespace ViewshedStreamFile
+{
+    /** Byte size of a chunk's uncompressed columns */
+    static int64 GetChunkColumnsSize(int32 RayCount, bool bNormals)
+    {
+        const int64 Count = RayCount;
+        return Count * sizeof(float) + ((Count + 31) / 32) * sizeof(uint32) + (bNormals ? Count * sizeof(uint32) : 0);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// HEADER
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Angular lattice shared by every band
+ */
+FS__ViewShedHorizonLattice FS__ViewShedStreamFileHeader::GetLattice() const
+{
+    FS__ViewShedHorizonLattice Lattice;
+    Lattice.HorizontalSampleCount = HorizontalSampleCount;
+    Lattice.VerticalSampleCount = VerticalSampleCount;
+    Lattice.HalfHorizontalFOV = HalfHorizontalFOV;
+    Lattice.HalfVerticalFOV = HalfVerticalFOV;
+    Lattice.MaxDistance = MaxDistance;
+    return Lattice;
+}
+
+/**
+ * Number of rays stored in a chunk
+ */
+int32 FS__ViewShedStreamFileHeader::GetChunkRayCount(int32 ChunkIndex) const
+{
+    const int64 FirstRay = int64(ChunkIndex) * RaysPerChunk;
+    if (ChunkIndex < 0 || RaysPerChunk <= 0 || FirstRay >= RayCount)
+    {
+        return 0;
+    }
+    return int32(FMath::Min<int64>(RaysPerChunk, RayCount - FirstRay));
+}
+
+/**
+ * Regenerate the start/end points and lattice indices of a ray
+ */
+void FS__ViewShedStreamFileHeader::GetTracePoint(int64 RayIndex, FS__ViewShedTracePoint &OutTracePoint) const
+{
+    const int64 DirectionCount = int64(HorizontalSampleCount) * VerticalSampleCount;
+    const int32 BandIndex = int32(RayIndex / DirectionCount);
+    const int32 DirectionIndex = int32(RayIndex - BandIndex * DirectionCount);
+    const int32 HorizontalIndex = DirectionIndex % HorizontalSampleCount;
+    const int32 VerticalIndex = DirectionIndex / HorizontalSampleCount;
+
+    const FVector Origin(ObserverLocation[0], ObserverLocation[1], ObserverLocation[2]);
+    const FQuat Rotation(ObserverRotation[0], ObserverRotation[1], ObserverRotation[2], ObserverRotation[3]);
+    const FVector Direction = Rotation.RotateVector(GetLattice().GetLocalDirection(HorizontalIndex, VerticalIndex));
+
+    OutTracePoint.TraceStart = Origin;
+    OutTracePoint.TraceEnd = Origin + Direction * (MaxDistance * float(BandIndex + 1) / float(DistanceBandCount));
+    OutTracePoint.DistanceBandIndex = BandIndex;
+    OutTracePoint.HorizontalSampleIndex = HorizontalIndex;
+    OutTracePoint.VerticalSampleIndex = VerticalIndex;
+    OutTracePoint.bHasGroundSupport = true;
+    OutTracePoint.GroundNormal = FVector::ZeroVector;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// WRITER
+//////////////////////////////////////////////////////////////////////////
+
+FS__ViewShedStreamFileWriter::FS__ViewShedStreamFileWriter() = default;
+
+FS__ViewShedStreamFileWriter::~FS__ViewShedStreamFileWriter() = default;
+
+/**
+ * Create the file and write a placeholder header
+ */
+bool FS__ViewShedStreamFileWriter::Open(const FString &FilePath, const FS__ViewShedStreamFileHeader &InHeader, bool bStoreNormals)
+{
+    Handle.Reset();
+    ChunkEntries.Empty();
+    RaysWritten = 0;
+
+    if (InHeader.RayCount <= 0 || InHeader.RaysPerChunk <= 0 || InHeader.DistanceBandCount <= 0 || !InHeader.GetLattice().IsValid())
+    {
+        return false;
+    }
+
+    Header = InHeader;
+    Header.Magic = FS__ViewShedStreamFileHeader::FileMagic;
+    Header.Version = FS__ViewShedStreamFileHeader::FileVersion;
+    Header.Flags = bStoreNormals ? FS__ViewShedStreamFileHeader::Flag_Normals : 0u;
+    Header.ChunkCount = 0;
+    Header.IndexOffset = 0;
+
+    IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+    Handle.Reset(PlatformFile.OpenWrite(*FilePath));
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+
+    // The real header replaces this one once the index is known
+    if (!Handle->Write(reinterpret_cast<const uint8 *>(&Header), sizeof(Header)))
+    {
+        Handle.Reset();
+        return false;
+    }
+
+    PendingDistances.Reset(Header.RaysPerChunk);
+    PendingVisibility.Reset((Header.RaysPerChunk + 31) / 32);
+    PendingNormals.Reset(bStoreNormals ? Header.RaysPerChunk : 0);
+    return true;
+}
+
+/**
+ * Append results for the next rays in ray order
+ */
+bool FS__ViewShedStreamFileWriter::Append(TConstArrayView<FS__ViewShedPoint> Points)
+{
+    if (!IsOpen() || RaysWritten + Points.Num() > Header.RayCount)
+    {
+        return false;
+    }
+
+    const FVector Origin(Header.ObserverLocation[0], Header.ObserverLocation[1], Header.ObserverLocation[2]);
+    const bool bStoreNormals = (Header.Flags & FS__ViewShedStreamFileHeader::Flag_Normals) != 0;
+    for (const FS__ViewShedPoint &Point : Points)
+    {
+        const int32 Local = PendingDistances.Num();
+        if ((Local & 31) == 0)
+        {
+            PendingVisibility.Add(0u);
+        }
+        PendingDistances.Add(float(FVector::Dist(Origin, Point.HitLocation)));
+        PendingVisibility.Last() |= uint32(Point.bIsVisible) << (Local & 31);
+        if (bStoreNormals)
+        {
+            PendingNormals.Add(FS__ViewShedResultFileView::EncodeNormal(Point.HitNormal));
+        }
+        ++RaysWritten;
+
+        if (PendingDistances.Num() == Header.RaysPerChunk && !FlushChunk())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Compress and append the buffered chunk
+ */
+bool FS__ViewShedStreamFileWriter::FlushChunk()
+{
+    if (PendingDistances.IsEmpty())
+    {
+        return true;
+    }
+
+    // Columns back to back, the same layout as a result file's sections
+    UncompressedScratch.Reset();
+    UncompressedScratch.Append(reinterpret_cast<const uint8 *>(PendingDistances.GetData()), PendingDistances.Num() * sizeof(float));
+    UncompressedScratch.Append(reinterpret_cast<const uint8 *>(PendingVisibility.GetData()), PendingVisibility.Num() * sizeof(uint32));
+    UncompressedScratch.Append(reinterpret_cast<const uint8 *>(PendingNormals.GetData()), PendingNormals.Num() * sizeof(uint32));
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedScratch.Num());
+    CompressedScratch.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, CompressedScratch.GetData(), CompressedSize, UncompressedScratch.GetData(), UncompressedScratch.Num()))
+    {
+        return false;
+    }
+
+    FS__ViewShedStreamChunkEntry &Entry = ChunkEntries.AddDefaulted_GetRef();
+    Entry.Offset = uint64(Handle->Tell());
+    Entry.CompressedSize = uint32(CompressedSize);
+    Entry.UncompressedSize = uint32(UncompressedScratch.Num());
+    if (!Handle->Write(CompressedScratch.GetData(), CompressedSize))
+    {
+        return false;
+    }
+
+    PendingDistances.Reset();
+    PendingVisibility.Reset();
+    PendingNormals.Reset();
+    return true;
+}
+
+/**
+ * Flush the partial chunk, then write the index and final header
+ */
+bool FS__ViewShedStreamFileWriter::Close()
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+
+    // Every ray must have been appended, otherwise the ray numbering of later chunks would be wrong
+    bool bWritten = RaysWritten == Header.RayCount && FlushChunk();
+    if (bWritten)
+    {
+        Header.ChunkCount = ChunkEntries.Num();
+        Header.IndexOffset = uint64(Handle->Tell());
+        bWritten = Handle->Write(reinterpret_cast<const uint8 *>(ChunkEntries.GetData()), ChunkEntries.Num() * sizeof(FS__ViewShedStreamChunkEntry)) &&
+                   Handle->Seek(0) &&
+                   Handle->Write(reinterpret_cast<const uint8 *>(&Header), sizeof(Header)) &&
+                   Handle->Flush();
+    }
+
+    Handle.Reset();
+    ChunkEntries.Empty();
+    PendingDistances.Empty();
+    PendingVisibility.Empty();
+    PendingNormals.Empty();
+    UncompressedScratch.Empty();
+    CompressedScratch.Empty();
+    return bWritten;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// READER
+//////////////////////////////////////////////////////////////////////////
+
+FS__ViewShedStreamFileView::FS__ViewShedStreamFileView() = default;
+
+FS__ViewShedStreamFileView::~FS__ViewShedStreamFileView()
+{
+    Close();
+}
+
+/**
+ * Open and validate a finished stream file
+ */
+bool FS__ViewShedStreamFileView::Open(const FString &InFilePath)
+{
+    Close();
+
+    IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*InFilePath));
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+
+    // Header; an unfinished file still has a zero index offset
+    const int64 FileSize = Handle->Size();
+    FS__ViewShedStreamFileHeader FileHeader;
+    if (FileSize < int64(sizeof(FileHeader)) || !Handle->Read(reinterpret_cast<uint8 *>(&FileHeader), sizeof(FileHeader)))
+    {
+        return false;
+    }
+
+    if (FileHeader.Magic != FS__ViewShedStreamFileHeader::FileMagic ||
+        FileHeader.Version != FS__ViewShedStreamFileHeader::FileVersion ||
+        FileHeader.IndexOffset == 0 || FileHeader.RaysPerChunk <= 0 || FileHeader.RayCount <= 0 ||
+        FileHeader.DistanceBandCount <= 0 || FileHeader.ChunkCount <= 0 || !FileHeader.GetLattice().IsValid())
+    {
+        return false;
+    }
+
+    // Lattice and ray counts, checked in steps so a hostile header cannot overflow the products
+    const int64 DirectionCount = int64(FileHeader.HorizontalSampleCount) * int64(FileHeader.VerticalSampleCount);
+    if (DirectionCount > MAX_int32 || DirectionCount > FileHeader.RayCount / FileHeader.DistanceBandCount ||
+        FileHeader.RayCount != int64(FileHeader.DistanceBandCount) * DirectionCount ||
+        int64(FileHeader.ChunkCount) != (FileHeader.RayCount - 1) / FileHeader.RaysPerChunk + 1)
+    {
+        return false;
+    }
+
+    // Chunk index; its size is checked against the file before anything is allocated for it
+    const int64 IndexSize = int64(FileHeader.ChunkCount) * int64(sizeof(FS__ViewShedStreamChunkEntry));
+    if (FileHeader.IndexOffset > uint64(FileSize) || IndexSize > FileSize - int64(FileHeader.IndexOffset))
+    {
+        return false;
+    }
+    TArray<FS__ViewShedStreamChunkEntry> Entries;
+    Entries.SetNumUninitialized(FileHeader.ChunkCount);
+    if (!Handle->Seek(int64(FileHeader.IndexOffset)) ||
+        !Handle->Read(reinterpret_cast<uint8 *>(Entries.GetData()), IndexSize))
+    {
+        return false;
+    }
+
+    const bool bNormals = (FileHeader.Flags & FS__ViewShedStreamFileHeader::Flag_Normals) != 0;
+    for (int32 ChunkIndex = 0; ChunkIndex < Entries.Num(); ++ChunkIndex)
+    {
+        // Reject entries pointing outside the file or sized for another ray count
+        const FS__ViewShedStreamChunkEntry &Entry = Entries[ChunkIndex];
+        if (Entry.Offset > uint64(FileSize) || uint64(Entry.CompressedSize) > uint64(FileSize) - Entry.Offset ||
+            int64(Entry.UncompressedSize) != ViewshedStreamFile::GetChunkColumnsSize(FileHeader.GetChunkRayCount(ChunkIndex), bNormals))
+        {
+            return false;
+        }
+    }
+    Handle.Reset();
+
+    // Map the whole file so chunk reads touch only the pages they need; reads fall back to file handles otherwise
+    MappedHandle.Reset(PlatformFile.OpenMapped(*InFilePath));
+    if (MappedHandle.IsValid())
+    {
+        MappedRegion.Reset(MappedHandle->MapRegion(0, FileSize));
+        if (!MappedRegion.IsValid())
+        {
+            MappedHandle.Reset();
+        }
+    }
+
+    Header = FileHeader;
+    ChunkEntries = MoveTemp(Entries);
+    FilePath = InFilePath;
+    return true;
+}
+
+/**
+ * Release the mapping
+ */
+void FS__ViewShedStreamFileView::Close()
+{
+    // Region must be released before its handle
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+    FilePath.Empty();
+    Header = FS__ViewShedStreamFileHeader();
+    ChunkEntries.Empty();
+}
+
+/**
+ * Chunk holding a ray
+ */
+int32 FS__ViewShedStreamFileView::GetChunkIndexForRay(int64 RayIndex) const
+{
+    if (!IsOpen() || RayIndex < 0 || RayIndex >= Header.RayCount)
+    {
+        return INDEX_NONE;
+    }
+    return int32(RayIndex / Header.RaysPerChunk);
+}
+
+/**
+ * Decompress one chunk's columns
+ */
+bool FS__ViewShedStreamFileView::DecompressChunk(int32 ChunkIndex, FS__ViewShedStreamChunk &OutChunk) const
+{
+    if (!ChunkEntries.IsValidIndex(ChunkIndex))
+    {
+        return false;
+    }
+    const FS__ViewShedStreamChunkEntry &Entry = ChunkEntries[ChunkIndex];
+
+    // Compressed bytes come straight from the mapping, or from a private handle so calls stay thread safe
+    const uint8 *Compressed = nullptr;
+    TArray<uint8> ReadBuffer;
+    if (MappedRegion.IsValid())
+    {
+        Compressed = MappedRegion->GetMappedPtr() + Entry.Offset;
+    }
+    else
+    {
+        TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+        ReadBuffer.SetNumUninitialized(Entry.CompressedSize);
+        if (!Handle.IsValid() || !Handle->Seek(int64(Entry.Offset)) || !Handle->Read(ReadBuffer.GetData(), ReadBuffer.Num()))
+        {
+            return false;
+        }
+        Compressed = ReadBuffer.GetData();
+    }
+
+    TArray<uint8> Uncompressed;
+    Uncompressed.SetNumUninitialized(Entry.UncompressedSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), Uncompressed.Num(), Compressed, Entry.CompressedSize))
+    {
+        return false;
+    }
+
+    // Split the columns; sizes were validated against the ray count on Open
+    const int32 RayCount = Header.GetChunkRayCount(ChunkIndex);
+    const int32 VisibilityWords = (RayCount + 31) / 32;
+    const uint8 *Cursor = Uncompressed.GetData();
+    OutChunk.FirstRay = int64(ChunkIndex) * Header.RaysPerChunk;
+    OutChunk.HitDistances.SetNumUninitialized(RayCount);
+    FMemory::Memcpy(OutChunk.HitDistances.GetData(), Cursor, RayCount * sizeof(float));
+    Cursor += RayCount * sizeof(float);
+    OutChunk.VisibilityBits.SetNumUninitialized(VisibilityWords);
+    FMemory::Memcpy(OutChunk.VisibilityBits.GetData(), Cursor, VisibilityWords * sizeof(uint32));
+    Cursor += VisibilityWords * sizeof(uint32);
+    OutChunk.PackedNormals.Reset();
+    if (Header.Flags & FS__ViewShedStreamFileHeader::Flag_Normals)
+    {
+        OutChunk.PackedNormals.SetNumUninitialized(RayCount);
+        FMemory::Memcpy(OutChunk.PackedNormals.GetData(), Cursor, RayCount * sizeof(uint32));
+    }
+    return true;
+}
+
+/**
+ * Decompress one chunk and rebuild its band results
+ */
+bool FS__ViewShedStreamFileView::ReadChunkPoints(int32 ChunkIndex, TArray<FS__ViewShedPoint> &OutPoints) const
+{
+    OutPoints.Reset();
+
+    FS__ViewShedStreamChunk Chunk;
+    if (!DecompressChunk(ChunkIndex, Chunk))
+    {
+        return false;
+    }
+
+    OutPoints.SetNum(Chunk.Num());
+    for (int32 i = 0; i < Chunk.Num(); ++i)
+    {
+        RebuildPoint(Chunk, i, OutPoints[i]);
+    }
+    return true;
+}
+
+/**
+ * Rebuild a single ray's result
+ */
+bool FS__ViewShedStreamFileView::ReadRay(int64 RayIndex, FS__ViewShedPoint &OutPoint) const
+{
+    const int32 ChunkIndex = GetChunkIndexForRay(RayIndex);
+    FS__ViewShedStreamChunk Chunk;
+    if (ChunkIndex == INDEX_NONE || !DecompressChunk(ChunkIndex, Chunk))
+    {
+        return false;
+    }
+
+    RebuildPoint(Chunk, int32(RayIndex - Chunk.FirstRay), OutPoint);
+    return true;
+}
+
+/**
+ * Rebuild the band result of one ray of a decompressed chunk
+ */
+void FS__ViewShedStreamFileView::RebuildPoint(const FS__ViewShedStreamChunk &Chunk, int32 LocalIndex, FS__ViewShedPoint &OutPoint) const
+{
+    FS__ViewShedTracePoint TracePoint;
+    Header.GetTracePoint(Chunk.FirstRay + LocalIndex, TracePoint);
+    const FVector TraceVector = TracePoint.TraceEnd - TracePoint.TraceStart;
+    const FVector RayDirection = TraceVector.GetSafeNormal();
+
+    OutPoint.WorldPosition = TracePoint.TraceEnd;
+    OutPoint.Distance = float(TraceVector.Size());
+    OutPoint.bIsVisible = Chunk.IsVisible(LocalIndex);
+    OutPoint.HitLocation = TracePoint.TraceStart + RayDirection * Chunk.HitDistances[LocalIndex];
+    OutPoint.HitActor = nullptr;
+    if (!Chunk.PackedNormals.IsEmpty())
+    {
+        OutPoint.HitNormal = FS__ViewShedResultFileView::DecodeNormal(Chunk.PackedNormals[LocalIndex]);
+    }
+    else
+    {
+        // Occluders face back along the ray, as for horizon-derived points
+        OutPoint.HitNormal = OutPoint.bIsVisible ? TracePoint.GroundNormal : -RayDirection;
+    }
+}
@@ -0,0 +1,235 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CPP_Struct__ViewshedHorizonMap.h"
+
+struct FS__ViewShedPoint;
+struct FS__ViewShedTracePoint;
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Fixed-size header at the start of a streamed viewshed file
+ * Rays are numbered in natural lattice order, Ray = (Band * Vertical + V) * Horizontal + H, and the header carries
+ * everything needed to regenerate any ray, so the file is self-describing without the in-memory trace queue
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedStreamFileHeader
+{
+    /** File identifier and current layout version */
+    static constexpr uint32 FileMagic = 0x54535356; // "VSST"
+    static constexpr uint32 FileVersion = 1;
+
+    /** Chunk section flags */
+    static constexpr uint32 Flag_Normals = 1u << 0;
+
+    uint32 Magic = FileMagic;
+    uint32 Version = FileVersion;
+
+    /** Combination of Flag_* values */
+    uint32 Flags = 0;
+    uint32 Padding = 0;
+
+    /** Hash of the sampling configuration that produced the rays (see ACPP_Actor__Viewshed::ComputeConfigHash) */
+    uint64 ConfigHash = 0;
+
+    /** Eye location the rays start from and the orientation lattice directions are relative to */
+    double ObserverLocation[3] = {0.0, 0.0, 0.0};
+    double ObserverRotation[4] = {0.0, 0.0, 0.0, 1.0};
+
+    /** Ray lattice dimensions */
+    int32 DistanceBandCount = 0;
+    int32 HorizontalSampleCount = 0;
+    int32 VerticalSampleCount = 0;
+
+    /** Rays per chunk; every chunk but the last holds exactly this many */
+    int32 RaysPerChunk = 0;
+
+    /** Lattice angles (radians) and range */
+    float HalfHorizontalFOV = 0.0f;
+    float HalfVerticalFOV = 0.0f;
+    float MaxDistance = 0.0f;
+
+    /** Number of chunks listed in the index */
+    int32 ChunkCount = 0;
+
+    /** Total number of rays (Bands * Horizontal * Vertical) */
+    int64 RayCount = 0;
+
+    /** Byte offset of the chunk index; 0 while the file is still being written */
+    uint64 IndexOffset = 0;
+
+    /** Angular lattice shared by every band */
+    FS__ViewShedHorizonLattice GetLattice() const;
+
+    /** Number of rays stored in a chunk */
+    int32 GetChunkRayCount(int32 ChunkIndex) const;
+
+    /** Regenerate the start/end points and lattice indices of a ray */
+    void GetTracePoint(int64 RayIndex, FS__ViewShedTracePoint &OutTracePoint) const;
+};
+
+/**
+ * Location of one compressed chunk inside a streamed viewshed file
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedStreamChunkEntry
+{
+    /** Byte offset of the compressed chunk from the start of the file */
+    uint64 Offset = 0;
+
+    /** Byte size of the chunk after and before compression */
+    uint32 CompressedSize = 0;
+    uint32 UncompressedSize = 0;
+};
+
+/**
+ * Decompressed columns of one chunk
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedStreamChunk
+{
+    /** Index of the first ray in the chunk */
+    int64 FirstRay = 0;
+
+    /** Distance from the observer to each ray's hit (or end) location */
+    TArray<float> HitDistances;
+
+    /** One visibility bit per ray */
+    TArray<uint32> VisibilityBits;
+
+    /** Octahedron-encoded hit normal per ray (empty if not stored) */
+    TArray<uint32> PackedNormals;
+
+    /** Number of rays in the chunk */
+    int32 Num() const { return HitDistances.Num(); }
+
+    /** Whether the chunk-local ray Index is visible */
+    bool IsVisible(int32 Index) const { return (VisibilityBits[Index >> 5] >> (Index & 31)) & 1u; }
+};
+
+/**
+ * Append-only writer for streamed viewshed files
+ * Results are buffered only until a chunk is full, then compressed and appended, so memory stays bounded by
+ * one chunk regardless of the total ray count. The index and final header are written by Close; a file that
+ * was never closed keeps a zero index offset and is rejected by readers.
+ */
+class P_VIEWSHEDANALYSIS_API FS__ViewShedStreamFileWriter
+{
+public:
+    FS__ViewShedStreamFileWriter();
+    ~FS__ViewShedStreamFileWriter();
+
+    /**
+     * Create the file and write a placeholder header
+     * @param InHeader - Config hash, observer transform, lattice, band count, ray count and chunk size
+     */
+    bool Open(const FString &FilePath, const FS__ViewShedStreamFileHeader &InHeader, bool bStoreNormals);
+
+    /** Append results for the next rays in ray order, compressing every chunk that fills up */
+    bool Append(TConstArrayView<FS__ViewShedPoint> Points);
+
+    /** Flush the partial chunk, then write the index and final header */
+    bool Close();
+
+    /** Whether a file is open for writing */
+    bool IsOpen() const { return Handle.IsValid(); }
+
+    /** Header being written */
+    const FS__ViewShedStreamFileHeader &GetHeader() const { return Header; }
+
+    /** Number of rays appended so far */
+    int64 GetRaysWritten() const { return RaysWritten; }
+
+private:
+    /** Compress and append the buffered chunk */
+    bool FlushChunk();
+
+    /** Output file */
+    TUniquePtr<IFileHandle> Handle;
+
+    /** Header written on Close */
+    FS__ViewShedStreamFileHeader Header;
+
+    /** Location of every chunk written so far */
+    TArray<FS__ViewShedStreamChunkEntry> ChunkEntries;
+
+    /** Columns of the chunk being filled */
+    TArray<float> PendingDistances;
+    TArray<uint32> PendingVisibility;
+    TArray<uint32> PendingNormals;
+
+    /** Serialization and compression scratch, reused for every chunk */
+    TArray<uint8> UncompressedScratch;
+    TArray<uint8> CompressedScratch;
+
+    /** Rays appended so far */
+    int64 RaysWritten = 0;
+};
+
+/**
+ * Random-access reader over a streamed viewshed file
+ * Only the header and chunk index are decoded on Open; chunks are decompressed individually on request.
+ * The file is memory mapped when the platform supports it so compressed chunks are read in place; otherwise
+ * each request reads its chunk through its own file handle. DecompressChunk may be called from worker threads.
+ */
+class P_VIEWSHEDANALYSIS_API FS__ViewShedStreamFileView
+{
+public:
+    FS__ViewShedStreamFileView();
+    ~FS__ViewShedStreamFileView();
+
+    /** Open and validate a finished stream file; returns false if missing, truncated, unfinished or of another version */
+    bool Open(const FString &InFilePath);
+
+    /** Release the mapping */
+    void Close();
+
+    /** Whether a valid file is open */
+    bool IsOpen() const { return !FilePath.IsEmpty(); }
+
+    /** Whether chunks are read through a memory mapping */
+    bool IsMemoryMapped() const { return MappedRegion != nullptr; }
+
+    /** Validated file header */
+    const FS__ViewShedStreamFileHeader &GetHeader() const { return Header; }
+
+    /** Number of chunks */
+    int32 GetChunkCount() const { return ChunkEntries.Num(); }
+
+    /** Chunk holding a ray, or INDEX_NONE if out of range */
+    int32 GetChunkIndexForRay(int64 RayIndex) const;
+
+    /** Decompress one chunk's columns */
+    bool DecompressChunk(int32 ChunkIndex, FS__ViewShedStreamChunk &OutChunk) const;
+
+    /**
+     * Decompress one chunk and rebuild its band results
+     * Hit actors are not stored; without stored normals, occluded hits face back along the ray
+     */
+    bool ReadChunkPoints(int32 ChunkIndex, TArray<FS__ViewShedPoint> &OutPoints) const;
+
+    /** Rebuild a single ray's result (decompresses its whole chunk) */
+    bool ReadRay(int64 RayIndex, FS__ViewShedPoint &OutPoint) const;
+
+private:
+    /** Rebuild the band result of one ray of a decompressed chunk */
+    void RebuildPoint(const FS__ViewShedStreamChunk &Chunk, int32 LocalIndex, FS__ViewShedPoint &OutPoint) const;
+
+    /** Path of the open file (empty when closed) */
+    FString FilePath;
+
+    /** Header read on Open */
+    FS__ViewShedStreamFileHeader Header;
+
+    /** Chunk locations */
+    TArray<FS__ViewShedStreamChunkEntry> ChunkEntries;
+
+    /** Memory mapping (when used) */
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+};
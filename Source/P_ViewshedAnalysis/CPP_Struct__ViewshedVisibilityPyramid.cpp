@@ -0,0 +1,141 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedVisibilityPyramid.h"
+#include "CPP_Struct__ViewshedWorldRaster.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Rebuild the summed-area tables and mip chain from a raster
+ */
+void FS__ViewShedVisibilityPyramid::Build(const FS__ViewShedWorldRaster &Raster)
+{
+    Reset();
+
+    if (!Raster.IsInitialized())
+    {
+        return;
+    }
+
+    Resolution = Raster.GetResolution();
+    Origin = Raster.GetOrigin();
+    CellSize = Raster.GetCellSize();
+
+    const int32 Stride = Resolution + 1;
+    VisibleTable.SetNumZeroed(Stride * Stride);
+    ObservedTable.SetNumZeroed(Stride * Stride);
+
+    // Pass 1: per-row prefix sums, rows are independent
+    ParallelFor(Resolution, [&](int32 Y)
+                {
+                    uint32 VisibleSum = 0;
+                    uint32 ObservedSum = 0;
+                    const int32 RowBase = (Y + 1) * Stride;
+                    for (int32 X = 0; X < Resolution; ++X)
+                    {
+                        const uint32 State = Raster.GetCellState(X, Y);
+                        VisibleSum += State & FS__ViewShedWorldRaster::CellVisible;
+                        ObservedSum += State != FS__ViewShedWorldRaster::CellUnobserved ? 1u : 0u;
+                        VisibleTable[RowBase + X + 1] = VisibleSum;
+                        ObservedTable[RowBase + X + 1] = ObservedSum;
+                    } });
+
+    // Pass 2: accumulate down each column, columns are independent
+    ParallelFor(Resolution, [&](int32 X)
+                {
+                    for (int32 Y = 1; Y < Resolution; ++Y)
+                    {
+                        VisibleTable[(Y + 1) * Stride + X + 1] += VisibleTable[Y * Stride + X + 1];
+                        ObservedTable[(Y + 1) * Stride + X + 1] += ObservedTable[Y * Stride + X + 1];
+                    } });
+
+    // Mip chain: every node is one O(1) rectangle lookup
+    for (int32 NodeSize = 2; NodeSize <= Resolution; NodeSize *= 2)
+    {
+        FMipLevel &Level = MipLevels.AddDefaulted_GetRef();
+        Level.Resolution = Resolution / NodeSize;
+        Level.Visible.SetNumUninitialized(Level.Resolution * Level.Resolution);
+        Level.Observed.SetNumUninitialized(Level.Resolution * Level.Resolution);
+
+        ParallelFor(Level.Resolution, [&, NodeSize](int32 NodeY)
+                    {
+                        for (int32 NodeX = 0; NodeX < Level.Resolution; ++NodeX)
+                        {
+                            const int32 MinX = NodeX * NodeSize;
+                            const int32 MinY = NodeY * NodeSize;
+                            const int32 NodeIndex = NodeY * Level.Resolution + NodeX;
+                            Level.Visible[NodeIndex] = SumRect(VisibleTable, MinX, MinY, MinX + NodeSize - 1, MinY + NodeSize - 1);
+                            Level.Observed[NodeIndex] = SumRect(ObservedTable, MinX, MinY, MinX + NodeSize - 1, MinY + NodeSize - 1);
+                        } });
+    }
+}
+
+/**
+ * Release all storage
+ */
+void FS__ViewShedVisibilityPyramid::Reset()
+{
+    Resolution = 0;
+    Origin = FVector2D::ZeroVector;
+    CellSize = 1.0f;
+    VisibleTable.Empty();
+    ObservedTable.Empty();
+    MipLevels.Empty();
+}
+
+/**
+ * Sum of a summed-area table over an inclusive cell rectangle
+ */
+uint32 FS__ViewShedVisibilityPyramid::SumRect(const TArray<uint32> &Table, int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const
+{
+    const int32 Stride = Resolution + 1;
+    return Table[(MaxY + 1) * Stride + MaxX + 1] - Table[MinY * Stride + MaxX + 1] - Table[(MaxY + 1) * Stride + MinX] + Table[MinY * Stride + MinX];
+}
+
+/**
+ * Counts over an inclusive raster cell rectangle
+ */
+FS__ViewShedRegionCounts FS__ViewShedVisibilityPyramid::QueryCells(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const
+{
+    FS__ViewShedRegionCounts Counts;
+    if (!IsBuilt())
+    {
+        return Counts;
+    }
+
+    // Cells outside the raster count towards the area but were never observed
+    Counts.TotalCells = FMath::Max(0, MaxX - MinX + 1) * FMath::Max(0, MaxY - MinY + 1);
+
+    MinX = FMath::Max(MinX, 0);
+    MinY = FMath::Max(MinY, 0);
+    MaxX = FMath::Min(MaxX, Resolution - 1);
+    MaxY = FMath::Min(MaxY, Resolution - 1);
+    if (MinX > MaxX || MinY > MaxY)
+    {
+        return Counts;
+    }
+
+    Counts.VisibleCells = int32(SumRect(VisibleTable, MinX, MinY, MaxX, MaxY));
+    Counts.ObservedCells = int32(SumRect(ObservedTable, MinX, MinY, MaxX, MaxY));
+    return Counts;
+}
+
+/**
+ * Counts over a world-space XY box
+ */
+FS__ViewShedRegionCounts FS__ViewShedVisibilityPyramid::QueryWorldBox(const FVector2D &BoxMin, const FVector2D &BoxMax) const
+{
+    if (!IsBuilt())
+    {
+        return FS__ViewShedRegionCounts();
+    }
+
+    const int32 MinX = FMath::FloorToInt32((FMath::Min(BoxMin.X, BoxMax.X) - Origin.X) / CellSize);
+    const int32 MinY = FMath::FloorToInt32((FMath::Min(BoxMin.Y, BoxMax.Y) - Origin.Y) / CellSize);
+    const int32 MaxX = FMath::FloorToInt32((FMath::Max(BoxMin.X, BoxMax.X) - Origin.X) / CellSize);
+    const int32 MaxY = FMath::FloorToInt32((FMath::Max(BoxMin.Y, BoxMax.Y) - Origin.Y) / CellSize);
+    return QueryCells(MinX, MinY, MaxX, MaxY);
+}
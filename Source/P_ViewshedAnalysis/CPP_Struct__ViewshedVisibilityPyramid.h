@@ -0,0 +1,90 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FS__ViewShedWorldRaster;
+
+/**
+ * Visible and observed cell counts for a region of the world raster
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedRegionCounts
+{
+    /** Cells that received at least one visible sample */
+    int32 VisibleCells = 0;
+
+    /** Cells that received any sample */
+    int32 ObservedCells = 0;
+
+    /** Cells inside the region (observed or not) */
+    int32 TotalCells = 0;
+
+    /** Visible cells relative to observed cells (0 when nothing was observed) */
+    float GetVisibleFraction() const { return ObservedCells > 0 ? float(VisibleCells) / float(ObservedCells) : 0.0f; }
+};
+
+/**
+ * Hierarchical visibility pyramid over a world raster
+ * Summed-area tables answer any axis-aligned region in O(1) (four lookups per count), and a mip chain of
+ * per-node counts (each level halves the resolution) serves coarse, far-distance visualization
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedVisibilityPyramid
+{
+    /** One level of the mip chain; level N nodes cover 2^(N+1) x 2^(N+1) raster cells (partial edge nodes are omitted) */
+    struct FMipLevel
+    {
+        /** Nodes per side */
+        int32 Resolution = 0;
+
+        /** Visible cell count per node, row major */
+        TArray<uint32> Visible;
+
+        /** Observed cell count per node, row major */
+        TArray<uint32> Observed;
+    };
+
+    /** Rebuild the tables and mip chain from a raster (rows and columns are accumulated in parallel) */
+    void Build(const FS__ViewShedWorldRaster &Raster);
+
+    /** Release all storage */
+    void Reset();
+
+    /** Whether Build has produced usable tables */
+    bool IsBuilt() const { return Resolution > 0; }
+
+    /** Counts over the inclusive raster cell rectangle (clamped to the raster) */
+    FS__ViewShedRegionCounts QueryCells(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const;
+
+    /** Counts over a world-space XY box */
+    FS__ViewShedRegionCounts QueryWorldBox(const FVector2D &BoxMin, const FVector2D &BoxMax) const;
+
+    /** Mip chain; index 0 is the first downsampled level (2x2 cells per node) */
+    const TArray<FMipLevel> &GetMipLevels() const { return MipLevels; }
+
+private:
+    /** Sum of a summed-area table over an inclusive cell rectangle */
+    uint32 SumRect(const TArray<uint32> &Table, int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const;
+
+    /** Raster cells per side */
+    int32 Resolution = 0;
+
+    /** World XY of the minimum raster corner */
+    FVector2D Origin = FVector2D::ZeroVector;
+
+    /** World size of one raster cell */
+    float CellSize = 1.0f;
+
+    /** Summed-area table of visible cells, (Resolution + 1)^2 with a zero border row/column */
+    TArray<uint32> VisibleTable;
+
+    /** Summed-area table of observed cells, same layout as VisibleTable */
+    TArray<uint32> ObservedTable;
+
+    /** Downsampled per-node counts */
+    TArray<FMipLevel> MipLevels;
+};
@@ -0,0 +1,224 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Struct__ViewshedWorldRaster.h"
+#include "CPP_Actor__Viewshed.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+
+/**
+ * Allocate (or reuse) the grid and align it to the world
+ */
+void FS__ViewShedWorldRaster::Initialize(const FVector2D &Center, float InCellSize, int32 InResolution)
+{
+    CellSize = FMath::Max(1.0f, InCellSize);
+    // Round up so tiles (and therefore packed words) divide the grid evenly; cell coordinates are packed into 16 bits
+    Resolution = FMath::Clamp(FMath::DivideAndRoundUp(InResolution, TileSize) * TileSize, TileSize, 16384);
+
+    // Snap the minimum corner to the world cell lattice
+    const double HalfExtent = 0.5 * double(Resolution) * double(CellSize);
+    Origin.X = FMath::FloorToDouble((Center.X - HalfExtent) / CellSize) * CellSize;
+    Origin.Y = FMath::FloorToDouble((Center.Y - HalfExtent) / CellSize) * CellSize;
+
+    Cells.SetNumUninitialized(GetWordsPerRow() * Resolution);
+    Clear();
+}
+
+/**
+ * Mark every cell unobserved
+ */
+void FS__ViewShedWorldRaster::Clear()
+{
+    FMemory::Memzero(Cells.GetData(), Cells.Num() * sizeof(uint32));
+}
+
+/**
+ * Release all storage
+ */
+void FS__ViewShedWorldRaster::Reset()
+{
+    Origin = FVector2D::ZeroVector;
+    Resolution = 0;
+    Cells.Empty();
+}
+
+/**
+ * Whether a result should be rasterized
+ * Visible samples that never touched a surface end in mid-air, so they say nothing about the ground below
+ */
+bool FS__ViewShedWorldRaster::ShouldSplat(const FS__ViewShedPoint &Point, bool bSurfaceHitsOnly)
+{
+    return !bSurfaceHitsOnly || Point.HitActor != nullptr || !Point.HitNormal.IsNearlyZero();
+}
+
+/**
+ * Cell coordinate for a world location
+ */
+FIntPoint FS__ViewShedWorldRaster::WorldToCell(const FVector &Location) const
+{
+    if (!IsInitialized())
+    {
+        return FIntPoint(INDEX_NONE, INDEX_NONE);
+    }
+
+    const int32 X = FMath::FloorToInt32((Location.X - Origin.X) / CellSize);
+    const int32 Y = FMath::FloorToInt32((Location.Y - Origin.Y) / CellSize);
+    if (X < 0 || Y < 0 || X >= Resolution || Y >= Resolution)
+    {
+        return FIntPoint(INDEX_NONE, INDEX_NONE);
+    }
+    return FIntPoint(X, Y);
+}
+
+/**
+ * Two-bit state of a cell
+ */
+uint32 FS__ViewShedWorldRaster::GetCellState(int32 X, int32 Y) const
+{
+    if (X < 0 || Y < 0 || X >= Resolution || Y >= Resolution)
+    {
+        return CellUnobserved;
+    }
+    return (Cells[Y * GetWordsPerRow() + (X >> 4)] >> ((X & 15) * 2)) & 3u;
+}
+
+/**
+ * Splat a contiguous range of results serially
+ */
+void FS__ViewShedWorldRaster::SplatRange(TConstArrayView<FS__ViewShedPoint> Points, int32 Begin, int32 End, bool bSurfaceHitsOnly)
+{
+    if (!IsInitialized())
+    {
+        return;
+    }
+
+    End = FMath::Min(End, Points.Num());
+    for (int32 i = FMath::Max(0, Begin); i < End; ++i)
+    {
+        const FS__ViewShedPoint &Point = Points[i];
+        if (!ShouldSplat(Point, bSurfaceHitsOnly))
+        {
+            continue;
+        }
+
+        const FIntPoint Cell = WorldToCell(Point.HitLocation);
+        if (Cell.X != INDEX_NONE)
+        {
+            OrCell(Cell.X, Cell.Y, Point.bIsVisible ? CellVisible : CellHidden);
+        }
+    }
+}
+
+/**
+ * Splat every result in parallel
+ * Results are counting-sorted by tile, then each tile is filled by one task; tiles are aligned to
+ * packed words, so no two tasks ever write the same word
+ */
+void FS__ViewShedWorldRaster::SplatAllParallel(TConstArrayView<FS__ViewShedPoint> Points, bool bSurfaceHitsOnly)
+{
+    if (!IsInitialized() || Points.IsEmpty())
+    {
+        return;
+    }
+
+    const int32 TilesPerSide = Resolution / TileSize;
+    const int32 TileCount = TilesPerSide * TilesPerSide;
+
+    // Pass 1: compute each result's packed cell (X | Y << 16) and count per tile
+    TArray<uint32> PackedCells;
+    PackedCells.SetNumUninitialized(Points.Num());
+    TArray<int32> TileStarts;
+    TileStarts.SetNumZeroed(TileCount + 1);
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        const FS__ViewShedPoint &Point = Points[i];
+        const FIntPoint Cell = ShouldSplat(Point, bSurfaceHitsOnly) ? WorldToCell(Point.HitLocation) : FIntPoint(INDEX_NONE, INDEX_NONE);
+        if (Cell.X == INDEX_NONE)
+        {
+            PackedCells[i] = MAX_uint32;
+            continue;
+        }
+        PackedCells[i] = uint32(Cell.X) | (uint32(Cell.Y) << 16);
+        TileStarts[(Cell.Y / TileSize) * TilesPerSide + (Cell.X / TileSize) + 1]++;
+    }
+
+    // Prefix sum of tile counts
+    for (int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+    {
+        TileStarts[TileIndex + 1] += TileStarts[TileIndex];
+    }
+
+    // Pass 2: scatter result indices into tile buckets
+    TArray<int32> TileCursor(TileStarts.GetData(), TileCount);
+    TArray<int32> SortedPoints;
+    SortedPoints.SetNumUninitialized(TileStarts[TileCount]);
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        const uint32 Packed = PackedCells[i];
+        if (Packed == MAX_uint32)
+        {
+            continue;
+        }
+        const int32 X = int32(Packed & 0xFFFFu);
+        const int32 Y = int32(Packed >> 16);
+        SortedPoints[TileCursor[(Y / TileSize) * TilesPerSide + (X / TileSize)]++] = i;
+    }
+
+    // Pass 3: each tile owns its words exclusively
+    ParallelFor(TileCount, [&](int32 TileIndex)
+                {
+                    for (int32 Slot = TileStarts[TileIndex]; Slot < TileStarts[TileIndex + 1]; ++Slot)
+                    {
+                        const int32 PointIndex = SortedPoints[Slot];
+                        const uint32 Packed = PackedCells[PointIndex];
+                        OrCell(int32(Packed & 0xFFFFu), int32(Packed >> 16), Points[PointIndex].bIsVisible ? CellVisible : CellHidden);
+                    } });
+}
+
+/**
+ * Write the grid into a BGRA8 texture
+ * Pixels are produced row-parallel into a heap buffer that the render thread frees after the upload
+ */
+void FS__ViewShedWorldRaster::FillTexture(UTexture2D *Texture) const
+{
+    if (!Texture || !IsInitialized() || Texture->GetSizeX() != Resolution || Texture->GetSizeY() != Resolution)
+    {
+        return;
+    }
+
+    static const FColor StateColors[4] = {
+        FColor(0, 0, 0, 0),      // Unobserved
+        FColor(0, 255, 0, 255),  // Visible
+        FColor(255, 0, 0, 255),  // Hidden
+        FColor(255, 255, 0, 255) // Mixed
+    };
+
+    const int32 PixelCount = Resolution * Resolution;
+    FColor *Pixels = static_cast<FColor *>(FMemory::Malloc(PixelCount * sizeof(FColor)));
+
+    ParallelFor(Resolution, [&](int32 Y)
+                {
+                    const uint32 *RowWords = Cells.GetData() + Y * GetWordsPerRow();
+                    FColor *RowPixels = Pixels + Y * Resolution;
+                    for (int32 X = 0; X < Resolution; ++X)
+                    {
+                        RowPixels[X] = StateColors[(RowWords[X >> 4] >> ((X & 15) * 2)) & 3u];
+                    } });
+
+    FUpdateTextureRegion2D *Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Resolution, Resolution);
+    Texture->UpdateTextureRegions(
+        0,
+        1,
+        Region,
+        Resolution * sizeof(FColor),
+        sizeof(FColor),
+        reinterpret_cast<uint8 *>(Pixels),
+        [](uint8 *SrcData, const FUpdateTextureRegion2D *Regions)
+        {
+            FMemory::Free(SrcData);
+            delete Regions;
+        });
+}
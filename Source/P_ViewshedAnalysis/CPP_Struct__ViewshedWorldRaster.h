@@ -0,0 +1,102 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FS__ViewShedPoint;
+class UTexture2D;
+
+/**
+ * World-aligned, bit-packed XY visibility grid
+ * Every cell stores two bits (visible, hidden); a cell with neither bit set is unobserved and a cell
+ * with both bits set received samples of both states. Sixteen cells are packed per 32-bit word, row major.
+ * The grid is split into square tiles whose width is a multiple of 16 cells, so tiles never share a word
+ * and can be splatted in parallel without synchronization.
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedWorldRaster
+{
+    /** Two-bit cell values */
+    static constexpr uint32 CellUnobserved = 0u;
+    static constexpr uint32 CellVisible = 1u;
+    static constexpr uint32 CellHidden = 2u;
+    static constexpr uint32 CellMixed = 3u;
+
+    /** Cells per packed word */
+    static constexpr int32 CellsPerWord = 16;
+
+    /** Edge length of a parallel splat tile, in cells */
+    static constexpr int32 TileSize = 64;
+
+    /**
+     * Allocate (or reuse) the grid and align it to the world so that Center lies near its middle
+     * The origin is snapped to a multiple of CellSize, so rasters from different observers line up
+     * @param Resolution - Cells per side, rounded up to a multiple of TileSize
+     */
+    void Initialize(const FVector2D &Center, float InCellSize, int32 Resolution);
+
+    /** Mark every cell unobserved without releasing storage */
+    void Clear();
+
+    /** Release all storage */
+    void Reset();
+
+    /** Whether Initialize has been called */
+    bool IsInitialized() const { return Resolution > 0; }
+
+    /** Splat results [Begin, End) serially; used for the incremental per-frame update */
+    void SplatRange(TConstArrayView<FS__ViewShedPoint> Points, int32 Begin, int32 End, bool bSurfaceHitsOnly);
+
+    /** Splat every result, binning by tile first and then filling tiles in parallel */
+    void SplatAllParallel(TConstArrayView<FS__ViewShedPoint> Points, bool bSurfaceHitsOnly);
+
+    /** Cell coordinate for a world location, or (-1, -1) if outside the grid */
+    FIntPoint WorldToCell(const FVector &Location) const;
+
+    /** Two-bit state of a cell (CellUnobserved for out-of-range coordinates) */
+    uint32 GetCellState(int32 X, int32 Y) const;
+
+    /** Write the grid into a BGRA8 texture of matching size (visible = green, hidden = red, mixed = yellow) */
+    void FillTexture(UTexture2D *Texture) const;
+
+    /** Packed cell words, row major, WordsPerRow words per row */
+    TConstArrayView<uint32> GetRawData() const { return Cells; }
+
+    /** Cells per side */
+    int32 GetResolution() const { return Resolution; }
+
+    /** Packed words per grid row */
+    int32 GetWordsPerRow() const { return Resolution / CellsPerWord; }
+
+    /** World size of one cell */
+    float GetCellSize() const { return CellSize; }
+
+    /** World XY of the minimum grid corner */
+    FVector2D GetOrigin() const { return Origin; }
+
+    /** Whether a result should be rasterized (optionally skipping samples that never reached a surface) */
+    static bool ShouldSplat(const FS__ViewShedPoint &Point, bool bSurfaceHitsOnly);
+
+private:
+    /** OR a two-bit value into a cell */
+    void OrCell(int32 X, int32 Y, uint32 Value)
+    {
+        Cells[Y * GetWordsPerRow() + (X >> 4)] |= Value << ((X & 15) * 2);
+    }
+
+    /** World XY of the minimum grid corner */
+    FVector2D Origin = FVector2D::ZeroVector;
+
+    /** World size of one cell */
+    float CellSize = 100.0f;
+
+    /** Cells per side */
+    int32 Resolution = 0;
+
+    /** Packed two-bit cells */
+    TArray<uint32> Cells;
+};
@@ -0,0 +1,149 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Subsystem__ViewshedDecalParameters.h"
+#include "Engine/Texture2D.h"
+
+namespace ViewshedDecalParameters
+{
+    /** Rows allocated on first use */
+    static constexpr int32 InitialCapacity = 16;
+}
+
+/**
+ * Reserve a row
+ */
+int32 UCPP_Subsystem__ViewshedDecalParameters::AcquireSlot()
+{
+    int32 Slot = UsedSlots.Find(false);
+    if (Slot == INDEX_NONE)
+    {
+        Slot = UsedSlots.Num();
+        Grow(FMath::Max(ViewshedDecalParameters::InitialCapacity, UsedSlots.Num() * 2));
+    }
+    UsedSlots[Slot] = true;
+    return Slot;
+}
+
+/**
+ * Give a row back
+ */
+void UCPP_Subsystem__ViewshedDecalParameters::ReleaseSlot(int32 Slot)
+{
+    if (!UsedSlots.IsValidIndex(Slot))
+    {
+        return;
+    }
+    UsedSlots[Slot] = false;
+
+    // A released row reads as a zero-range frustum, so a stale binding shows nothing
+    WriteFrustum(Slot, FVector::ZeroVector, FVector::ForwardVector, FVector::RightVector, FVector::UpVector, 0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+/**
+ * Overwrite a row's frustum parameters
+ */
+void UCPP_Subsystem__ViewshedDecalParameters::WriteFrustum(int32 Slot, const FVector &Origin, const FVector &Forward, const FVector &Right, const FVector &Up,
+                                                           float MaxDistance, float VerticalFOVDeg, float HorizontalFOVDeg, float NormalThreshold)
+{
+    if (!UsedSlots.IsValidIndex(Slot))
+    {
+        return;
+    }
+
+    FLinearColor *Row = Texels.GetData() + Slot * TexelsPerObserver;
+    Row[0] = FLinearColor(float(Origin.X), float(Origin.Y), float(Origin.Z), MaxDistance);
+    Row[1] = FLinearColor(float(Forward.X), float(Forward.Y), float(Forward.Z), VerticalFOVDeg);
+    Row[2] = FLinearColor(float(Right.X), float(Right.Y), float(Right.Z), HorizontalFOVDeg);
+    Row[3] = FLinearColor(float(Up.X), float(Up.Y), float(Up.Z), NormalThreshold);
+
+    DirtyRowMin = DirtyRowMin == INDEX_NONE ? Slot : FMath::Min(DirtyRowMin, Slot);
+    DirtyRowMax = FMath::Max(DirtyRowMax, Slot);
+}
+
+/**
+ * Grow the rows and recreate the texture
+ */
+void UCPP_Subsystem__ViewshedDecalParameters::Grow(int32 Capacity)
+{
+    const int32 OldCapacity = UsedSlots.Num();
+    if (Capacity <= OldCapacity)
+    {
+        return;
+    }
+
+    UsedSlots.Add(false, Capacity - OldCapacity);
+    Texels.AddZeroed((Capacity - OldCapacity) * TexelsPerObserver);
+
+    ParameterTexture = UTexture2D::CreateTransient(TexelsPerObserver, Capacity, PF_A32B32G32R32F, TEXT("ViewshedDecalParameters"));
+    if (ParameterTexture)
+    {
+        // Rows are fetched texel by texel (Load), never filtered
+        ParameterTexture->Filter = TF_Nearest;
+        ParameterTexture->SRGB = false;
+        ParameterTexture->UpdateResource();
+    }
+
+    // The new texture starts empty, so every row is uploaded
+    DirtyRowMin = 0;
+    DirtyRowMax = Capacity - 1;
+}
+
+/**
+ * Upload every row written since the last tick in one region
+ */
+void UCPP_Subsystem__ViewshedDecalParameters::Tick(float DeltaTime)
+{
+    if (DirtyRowMin == INDEX_NONE || !ParameterTexture)
+    {
+        return;
+    }
+
+    const int32 RowCount = DirtyRowMax - DirtyRowMin + 1;
+    const int32 RowBytes = TexelsPerObserver * sizeof(FLinearColor);
+
+    // The render thread frees the copy once the upload is done
+    uint8 *Pixels = static_cast<uint8 *>(FMemory::Malloc(RowCount * RowBytes));
+    FMemory::Memcpy(Pixels, Texels.GetData() + DirtyRowMin * TexelsPerObserver, RowCount * RowBytes);
+
+    FUpdateTextureRegion2D *Region = new FUpdateTextureRegion2D(0, DirtyRowMin, 0, 0, TexelsPerObserver, RowCount);
+    ParameterTexture->UpdateTextureRegions(
+        0,
+        1,
+        Region,
+        RowBytes,
+        sizeof(FLinearColor),
+        Pixels,
+        [](uint8 *SrcData, const FUpdateTextureRegion2D *Regions)
+        {
+            FMemory::Free(SrcData);
+            delete Regions;
+        });
+
+    DirtyRowMin = INDEX_NONE;
+    DirtyRowMax = INDEX_NONE;
+}
+
+/**
+ * Stat id for the tickable object list
+ */
+TStatId UCPP_Subsystem__ViewshedDecalParameters::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCPP_Subsystem__ViewshedDecalParameters, STATGROUP_Tickables);
+}
+
+/**
+ * Drop every row and the texture
+ */
+void UCPP_Subsystem__ViewshedDecalParameters::Deinitialize()
+{
+    Texels.Empty();
+    UsedSlots.Empty();
+    ParameterTexture = nullptr;
+    DirtyRowMin = INDEX_NONE;
+    DirtyRowMax = INDEX_NONE;
+    Super::Deinitialize();
+}
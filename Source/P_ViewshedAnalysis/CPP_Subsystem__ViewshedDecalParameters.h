@@ -0,0 +1,68 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CPP_Subsystem__ViewshedDecalParameters.generated.h"
+
+class UTexture2D;
+
+/**
+ * Frustum parameters of every decal-visualized observer in the world, packed into one float texture
+ * Each observer owns a row of TexelsPerObserver float4 texels (see ViewshedFetchSharedFrustum in ViewshedCommon.ush):
+ *   0: Origin, MaxDistance   1: Forward, VertFOVDeg   2: Right, HorizFOVDeg   3: Up, NormalThreshold
+ * Observers write their row only when it changes; all dirty rows are uploaded in one region per frame.
+ */
+UCLASS()
+class P_VIEWSHEDANALYSIS_API UCPP_Subsystem__ViewshedDecalParameters : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Float4 texels per observer row */
+    static constexpr int32 TexelsPerObserver = 4;
+
+    /** Reserve a row; the texture grows (and is recreated) when every row is taken */
+    int32 AcquireSlot();
+
+    /** Give a row back */
+    void ReleaseSlot(int32 Slot);
+
+    /** Overwrite a row's frustum parameters; uploaded on the next tick */
+    void WriteFrustum(int32 Slot, const FVector &Origin, const FVector &Forward, const FVector &Right, const FVector &Up,
+                      float MaxDistance, float VerticalFOVDeg, float HorizontalFOVDeg, float NormalThreshold);
+
+    /** Shared parameter texture (PF_A32B32G32R32F, TexelsPerObserver x capacity) */
+    UTexture2D *GetParameterTexture() const { return ParameterTexture; }
+
+    /** Rows currently allocated */
+    int32 GetCapacity() const { return UsedSlots.Num(); }
+
+    //~ UTickableWorldSubsystem
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual void Deinitialize() override;
+
+private:
+    /** Grow the rows and recreate the texture to hold at least Capacity observers */
+    void Grow(int32 Capacity);
+
+    /** Row-major texel copy of the texture contents */
+    TArray<FLinearColor> Texels;
+
+    /** Which rows are taken */
+    TBitArray<> UsedSlots;
+
+    /** First and last row written since the last upload (INDEX_NONE when clean) */
+    int32 DirtyRowMin = INDEX_NONE;
+    int32 DirtyRowMax = INDEX_NONE;
+
+    /** Texture the decal materials sample */
+    UPROPERTY(Transient)
+    UTexture2D *ParameterTexture = nullptr;
+};
@@ -0,0 +1,402 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Subsystem__ViewshedExploration.h"
+#include "CPP_Actor__Viewshed.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace ViewshedExploration
+{
+    /** File identifier ("VSEX") */
+    static constexpr uint32 Magic = 0x56534558;
+
+    /** Bump when the serialized layout changes */
+    static constexpr int32 Version = 1;
+
+    /** Cells per tile side */
+    static constexpr int32 TileSize = FS__ViewShedExplorationTile::TileSize;
+}
+
+/**
+ * Change the cell size and timestamp tracking; clears the current map
+ */
+void UCPP_Subsystem__ViewshedExploration::ConfigureExploration(float InCellSize, bool bInTrackTimestamps)
+{
+    CellSize = FMath::Max(1.0f, InCellSize);
+    bTrackTimestamps = bInTrackTimestamps;
+    ClearExploration();
+}
+
+/**
+ * Remove every explored cell
+ */
+void UCPP_Subsystem__ViewshedExploration::ClearExploration()
+{
+    Tiles.Empty();
+}
+
+/**
+ * Split a world location into tile and in-tile cell coordinates
+ */
+void UCPP_Subsystem__ViewshedExploration::WorldToTileCell(const FVector2D &Location, FIntPoint &OutTile, int32 &OutCellX, int32 &OutCellY) const
+{
+    const int64 CellX = FMath::FloorToInt64(Location.X / CellSize);
+    const int64 CellY = FMath::FloorToInt64(Location.Y / CellSize);
+    // Floor division keeps negative coordinates in the correct tile
+    const int64 TileX = CellX >= 0 ? CellX / ViewshedExploration::TileSize : (CellX - ViewshedExploration::TileSize + 1) / ViewshedExploration::TileSize;
+    const int64 TileY = CellY >= 0 ? CellY / ViewshedExploration::TileSize : (CellY - ViewshedExploration::TileSize + 1) / ViewshedExploration::TileSize;
+    OutTile = FIntPoint(int32(TileX), int32(TileY));
+    OutCellX = int32(CellX - TileX * ViewshedExploration::TileSize);
+    OutCellY = int32(CellY - TileY * ViewshedExploration::TileSize);
+}
+
+/**
+ * OR the visible samples of an observer's last completed analysis into the map
+ */
+void UCPP_Subsystem__ViewshedExploration::AccumulateObserver(const ACPP_Actor__Viewshed *Observer)
+{
+    if (!IsValid(Observer))
+    {
+        return;
+    }
+
+    // Horizon Map observers derive their band points one band at a time
+    Observer->ForEachResultBatch([this, Observer](TConstArrayView<FS__ViewShedPoint> Batch)
+                                 { AccumulatePoints(Batch, Observer->bWorldRaster_SurfaceHitsOnly); });
+}
+
+/**
+ * OR visible samples into the map
+ */
+int32 UCPP_Subsystem__ViewshedExploration::AccumulatePoints(TConstArrayView<FS__ViewShedPoint> Points, bool bSurfaceHitsOnly)
+{
+    // Stamp pass: gather visible samples into scratch bitsets for just the touched tiles
+    TMap<FIntPoint, FS__ViewShedExplorationTile> Stamps;
+    for (const FS__ViewShedPoint &Point : Points)
+    {
+        if (!Point.bIsVisible || !FS__ViewShedWorldRaster::ShouldSplat(Point, bSurfaceHitsOnly))
+        {
+            continue;
+        }
+
+        FIntPoint TileCoord;
+        int32 CellX, CellY;
+        WorldToTileCell(FVector2D(Point.HitLocation.X, Point.HitLocation.Y), TileCoord, CellX, CellY);
+        Stamps.FindOrAdd(TileCoord).Rows[CellY] |= uint64(1) << CellX;
+    }
+
+    const UWorld *World = GetWorld();
+    const float Now = World ? World->GetTimeSeconds() : 0.0f;
+    int32 NewlyExplored = 0;
+
+    // Merge pass: O(touched tiles) SIMD OR into the persistent map
+    for (const TPair<FIntPoint, FS__ViewShedExplorationTile> &Stamp : Stamps)
+    {
+        FS__ViewShedExplorationTile &Tile = Tiles.FindOrAdd(Stamp.Key);
+
+        for (int32 Row = 0; Row < ViewshedExploration::TileSize; Row += 2)
+        {
+            const VectorRegister4Int Old = VectorIntLoad(&Tile.Rows[Row]);
+            const VectorRegister4Int New = VectorIntLoad(&Stamp.Value.Rows[Row]);
+            // Bits present in the stamp but not yet explored
+            alignas(16) uint64 Added[2];
+            VectorIntStoreAligned(VectorIntAndNot(Old, New), Added);
+            VectorIntStore(VectorIntOr(Old, New), &Tile.Rows[Row]);
+            NewlyExplored += int32(FPlatformMath::CountBits(Added[0]) + FPlatformMath::CountBits(Added[1]));
+        }
+
+        if (bTrackTimestamps)
+        {
+            if (Tile.LastSeen.IsEmpty())
+            {
+                Tile.LastSeen.Init(-1.0f, ViewshedExploration::TileSize * ViewshedExploration::TileSize);
+            }
+
+            // Every stamped cell was seen this analysis, not only the newly explored ones
+            for (int32 Row = 0; Row < ViewshedExploration::TileSize; ++Row)
+            {
+                uint64 Bits = Stamp.Value.Rows[Row];
+                while (Bits != 0)
+                {
+                    const int32 Column = int32(FMath::CountTrailingZeros64(Bits));
+                    Tile.LastSeen[Row * ViewshedExploration::TileSize + Column] = Now;
+                    Bits &= Bits - 1;
+                }
+            }
+        }
+    }
+
+    // Keep per-tile counts exact for O(1) coverage of fully enclosed tiles
+    if (NewlyExplored > 0)
+    {
+        for (const TPair<FIntPoint, FS__ViewShedExplorationTile> &Stamp : Stamps)
+        {
+            FS__ViewShedExplorationTile &Tile = Tiles.FindChecked(Stamp.Key);
+            int32 Count = 0;
+            for (const uint64 RowBits : Tile.Rows)
+            {
+                Count += int32(FPlatformMath::CountBits(RowBits));
+            }
+            Tile.ExploredCount = Count;
+        }
+    }
+
+    return NewlyExplored;
+}
+
+/**
+ * Whether the cell containing Location has been explored
+ */
+bool UCPP_Subsystem__ViewshedExploration::IsLocationExplored(FVector Location) const
+{
+    FIntPoint TileCoord;
+    int32 CellX, CellY;
+    WorldToTileCell(FVector2D(Location.X, Location.Y), TileCoord, CellX, CellY);
+
+    const FS__ViewShedExplorationTile *Tile = Tiles.Find(TileCoord);
+    return Tile && (Tile->Rows[CellY] >> CellX) & 1u;
+}
+
+/**
+ * Last world time the cell containing Location was seen
+ */
+float UCPP_Subsystem__ViewshedExploration::GetLastSeenTime(FVector Location) const
+{
+    FIntPoint TileCoord;
+    int32 CellX, CellY;
+    WorldToTileCell(FVector2D(Location.X, Location.Y), TileCoord, CellX, CellY);
+
+    const FS__ViewShedExplorationTile *Tile = Tiles.Find(TileCoord);
+    if (!Tile || Tile->LastSeen.IsEmpty())
+    {
+        return -1.0f;
+    }
+    return Tile->LastSeen[CellY * ViewshedExploration::TileSize + CellX];
+}
+
+/**
+ * Fraction of cells inside the XY box that have been explored
+ * Fully enclosed tiles use their cached count; edge tiles popcount masked rows. Cost follows the covered tiles, not the map size
+ */
+float UCPP_Subsystem__ViewshedExploration::GetExploredFractionInBox(FVector2D BoxMin, FVector2D BoxMax) const
+{
+    const FVector2D SafeMin(FMath::Min(BoxMin.X, BoxMax.X), FMath::Min(BoxMin.Y, BoxMax.Y));
+    const FVector2D SafeMax(FMath::Max(BoxMin.X, BoxMax.X), FMath::Max(BoxMin.Y, BoxMax.Y));
+
+    // Global cell range covered by the box (inclusive)
+    const int64 MinCellX = FMath::FloorToInt64(SafeMin.X / CellSize);
+    const int64 MinCellY = FMath::FloorToInt64(SafeMin.Y / CellSize);
+    const int64 MaxCellX = FMath::FloorToInt64(SafeMax.X / CellSize);
+    const int64 MaxCellY = FMath::FloorToInt64(SafeMax.Y / CellSize);
+    const int64 TotalCells = (MaxCellX - MinCellX + 1) * (MaxCellY - MinCellY + 1);
+    if (TotalCells <= 0)
+    {
+        return 0.0f;
+    }
+
+    FIntPoint MinTile, MaxTile;
+    int32 Unused0, Unused1;
+    WorldToTileCell(SafeMin, MinTile, Unused0, Unused1);
+    WorldToTileCell(SafeMax, MaxTile, Unused0, Unused1);
+
+    int64 ExploredCells = 0;
+    const auto AccumulateTile = [&](const FIntPoint &TileCoord, const FS__ViewShedExplorationTile &Tile)
+    {
+        // Clip the box to this tile in local cell coordinates
+        const int64 TileCellX = int64(TileCoord.X) * ViewshedExploration::TileSize;
+        const int64 TileCellY = int64(TileCoord.Y) * ViewshedExploration::TileSize;
+        const int32 LocalMinX = int32(FMath::Max<int64>(MinCellX - TileCellX, 0));
+        const int32 LocalMinY = int32(FMath::Max<int64>(MinCellY - TileCellY, 0));
+        const int32 LocalMaxX = int32(FMath::Min<int64>(MaxCellX - TileCellX, ViewshedExploration::TileSize - 1));
+        const int32 LocalMaxY = int32(FMath::Min<int64>(MaxCellY - TileCellY, ViewshedExploration::TileSize - 1));
+
+        if (LocalMinX == 0 && LocalMinY == 0 && LocalMaxX == ViewshedExploration::TileSize - 1 && LocalMaxY == ViewshedExploration::TileSize - 1)
+        {
+            ExploredCells += Tile.ExploredCount;
+            return;
+        }
+
+        const int32 Width = LocalMaxX - LocalMinX + 1;
+        const uint64 ColumnMask = (Width >= 64 ? ~uint64(0) : ((uint64(1) << Width) - 1)) << LocalMinX;
+        for (int32 Row = LocalMinY; Row <= LocalMaxY; ++Row)
+        {
+            ExploredCells += FPlatformMath::CountBits(Tile.Rows[Row] & ColumnMask);
+        }
+    };
+
+    // Look up the covered tiles directly unless the box spans more tiles than the map holds
+    const int64 TileRangeCount = (int64(MaxTile.X) - MinTile.X + 1) * (int64(MaxTile.Y) - MinTile.Y + 1);
+    if (TileRangeCount < Tiles.Num())
+    {
+        for (int32 TileY = MinTile.Y; TileY <= MaxTile.Y; ++TileY)
+        {
+            for (int32 TileX = MinTile.X; TileX <= MaxTile.X; ++TileX)
+            {
+                const FIntPoint TileCoord(TileX, TileY);
+                if (const FS__ViewShedExplorationTile *Tile = Tiles.Find(TileCoord))
+                {
+                    AccumulateTile(TileCoord, *Tile);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (const TPair<FIntPoint, FS__ViewShedExplorationTile> &Pair : Tiles)
+        {
+            const FIntPoint &TileCoord = Pair.Key;
+            if (TileCoord.X >= MinTile.X && TileCoord.X <= MaxTile.X && TileCoord.Y >= MinTile.Y && TileCoord.Y <= MaxTile.Y)
+            {
+                AccumulateTile(TileCoord, Pair.Value);
+            }
+        }
+    }
+
+    return float(double(ExploredCells) / double(TotalCells));
+}
+
+/**
+ * Total number of explored cells
+ */
+int32 UCPP_Subsystem__ViewshedExploration::GetExploredCellCount() const
+{
+    int32 Count = 0;
+    for (const TPair<FIntPoint, FS__ViewShedExplorationTile> &Pair : Tiles)
+    {
+        Count += Pair.Value.ExploredCount;
+    }
+    return Count;
+}
+
+/**
+ * Serialize the whole map
+ */
+void UCPP_Subsystem__ViewshedExploration::SerializeExploration(FArchive &Ar)
+{
+    uint32 FileMagic = ViewshedExploration::Magic;
+    int32 FileVersion = ViewshedExploration::Version;
+    Ar << FileMagic;
+    Ar << FileVersion;
+    if (Ar.IsLoading() && (FileMagic != ViewshedExploration::Magic || FileVersion != ViewshedExploration::Version))
+    {
+        Ar.SetError();
+        return;
+    }
+
+    // Settings go through locals so a rejected load leaves the current map untouched
+    float FileCellSize = CellSize;
+    bool bFileTrackTimestamps = bTrackTimestamps;
+    Ar << FileCellSize;
+    Ar << bFileTrackTimestamps;
+
+    int32 TileCount = Tiles.Num();
+    Ar << TileCount;
+
+    if (Ar.IsLoading())
+    {
+        // The data may come from anywhere, so nothing is sized from it until it has been read and checked
+        if (!(FileCellSize > 0.0f) || TileCount < 0)
+        {
+            Ar.SetError();
+            return;
+        }
+
+        // Tiles load into a separate map that replaces the live one only once the whole archive has been read
+        constexpr int32 TileCellCount = ViewshedExploration::TileSize * ViewshedExploration::TileSize;
+        TMap<FIntPoint, FS__ViewShedExplorationTile> LoadedTiles;
+        for (int32 i = 0; i < TileCount && !Ar.IsError(); ++i)
+        {
+            FIntPoint TileCoord;
+            Ar << TileCoord;
+            FS__ViewShedExplorationTile &Tile = LoadedTiles.Add(TileCoord);
+            Ar.Serialize(Tile.Rows, sizeof(Tile.Rows));
+
+            // Same layout as TArray serialization, but timestamps are either absent or cover every cell
+            int32 LastSeenCount = 0;
+            Ar << LastSeenCount;
+            if (LastSeenCount != 0 && LastSeenCount != TileCellCount)
+            {
+                Ar.SetError();
+                return;
+            }
+            Tile.LastSeen.SetNumUninitialized(LastSeenCount);
+            for (float &Time : Tile.LastSeen)
+            {
+                Ar << Time;
+            }
+
+            // Recompute rather than trust the stored count
+            Tile.ExploredCount = 0;
+            for (const uint64 RowBits : Tile.Rows)
+            {
+                Tile.ExploredCount += int32(FPlatformMath::CountBits(RowBits));
+            }
+        }
+
+        if (!Ar.IsError())
+        {
+            CellSize = FileCellSize;
+            bTrackTimestamps = bFileTrackTimestamps;
+            Tiles = MoveTemp(LoadedTiles);
+        }
+    }
+    else
+    {
+        for (TPair<FIntPoint, FS__ViewShedExplorationTile> &Pair : Tiles)
+        {
+            Ar << Pair.Key;
+            Ar.Serialize(Pair.Value.Rows, sizeof(Pair.Value.Rows));
+            Ar << Pair.Value.LastSeen;
+        }
+    }
+}
+
+/**
+ * Write the map into a byte array
+ */
+void UCPP_Subsystem__ViewshedExploration::ExportExploration(TArray<uint8> &OutData)
+{
+    OutData.Reset();
+    FMemoryWriter Writer(OutData);
+    SerializeExploration(Writer);
+}
+
+/**
+ * Replace the map with previously exported data
+ */
+bool UCPP_Subsystem__ViewshedExploration::ImportExploration(const TArray<uint8> &Data)
+{
+    // A rejected buffer leaves the current map as it was; SerializeExploration only swaps in a fully read one
+    FMemoryReader Reader(Data);
+    SerializeExploration(Reader);
+    return !Reader.IsError();
+}
+
+/**
+ * Save the map to a file
+ */
+bool UCPP_Subsystem__ViewshedExploration::SaveExplorationToFile(const FString &FilePath)
+{
+    TArray<uint8> Data;
+    ExportExploration(Data);
+    return FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+/**
+ * Load the map from a file
+ */
+bool UCPP_Subsystem__ViewshedExploration::LoadExplorationFromFile(const FString &FilePath)
+{
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+    {
+        return false;
+    }
+    return ImportExploration(Data);
+}
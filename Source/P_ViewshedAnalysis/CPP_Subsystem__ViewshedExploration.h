@@ -0,0 +1,140 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CPP_Subsystem__ViewshedExploration.generated.h"
+
+struct FS__ViewShedPoint;
+class ACPP_Actor__Viewshed;
+
+/**
+ * One 64x64 cell tile of the exploration map
+ * Each row of the tile is one 64-bit word, so merging a stamp is 32 SIMD ORs
+ */
+struct P_VIEWSHEDANALYSIS_API FS__ViewShedExplorationTile
+{
+    /** Cells per tile side */
+    static constexpr int32 TileSize = 64;
+
+    /** Explored bit per cell, one word per row */
+    uint64 Rows[TileSize] = {};
+
+    /** Number of explored cells in this tile (kept so fully covered tiles answer region queries in O(1)) */
+    int32 ExploredCount = 0;
+
+    /** Optional per-cell last-seen world time (allocated on first timestamped write, -1 = never seen) */
+    TArray<float> LastSeen;
+};
+
+/**
+ * Persistent, world-space fog-of-war map accumulated from completed viewshed analyses
+ * Storage is a sparse map of bit tiles keyed by tile coordinate, so memory scales with explored area
+ * and every analysis only touches the tiles its visible samples landed in
+ */
+UCLASS()
+class P_VIEWSHEDANALYSIS_API UCPP_Subsystem__ViewshedExploration : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    //////////////////////////////////////////////////////////////////////////
+    // CONFIGURATION
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Change the cell size and timestamp tracking; clears the current map
+     * @param InCellSize - World size of one exploration cell (in Unreal units)
+     * @param bInTrackTimestamps - Store per-cell last-seen times alongside the explored bits
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    void ConfigureExploration(float InCellSize = 100.0f, bool bInTrackTimestamps = false);
+
+    /** Remove every explored cell */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    void ClearExploration();
+
+    //////////////////////////////////////////////////////////////////////////
+    // ACCUMULATION
+    //////////////////////////////////////////////////////////////////////////
+
+    /** OR the visible samples of an observer's last completed analysis into the map */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    void AccumulateObserver(const ACPP_Actor__Viewshed *Observer);
+
+    /**
+     * OR visible samples into the map
+     * Samples are first stamped into per-tile scratch bitsets, then each touched tile is merged with SIMD OR
+     * @param bSurfaceHitsOnly - Skip visible samples that never reached a surface
+     * @return Number of cells that became explored
+     */
+    int32 AccumulatePoints(TConstArrayView<FS__ViewShedPoint> Points, bool bSurfaceHitsOnly);
+
+    //////////////////////////////////////////////////////////////////////////
+    // QUERIES
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Whether the cell containing Location has been explored */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Exploration")
+    bool IsLocationExplored(FVector Location) const;
+
+    /** Last world time the cell containing Location was seen (-1 if never, or timestamps are disabled) */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Exploration")
+    float GetLastSeenTime(FVector Location) const;
+
+    /** Fraction (0-1) of cells inside the XY box that have been explored */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Exploration")
+    float GetExploredFractionInBox(FVector2D BoxMin, FVector2D BoxMax) const;
+
+    /** Total number of explored cells */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Exploration")
+    int32 GetExploredCellCount() const;
+
+    /** World size of one exploration cell */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Exploration")
+    float GetCellSize() const { return CellSize; }
+
+    /** Read-only access to the sparse tiles for native consumers */
+    const TMap<FIntPoint, FS__ViewShedExplorationTile> &GetTiles() const { return Tiles; }
+
+    //////////////////////////////////////////////////////////////////////////
+    // PERSISTENCE
+    //////////////////////////////////////////////////////////////////////////
+
+    /** Serialize the whole map (configuration, tiles and optional timestamps); a failed load keeps the current map */
+    void SerializeExploration(FArchive &Ar);
+
+    /** Write the map into a byte array (e.g. to embed in a SaveGame object) */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    void ExportExploration(TArray<uint8> &OutData);
+
+    /** Replace the map with data produced by ExportExploration; returns false, keeping the current map, on a malformed or incompatible buffer */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    bool ImportExploration(const TArray<uint8> &Data);
+
+    /** Save the map to a file */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    bool SaveExplorationToFile(const FString &FilePath);
+
+    /** Load the map from a file written by SaveExplorationToFile */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Exploration")
+    bool LoadExplorationFromFile(const FString &FilePath);
+
+private:
+    /** Split a world location into tile coordinate and in-tile cell coordinate */
+    void WorldToTileCell(const FVector2D &Location, FIntPoint &OutTile, int32 &OutCellX, int32 &OutCellY) const;
+
+    /** World size of one exploration cell */
+    float CellSize = 100.0f;
+
+    /** Whether per-cell last-seen times are recorded */
+    bool bTrackTimestamps = false;
+
+    /** Sparse explored tiles */
+    TMap<FIntPoint, FS__ViewShedExplorationTile> Tiles;
+};
@@ -0,0 +1,224 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#include "CPP_Subsystem__ViewshedSignificance.h"
+#include "CPP_Actor__Viewshed.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+namespace ViewshedSignificance
+{
+    /** Viewer travel, as a fraction of the falloff range, that re-rates every observer (bounds the significance error to 2%) */
+    static constexpr float ViewerMoveTolerance = 0.02f;
+
+    /** Cosine of the viewer rotation that re-rates every observer (5 degrees) */
+    static constexpr float ViewerTurnToleranceCos = 0.9962f;
+}
+
+/**
+ * Change the evaluation parameters
+ */
+void UCPP_Subsystem__ViewshedSignificance::ConfigureSignificance(float InNearDistance, float InFarDistance, float InOffScreenScale, float InEvaluationInterval)
+{
+    NearDistance = FMath::Max(0.0f, InNearDistance);
+    FarDistance = FMath::Max(NearDistance + 1.0f, InFarDistance);
+    OffScreenScale = FMath::Clamp(InOffScreenScale, 0.0f, 1.0f);
+    EvaluationInterval = FMath::Max(0.0f, InEvaluationInterval);
+    EvaluateNow();
+}
+
+/**
+ * Start rating an observer
+ */
+void UCPP_Subsystem__ViewshedSignificance::RegisterObserver(ACPP_Actor__Viewshed *Observer)
+{
+    if (IsValid(Observer))
+    {
+        Observers.AddUnique(Observer);
+        ChangedObservers.Add(Observer);
+    }
+}
+
+/**
+ * Stop rating an observer
+ */
+void UCPP_Subsystem__ViewshedSignificance::UnregisterObserver(ACPP_Actor__Viewshed *Observer)
+{
+    Observers.RemoveSwap(Observer);
+    ChangedObservers.Remove(Observer);
+}
+
+/**
+ * Queue one observer for re-rating
+ */
+void UCPP_Subsystem__ViewshedSignificance::NotifyObserverChanged(ACPP_Actor__Viewshed *Observer)
+{
+    // Observers moving every frame land here every frame, so this stays O(1)
+    if (IsValid(Observer) && Observer->bUseSignificance)
+    {
+        ChangedObservers.Add(Observer);
+    }
+}
+
+/**
+ * Sample the views at the configured interval and re-rate whatever the events since the last sample affect
+ */
+void UCPP_Subsystem__ViewshedSignificance::Tick(float DeltaTime)
+{
+    TimeSinceEvaluation += DeltaTime;
+    if (TimeSinceEvaluation < EvaluationInterval)
+    {
+        return;
+    }
+    TimeSinceEvaluation = 0.0f;
+
+    // Viewer movement has no engine event, so the views are sampled; only a real change re-rates everyone
+    TArray<FViewer> Viewers;
+    GatherViewers(Viewers);
+    if (HaveViewersChanged(Viewers))
+    {
+        EvaluateNow();
+        return;
+    }
+
+    // Otherwise only observers that moved, changed relevance or just registered are re-rated
+    const TSet<TWeakObjectPtr<ACPP_Actor__Viewshed>> Changed = MoveTemp(ChangedObservers);
+    ChangedObservers.Reset();
+    for (const TWeakObjectPtr<ACPP_Actor__Viewshed> &ChangedObserver : Changed)
+    {
+        if (ACPP_Actor__Viewshed *Observer = ChangedObserver.Get())
+        {
+            ApplySignificance(*Observer, RatedViewers);
+        }
+    }
+}
+
+/**
+ * Rate every registered observer and apply the result
+ */
+void UCPP_Subsystem__ViewshedSignificance::EvaluateNow()
+{
+    TimeSinceEvaluation = 0.0f;
+    ChangedObservers.Reset();
+
+    RatedViewers.Reset();
+    GatherViewers(RatedViewers);
+
+    for (int32 i = Observers.Num() - 1; i >= 0; --i)
+    {
+        ACPP_Actor__Viewshed *Observer = Observers[i].Get();
+        if (!Observer)
+        {
+            Observers.RemoveAtSwap(i);
+            continue;
+        }
+        ApplySignificance(*Observer, RatedViewers);
+    }
+}
+
+/**
+ * Rate one observer and apply the result
+ */
+void UCPP_Subsystem__ViewshedSignificance::ApplySignificance(ACPP_Actor__Viewshed &Observer, TConstArrayView<FViewer> Viewers) const
+{
+    Observer.SetSignificance(Observer.bUseSignificance ? Evaluate(Observer, Viewers) : 1.0f);
+}
+
+/**
+ * Whether the views moved, turned or changed FOV past the tolerances since every observer was last rated
+ */
+bool UCPP_Subsystem__ViewshedSignificance::HaveViewersChanged(TConstArrayView<FViewer> Viewers) const
+{
+    if (Viewers.Num() != RatedViewers.Num())
+    {
+        return true;
+    }
+
+    // Significance falls off linearly over the falloff range, so a fixed fraction of it bounds the rating error
+    const float MoveTolerance = ViewshedSignificance::ViewerMoveTolerance * (FarDistance - NearDistance);
+    for (int32 i = 0; i < Viewers.Num(); ++i)
+    {
+        const FViewer &Viewer = Viewers[i];
+        const FViewer &Rated = RatedViewers[i];
+        if (FVector::DistSquared(Viewer.Location, Rated.Location) > FMath::Square(MoveTolerance) ||
+            FVector::DotProduct(Viewer.Forward, Rated.Forward) < ViewshedSignificance::ViewerTurnToleranceCos ||
+            !FMath::IsNearlyEqual(Viewer.CosHalfFOV, Rated.CosHalfFOV, KINDA_SMALL_NUMBER))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Collect the view point of every local player
+ */
+void UCPP_Subsystem__ViewshedSignificance::GatherViewers(TArray<FViewer> &OutViewers) const
+{
+    const UWorld *World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController *Controller = It->Get();
+        if (!Controller || !Controller->IsLocalController())
+        {
+            continue;
+        }
+
+        FVector Location;
+        FRotator Rotation;
+        Controller->GetPlayerViewPoint(Location, Rotation);
+        const float FOVDegrees = Controller->PlayerCameraManager ? Controller->PlayerCameraManager->GetFOVAngle() : 90.0f;
+
+        // Widen the cone by the aspect ratio's worst case so observers near the screen corners still count
+        FViewer &Viewer = OutViewers.AddDefaulted_GetRef();
+        Viewer.Location = Location;
+        Viewer.Forward = Rotation.Vector();
+        Viewer.CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(FMath::Min(FOVDegrees * 0.75f, 89.0f)));
+    }
+}
+
+/**
+ * Significance of one observer against the gathered views
+ */
+float UCPP_Subsystem__ViewshedSignificance::Evaluate(const ACPP_Actor__Viewshed &Observer, TConstArrayView<FViewer> Viewers) const
+{
+    const float Relevance = FMath::Max(0.0f, Observer.Significance_GameplayRelevance);
+    if (Viewers.IsEmpty())
+    {
+        return FMath::Min(1.0f, Relevance);
+    }
+
+    // The observer's frustum reaches MaxDistance, so rate its nearest point to the viewer rather than its origin
+    const FVector Origin = Observer.GetActorLocation();
+    const float Reach = Observer.MaxDistance;
+
+    float Best = 0.0f;
+    for (const FViewer &Viewer : Viewers)
+    {
+        const FVector ToObserver = Origin - Viewer.Location;
+        const float Distance = float(ToObserver.Size());
+        const float Falloff = 1.0f - FMath::Clamp((Distance - Reach - NearDistance) / (FarDistance - NearDistance), 0.0f, 1.0f);
+
+        // Inside the view cone, or so close that its frustum surrounds the viewer
+        const bool bOnScreen = Distance <= Reach || FVector::DotProduct(ToObserver / Distance, Viewer.Forward) >= Viewer.CosHalfFOV;
+        Best = FMath::Max(Best, Falloff * (bOnScreen ? 1.0f : OffScreenScale));
+    }
+    return FMath::Min(1.0f, Best * Relevance);
+}
+
+/**
+ * Stat id for the tickable object list
+ */
+TStatId UCPP_Subsystem__ViewshedSignificance::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCPP_Subsystem__ViewshedSignificance, STATGROUP_Tickables);
+}
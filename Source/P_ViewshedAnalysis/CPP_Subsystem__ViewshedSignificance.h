@@ -0,0 +1,104 @@
+/*
+ * @Author: Punal Manalan
+ * @Description: ViewShed Analysis Plugin.
+ * @Date: 04/10/2025
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CPP_Subsystem__ViewshedSignificance.generated.h"
+
+class ACPP_Actor__Viewshed;
+
+/**
+ * Rates registered observers against the local players' views and pushes the result to
+ * ACPP_Actor__Viewshed::SetSignificance, which scales update interval, trace budget and visualization and
+ * stops the observer's tick when it becomes insignificant
+ *
+ * Significance = distance falloff (1 within Near Distance, 0 beyond Far Distance)
+ *              x on-screen factor (1 inside a viewer's FOV cone, Off Screen Scale otherwise)
+ *              x the observer's Gameplay Relevance, clamped to 0-1; the most favourable viewer wins.
+ * Ratings change only on events: every observer is re-rated when a viewer moves, turns or changes FOV past a
+ * tolerance (or joins or leaves), and a single observer when it moves, its relevance changes or it registers.
+ * Views are sampled once per Evaluation Interval, which also batches observer events; between events nothing is rated.
+ * Sleeping observers cost nothing per frame; they are woken by these events, StartAnalysis or WakeObserver.
+ * Without any local player view (editor worlds, servers) every observer is fully significant.
+ */
+UCLASS()
+class P_VIEWSHEDANALYSIS_API UCPP_Subsystem__ViewshedSignificance : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Change the evaluation parameters
+     * @param InNearDistance - Viewer distance up to which observers are fully significant
+     * @param InFarDistance - Viewer distance from which observers are insignificant
+     * @param InOffScreenScale - Significance multiplier for observers outside every viewer's FOV
+     * @param InEvaluationInterval - Seconds between evaluations
+     */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Significance")
+    void ConfigureSignificance(float InNearDistance = 5000.0f, float InFarDistance = 50000.0f, float InOffScreenScale = 0.25f, float InEvaluationInterval = 0.25f);
+
+    /** Start rating an observer */
+    void RegisterObserver(ACPP_Actor__Viewshed *Observer);
+
+    /** Stop rating an observer */
+    void UnregisterObserver(ACPP_Actor__Viewshed *Observer);
+
+    /** Re-rate one observer at the next evaluation because its transform or relevance changed */
+    void NotifyObserverChanged(ACPP_Actor__Viewshed *Observer);
+
+    /** Rate every registered observer now instead of waiting for an event */
+    UFUNCTION(BlueprintCallable, Category = "ViewShed Significance")
+    void EvaluateNow();
+
+    /** Number of registered observers */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "ViewShed Significance")
+    int32 GetObserverCount() const { return Observers.Num(); }
+
+    //~ UTickableWorldSubsystem
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    /** One local player view */
+    struct FViewer
+    {
+        FVector Location;
+        FVector Forward;
+        float CosHalfFOV;
+    };
+
+    /** Collect the view point of every local player */
+    void GatherViewers(TArray<FViewer> &OutViewers) const;
+
+    /** Whether the views differ from the ones of the last full evaluation by more than the tolerances */
+    bool HaveViewersChanged(TConstArrayView<FViewer> Viewers) const;
+
+    /** Rate one observer against the given views and apply the result */
+    void ApplySignificance(ACPP_Actor__Viewshed &Observer, TConstArrayView<FViewer> Viewers) const;
+
+    /** Significance of one observer against the gathered views */
+    float Evaluate(const ACPP_Actor__Viewshed &Observer, TConstArrayView<FViewer> Viewers) const;
+
+    /** Registered observers */
+    TArray<TWeakObjectPtr<ACPP_Actor__Viewshed>> Observers;
+
+    /** Observers to re-rate at the next evaluation against the current views */
+    TSet<TWeakObjectPtr<ACPP_Actor__Viewshed>> ChangedObservers;
+
+    /** Views every observer was last rated against */
+    TArray<FViewer> RatedViewers;
+
+    /** Evaluation parameters (see ConfigureSignificance) */
+    float NearDistance = 5000.0f;
+    float FarDistance = 50000.0f;
+    float OffScreenScale = 0.25f;
+    float EvaluationInterval = 0.25f;
+
+    /** Seconds since the views were last sampled */
+    float TimeSinceEvaluation = 0.0f;
+};
@@ -49,6 +49,9 @@ public class P_ViewshedAnalysis : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Json",
+				"GeometryCore",
+				"GeometryAlgorithms",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);